@@ -0,0 +1,571 @@
+#include <Stick/Allocator.hpp>
+#include <Stick/Allocators/FallbackAllocator.hpp>
+#include <Stick/Allocators/SegregatedFreeListAllocator.hpp>
+#include <Stick/ConcurrentAllocator.hpp>
+#include <Stick/DynamicArray.hpp>
+#include <Stick/HashMap.hpp>
+#include <Stick/HighResolutionClock.hpp>
+#include <Stick/Path.hpp>
+#include <Stick/StringConversion.hpp>
+#include <Stick/Thread.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+using namespace stick;
+
+// Replays allocation traces against the allocator compositions in Stick and against glibc malloc.
+// A trace is a list of allocate/free operations on numbered slots. The built in traces are either
+// synthetic or recorded from a container workload, additional ones can be loaded from a text file
+// with one "a <slot> <size>" or "f <slot>" operation per line.
+//
+// Every run happens in a forked child process so that the RSS numbers of one allocator are not
+// polluted by memory that another one did not return to the OS.
+//
+// Usage: AllocatorBenchmark [--trace <file>] [--threads <count>] [--quick]
+
+static constexpr Size maxThreadCount = 16;
+
+struct Op
+{
+    // slot the operation refers to
+    UInt32 slot;
+    // zero frees the slot, anything else allocates that many bytes into it
+    UInt32 size;
+};
+
+struct Trace
+{
+    Trace() : slotCount(0)
+    {
+    }
+
+    String name;
+    DynamicArray<Op> ops;
+    UInt32 slotCount;
+};
+
+struct RunResult
+{
+    Float64 opsPerSecond;
+    UInt64 p99Nanoseconds;
+    UInt64 peakRSSBytes;
+    UInt64 peakLiveBytes;
+};
+
+struct XorShift
+{
+    XorShift(UInt64 _seed) : state(_seed)
+    {
+    }
+
+    UInt64 next()
+    {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        return state;
+    }
+
+    UInt64 state;
+};
+
+//
+// allocators
+//
+
+// exposes a Block allocator policy through the stick::Allocator interface
+template <class Policy>
+class PolicyAllocator : public Allocator
+{
+  public:
+    mem::Block allocate(Size _byteCount, Size _alignment) override
+    {
+        return m_alloc.allocate(_byteCount, _alignment);
+    }
+
+    void deallocate(const mem::Block & _block) override
+    {
+        m_alloc.deallocate(_block);
+    }
+
+  private:
+    Policy m_alloc;
+};
+
+// makes a single threaded allocator usable from multiple threads
+template <class A>
+class LockedAllocator : public Allocator
+{
+  public:
+    mem::Block allocate(Size _byteCount, Size _alignment) override
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_alloc.allocate(_byteCount, _alignment);
+    }
+
+    void deallocate(const mem::Block & _block) override
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_alloc.deallocate(_block);
+    }
+
+  private:
+    std::mutex m_mutex;
+    A m_alloc;
+};
+
+using PoolFallback =
+    mem::FallbackAllocator<mem::Bucketizer<detail::ExperimentalPoolAlloc, 1, 256, 16>,
+                           mem::Mallocator>;
+using FreeListSegregator =
+    mem::Segregator<mem::T<256>,
+                    mem::Bucketizer<detail::ExperimentalPoolAlloc, 1, 256, 16>,
+                    mem::T<8192>,
+                    mem::SegregatedFreeListAllocator<mem::Mallocator, 1 << 20>,
+                    mem::Mallocator>;
+
+struct Candidate
+{
+    const char * name;
+    bool bThreadSafe;
+    Allocator * (*create)();
+};
+
+template <class A>
+static Allocator * createAllocator()
+{
+    return new A;
+}
+
+static const Candidate candidates[] = {
+    { "glibc malloc", true, &createAllocator<DefaultAllocator> },
+    { "Experimental", false, &createAllocator<ExperimentalAllocator> },
+    { "Pool+Fallback", false, &createAllocator<PolicyAllocator<PoolFallback>> },
+    { "Pool+SegregatedFit", false, &createAllocator<PolicyAllocator<FreeListSegregator>> },
+    { "Concurrent", true, &createAllocator<ConcurrentAllocator> },
+    { "Experimental+Mutex", true, &createAllocator<LockedAllocator<ExperimentalAllocator>> }
+};
+
+//
+// traces
+//
+
+// random frees and allocations on a fixed number of live slots
+template <class SizeFunc>
+static Trace churnTrace(const char * _name, UInt32 _slotCount, Size _opCount, SizeFunc _sizeFunc)
+{
+    Trace ret;
+    ret.name = _name;
+    ret.slotCount = _slotCount;
+    ret.ops.reserve(_slotCount + _opCount * 2);
+    XorShift rnd(0x2545F4914F6CDD1DULL);
+    for (UInt32 i = 0; i < _slotCount; ++i)
+        ret.ops.append({ i, _sizeFunc(rnd) });
+    for (Size i = 0; i < _opCount; ++i)
+    {
+        UInt32 slot = static_cast<UInt32>(rnd.next() % _slotCount);
+        ret.ops.append({ slot, 0 });
+        ret.ops.append({ slot, _sizeFunc(rnd) });
+    }
+    for (UInt32 i = 0; i < _slotCount; ++i)
+        ret.ops.append({ i, 0 });
+    return ret;
+}
+
+// bursts of allocations that get freed in reverse order, i.e. per frame/request temporaries
+static Trace burstTrace(Size _burstCount)
+{
+    static constexpr UInt32 maxBurst = 512;
+    Trace ret;
+    ret.name = "lifo bursts";
+    ret.slotCount = maxBurst;
+    XorShift rnd(0x9E3779B97F4A7C15ULL);
+    for (Size i = 0; i < _burstCount; ++i)
+    {
+        UInt32 count = 1 + static_cast<UInt32>(rnd.next() % maxBurst);
+        for (UInt32 j = 0; j < count; ++j)
+            ret.ops.append({ j, static_cast<UInt32>(16 + rnd.next() % 496) });
+        for (UInt32 j = count; j > 0; --j)
+            ret.ops.append({ j - 1, 0 });
+    }
+    return ret;
+}
+
+// records the allocations of a real workload
+class RecordingAllocator : public Allocator
+{
+  public:
+    RecordingAllocator(Trace & _trace) : m_trace(_trace)
+    {
+    }
+
+    mem::Block allocate(Size _byteCount, Size _alignment) override
+    {
+        mem::Block ret = m_alloc.allocate(_byteCount, _alignment);
+        UInt32 slot;
+        if (m_freeSlots.count())
+        {
+            slot = m_freeSlots.last();
+            m_freeSlots.removeLast();
+        }
+        else
+            slot = m_trace.slotCount++;
+        m_slots.insert(ret.ptr, slot);
+        m_trace.ops.append({ slot, static_cast<UInt32>(_byteCount) });
+        return ret;
+    }
+
+    void deallocate(const mem::Block & _block) override
+    {
+        auto it = m_slots.find(_block.ptr);
+        m_trace.ops.append({ it->value, 0 });
+        m_freeSlots.append(it->value);
+        m_slots.remove(it);
+        m_alloc.deallocate(_block);
+    }
+
+  private:
+    Trace & m_trace;
+    DefaultAllocator m_alloc;
+    HashMap<void *, UInt32> m_slots;
+    DynamicArray<UInt32> m_freeSlots;
+};
+
+static Trace recordedTrace(Size _iterations)
+{
+    Trace ret;
+    ret.name = "recorded containers";
+    RecordingAllocator rec(ret);
+    for (Size i = 0; i < _iterations; ++i)
+    {
+        HashMap<String, DynamicArray<Int32>> map(16, rec);
+        for (Int32 j = 0; j < 64; ++j)
+        {
+            String key("item_", rec);
+            key.append(toString(j, rec));
+            DynamicArray<Int32> values(rec);
+            for (Int32 k = 0; k < j; ++k)
+                values.append(k);
+            map.insert(key, values);
+        }
+
+        String p = path::join("/usr/local/share", toString((UInt64)i, rec), rec);
+        StringArray segs = path::segments(p, rec);
+        for (const String & s : segs)
+            map.insert(s, DynamicArray<Int32>(rec));
+    }
+    return ret;
+}
+
+static bool loadTrace(const char * _path, Trace & _outTrace)
+{
+    FILE * f = fopen(_path, "r");
+    if (!f)
+        return false;
+
+    _outTrace.name = _path;
+    char op;
+    unsigned long slot, size;
+    while (fscanf(f, " %c %lu", &op, &slot) == 2)
+    {
+        size = 0;
+        if (op == 'a' && fscanf(f, "%lu", &size) != 1)
+            break;
+        _outTrace.ops.append({ static_cast<UInt32>(slot), static_cast<UInt32>(size) });
+        if (slot >= _outTrace.slotCount)
+            _outTrace.slotCount = static_cast<UInt32>(slot + 1);
+    }
+    fclose(f);
+    return true;
+}
+
+//
+// replaying
+//
+
+static UInt64 currentRSS()
+{
+    long pages = 0;
+    FILE * f = fopen("/proc/self/statm", "r");
+    if (f)
+    {
+        long size;
+        if (fscanf(f, "%ld %ld", &size, &pages) != 2)
+            pages = 0;
+        fclose(f);
+    }
+    return static_cast<UInt64>(pages) * sysconf(_SC_PAGESIZE);
+}
+
+static UInt64 peakRSS()
+{
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return static_cast<UInt64>(usage.ru_maxrss) * 1024;
+}
+
+struct ThreadState
+{
+    mem::Block * slots;
+    UInt64 * latencies;
+    Size latencyCount;
+    Size liveBytes;
+    Size peakLiveBytes;
+    Float64 seconds;
+};
+
+template <bool bMeasureLatency>
+static void replay(Allocator & _alloc, const Trace & _trace, ThreadState & _state)
+{
+    auto start = HighResolutionClock::now();
+    for (const Op & op : _trace.ops)
+    {
+        mem::Block & slot = _state.slots[op.slot];
+        auto opStart = bMeasureLatency ? HighResolutionClock::now() : start;
+        if (op.size)
+        {
+            // a trace might allocate into a slot that is still in use
+            if (slot)
+            {
+                _state.liveBytes -= slot.size;
+                _alloc.deallocate(slot);
+            }
+            slot = _alloc.allocate(op.size, 8);
+            _state.liveBytes += op.size;
+            if (_state.liveBytes > _state.peakLiveBytes)
+                _state.peakLiveBytes = _state.liveBytes;
+        }
+        else if (slot)
+        {
+            _state.liveBytes -= slot.size;
+            _alloc.deallocate(slot);
+            slot = mem::Block();
+        }
+
+        if (bMeasureLatency)
+            _state.latencies[_state.latencyCount++] =
+                static_cast<UInt64>((HighResolutionClock::now() - opStart).nanoseconds());
+
+        // touch every page like a real user would, so that it shows up in the RSS
+        if (op.size)
+        {
+            for (Size i = 0; i < slot.size; i += 4096)
+                reinterpret_cast<char *>(slot.ptr)[i] = 1;
+        }
+    }
+
+    // release whatever the trace left alive
+    for (UInt32 i = 0; i < _trace.slotCount; ++i)
+    {
+        if (_state.slots[i])
+        {
+            _alloc.deallocate(_state.slots[i]);
+            _state.slots[i] = mem::Block();
+        }
+    }
+    _state.liveBytes = 0;
+    _state.seconds = (HighResolutionClock::now() - start).seconds();
+}
+
+template <bool bMeasureLatency>
+static void replayOnThreads(Allocator & _alloc,
+                            const Trace & _trace,
+                            ThreadState * _states,
+                            Size _threadCount)
+{
+    if (_threadCount == 1)
+    {
+        replay<bMeasureLatency>(_alloc, _trace, _states[0]);
+        return;
+    }
+
+    std::atomic<Size> readyCount(0);
+    Thread threads[maxThreadCount];
+    for (Size i = 0; i < _threadCount; ++i)
+    {
+        threads[i].run([&, i]() {
+            readyCount++;
+            while (readyCount.load() < _threadCount)
+            {
+            }
+            replay<bMeasureLatency>(_alloc, _trace, _states[i]);
+        });
+    }
+    for (Size i = 0; i < _threadCount; ++i)
+        threads[i].join();
+}
+
+static RunResult run(const Candidate & _candidate, const Trace & _trace, Size _threadCount)
+{
+    // everything the replay needs besides the allocator is set up (and touched) up front so that
+    // it does not show up in the RSS
+    ThreadState states[maxThreadCount];
+    for (Size i = 0; i < _threadCount; ++i)
+    {
+        states[i].slots =
+            static_cast<mem::Block *>(calloc(_trace.slotCount, sizeof(mem::Block)));
+        states[i].latencies = static_cast<UInt64 *>(malloc(_trace.ops.count() * sizeof(UInt64)));
+        memset(states[i].latencies, 0, _trace.ops.count() * sizeof(UInt64));
+        states[i].latencyCount = 0;
+        states[i].liveBytes = 0;
+        states[i].peakLiveBytes = 0;
+    }
+
+    Allocator * alloc = _candidate.create();
+    UInt64 baseRSS = currentRSS();
+
+    RunResult ret;
+    ret.peakLiveBytes = 0;
+
+    replayOnThreads<false>(*alloc, _trace, states, _threadCount);
+    Float64 maxSeconds = 0;
+    for (Size i = 0; i < _threadCount; ++i)
+    {
+        maxSeconds = std::max(maxSeconds, states[i].seconds);
+        ret.peakLiveBytes += states[i].peakLiveBytes;
+    }
+    ret.opsPerSecond = maxSeconds > 0 ? _trace.ops.count() * _threadCount / maxSeconds : 0.0;
+
+    UInt64 peak = peakRSS();
+    ret.peakRSSBytes = peak > baseRSS ? peak - baseRSS : 0;
+
+    // second, warm pass to measure the latency of the individual operations
+    replayOnThreads<true>(*alloc, _trace, states, _threadCount);
+    Size latencyCount = 0;
+    for (Size i = 0; i < _threadCount; ++i)
+        latencyCount += states[i].latencyCount;
+    UInt64 * all = static_cast<UInt64 *>(malloc(latencyCount * sizeof(UInt64)));
+    Size offset = 0;
+    for (Size i = 0; i < _threadCount; ++i)
+    {
+        memcpy(all + offset, states[i].latencies, states[i].latencyCount * sizeof(UInt64));
+        offset += states[i].latencyCount;
+    }
+    Size p99 = latencyCount * 99 / 100;
+    std::nth_element(all, all + p99, all + latencyCount);
+    ret.p99Nanoseconds = latencyCount ? all[p99] : 0;
+    return ret;
+}
+
+// runs in a child process and reports back through a pipe
+static bool runIsolated(const Candidate & _candidate,
+                        const Trace & _trace,
+                        Size _threadCount,
+                        RunResult & _outResult)
+{
+    int fds[2];
+    if (pipe(fds) != 0)
+        return false;
+
+    fflush(stdout);
+    pid_t pid = fork();
+    if (pid < 0)
+        return false;
+
+    if (pid == 0)
+    {
+        close(fds[0]);
+        RunResult res = run(_candidate, _trace, _threadCount);
+        ssize_t written = write(fds[1], &res, sizeof(res));
+        _exit(written == sizeof(res) ? 0 : 1);
+    }
+
+    close(fds[1]);
+    ssize_t bytesRead = read(fds[0], &_outResult, sizeof(_outResult));
+    close(fds[0]);
+    int status = 0;
+    waitpid(pid, &status, 0);
+    return bytesRead == sizeof(_outResult) && WIFEXITED(status) && WEXITSTATUS(status) == 0;
+}
+
+static void benchmarkTrace(const Trace & _trace, Size _threadCount)
+{
+    printf("\n%s: %lu ops, %u slots, %lu thread(s)\n",
+           _trace.name.cString(),
+           (unsigned long)_trace.ops.count(),
+           _trace.slotCount,
+           (unsigned long)_threadCount);
+    printf("%-20s %12s %10s %12s %14s\n", "allocator", "Mops/s", "p99 ns", "RSS MB", "fragmentation");
+
+    for (const Candidate & c : candidates)
+    {
+        if (_threadCount > 1 && !c.bThreadSafe)
+            continue;
+
+        RunResult res;
+        if (!runIsolated(c, _trace, _threadCount, res))
+        {
+            printf("%-20s failed\n", c.name);
+            continue;
+        }
+
+        // share of the resident memory that is not used by live allocations
+        Float64 frag = res.peakRSSBytes > res.peakLiveBytes
+                           ? (1.0 - res.peakLiveBytes / (Float64)res.peakRSSBytes) * 100.0
+                           : 0.0;
+        printf("%-20s %12.2f %10lu %12.2f %13.2f%%\n",
+               c.name,
+               res.opsPerSecond / 1000000.0,
+               (unsigned long)res.p99Nanoseconds,
+               res.peakRSSBytes / (1024.0 * 1024.0),
+               frag);
+    }
+}
+
+int main(int _argc, const char * _args[])
+{
+    Size threadCount = 4;
+    Size scale = 1;
+    const char * tracePath = nullptr;
+    for (int i = 1; i < _argc; ++i)
+    {
+        if (strcmp(_args[i], "--trace") == 0 && i + 1 < _argc)
+            tracePath = _args[++i];
+        else if (strcmp(_args[i], "--threads") == 0 && i + 1 < _argc)
+            threadCount = std::min(maxThreadCount, (Size)std::max(1, atoi(_args[++i])));
+        else if (strcmp(_args[i], "--quick") == 0)
+            scale = 0;
+    }
+
+    DynamicArray<Trace> traces;
+    traces.append(churnTrace("small churn", 50000, scale ? 2000000 : 100000, [](XorShift & _rnd) {
+        return static_cast<UInt32>(8 + _rnd.next() % 121);
+    }));
+    traces.append(churnTrace("mixed sizes", 20000, scale ? 1000000 : 50000, [](XorShift & _rnd) {
+        // mostly small with a long tail of bigger allocations
+        UInt64 r = _rnd.next() % 100;
+        if (r < 70)
+            return static_cast<UInt32>(16 + _rnd.next() % 240);
+        else if (r < 95)
+            return static_cast<UInt32>(256 + _rnd.next() % 3840);
+        return static_cast<UInt32>(4096 + _rnd.next() % 61440);
+    }));
+    traces.append(burstTrace(scale ? 10000 : 500));
+    traces.append(recordedTrace(scale ? 2000 : 100));
+
+    if (tracePath)
+    {
+        Trace t;
+        if (loadTrace(tracePath, t))
+            traces.append(std::move(t));
+        else
+            printf("Could not load trace %s\n", tracePath);
+    }
+
+    for (const Trace & t : traces)
+    {
+        benchmarkTrace(t, 1);
+        if (threadCount > 1)
+            benchmarkTrace(t, threadCount);
+    }
+
+    return 0;
+}
@@ -0,0 +1,122 @@
+#include <Stick/Allocators/FreeListAllocator.hpp>
+#include <Stick/Allocators/Mallocator.hpp>
+#include <Stick/Allocators/SegregatedFreeListAllocator.hpp>
+#include <Stick/HighResolutionClock.hpp>
+
+using namespace stick;
+
+// Replays the same randomized mixed size workload against the first fit FreeListAllocator and the
+// SegregatedFreeListAllocator and reports time and fragmentation (the share of the chunk memory
+// that is not used by live allocations).
+
+static constexpr Size chunkSize = 1 << 16;
+static constexpr Size slotCount = 2048;
+static constexpr Size iterationCount = 200000;
+
+struct XorShift
+{
+    XorShift() : state(0x2545F4914F6CDD1DULL)
+    {
+    }
+
+    UInt64 next()
+    {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        return state;
+    }
+
+    Size randomSize()
+    {
+        UInt64 r = next() % 100;
+        if (r < 70)
+            return 16 + next() % 240;
+        else if (r < 95)
+            return 256 + next() % 1792;
+        return 2048 + next() % 6144;
+    }
+
+    UInt64 state;
+};
+
+struct Result
+{
+    Float64 milliseconds;
+    Size chunkCount;
+    Size liveBytes;
+    Size peakLiveBytes;
+    Size failedCount;
+};
+
+template <class Alloc>
+static Result runWorkload()
+{
+    Alloc alloc;
+    XorShift rnd;
+    mem::Block slots[slotCount];
+    Result ret = { 0, 0, 0, 0, 0 };
+
+    auto start = HighResolutionClock::now();
+    for (Size i = 0; i < slotCount; ++i)
+    {
+        slots[i] = alloc.allocate(rnd.randomSize(), 8);
+        ret.liveBytes += slots[i].size;
+    }
+
+    for (Size i = 0; i < iterationCount; ++i)
+    {
+        Size idx = rnd.next() % slotCount;
+        if (slots[idx])
+        {
+            ret.liveBytes -= slots[idx].size;
+            alloc.deallocate(slots[idx]);
+        }
+
+        slots[idx] = alloc.allocate(rnd.randomSize(), 8);
+        if (!slots[idx])
+            ret.failedCount++;
+        ret.liveBytes += slots[idx].size;
+        if (ret.liveBytes > ret.peakLiveBytes)
+            ret.peakLiveBytes = ret.liveBytes;
+    }
+    ret.milliseconds = (HighResolutionClock::now() - start).milliseconds();
+    ret.chunkCount = alloc.chunkCount();
+
+    for (Size i = 0; i < slotCount; ++i)
+    {
+        if (slots[i])
+            alloc.deallocate(slots[i]);
+    }
+
+    return ret;
+}
+
+static void printResult(const char * _name, const Result & _res)
+{
+    Float64 footprint = static_cast<Float64>(_res.chunkCount * chunkSize);
+    printf("%-24s %10.2f ms %10.0f ops/s %8lu chunks %8.2f%% fragmentation (%.2f%% at peak) %lu "
+           "failed\n",
+           _name,
+           _res.milliseconds,
+           iterationCount / (_res.milliseconds / 1000.0),
+           (unsigned long)_res.chunkCount,
+           (1.0 - _res.liveBytes / footprint) * 100.0,
+           (1.0 - _res.peakLiveBytes / footprint) * 100.0,
+           (unsigned long)_res.failedCount);
+}
+
+int main(int _argc, const char * _args[])
+{
+    printf("%lu slots, %lu iterations, %lu byte chunks\n",
+           (unsigned long)slotCount,
+           (unsigned long)iterationCount,
+           (unsigned long)chunkSize);
+
+    printResult("FirstFit",
+                runWorkload<mem::FreeListAllocator<mem::Mallocator, chunkSize>>());
+    printResult("SegregatedFit",
+                runWorkload<mem::SegregatedFreeListAllocator<mem::Mallocator, chunkSize>>());
+
+    return 0;
+}
@@ -0,0 +1,231 @@
+#include <Stick/HighResolutionClock.hpp>
+#include <Stick/String.hpp>
+#include <Stick/StringBuilder.hpp>
+
+#include <stdlib.h>
+#include <string.h>
+
+using namespace stick;
+
+// Compares the append and concat throughput of String against a copy of the terminator based
+// implementation it used to have, which copied with strcpy/strlen and zeroed its whole buffer on
+// clear, and formatting into a String against a StringBuilder. Every workload builds the same text
+// with both and reports MB of output per second.
+
+static constexpr Size repeatCount = 200;
+static constexpr Size pieceCount = 20000;
+
+// minimal version of the old String code paths, only what the workloads below use
+class TerminatedString
+{
+  public:
+    TerminatedString() : m_ptr(static_cast<char *>(calloc(1, 1))), m_length(0), m_capacity(0)
+    {
+    }
+
+    TerminatedString(const TerminatedString & _other) : TerminatedString()
+    {
+        append(_other);
+    }
+
+    ~TerminatedString()
+    {
+        free(m_ptr);
+    }
+
+    void append(const TerminatedString & _str)
+    {
+        if (!_str.m_length)
+            return;
+        Size off = m_length;
+        preAppend(m_length + _str.m_length);
+        strcpy(m_ptr + off, _str.m_ptr);
+    }
+
+    void append(const char * _cStr)
+    {
+        Size len = strlen(_cStr);
+        if (!len)
+            return;
+        Size off = m_length;
+        preAppend(m_length + len);
+        strcpy(m_ptr + off, _cStr);
+    }
+
+    static TerminatedString concat(const TerminatedString & _a,
+                                   const char * _b,
+                                   const TerminatedString & _c)
+    {
+        TerminatedString ret;
+        ret.reserve(strlen(_a.m_ptr) + strlen(_b) + strlen(_c.m_ptr));
+        strcpy(ret.m_ptr, _a.m_ptr);
+        strcpy(ret.m_ptr + _a.m_length, _b);
+        strcpy(ret.m_ptr + _a.m_length + strlen(_b), _c.m_ptr);
+        ret.m_length = _a.m_length + strlen(_b) + _c.m_length;
+        return ret;
+    }
+
+    void clear()
+    {
+        memset(m_ptr, 0, m_capacity);
+        m_length = 0;
+    }
+
+    Size length() const
+    {
+        return m_length;
+    }
+
+  private:
+    void reserve(Size _count)
+    {
+        if (_count <= m_capacity)
+            return;
+        m_ptr = static_cast<char *>(realloc(m_ptr, _count + 1));
+        memset(m_ptr + m_length, 0, _count + 1 - m_length);
+        m_capacity = _count;
+    }
+
+    void preAppend(Size _newLen)
+    {
+        if (m_capacity < _newLen)
+            reserve(_newLen * 2);
+        m_length = _newLen;
+    }
+
+    char * m_ptr;
+    Size m_length;
+    Size m_capacity;
+};
+
+static const char * pieces[] = { "GET",
+                                 " /index.html",
+                                 " HTTP/1.1\r\n",
+                                 "Host: www.example.org\r\n",
+                                 "User-Agent: Mozilla/5.0 (X11; Linux x86_64) Gecko/20100101\r\n",
+                                 "Accept: text/html,application/xhtml+xml,application/xml\r\n",
+                                 "\r\n" };
+static constexpr Size distinctPieceCount = sizeof(pieces) / sizeof(pieces[0]);
+
+// appends c strings to one growing string, clearing it between repeats
+template <class S>
+static Size appendCStrings()
+{
+    Size bytes = 0;
+    S str;
+    for (Size r = 0; r < repeatCount; ++r)
+    {
+        str.clear();
+        for (Size i = 0; i < pieceCount; ++i)
+            str.append(pieces[i % distinctPieceCount]);
+        bytes += str.length();
+    }
+    return bytes;
+}
+
+// appends strings whose length is already known
+template <class S>
+static Size appendStrings()
+{
+    S parts[distinctPieceCount];
+    for (Size i = 0; i < distinctPieceCount; ++i)
+        parts[i].append(pieces[i]);
+
+    Size bytes = 0;
+    S str;
+    for (Size r = 0; r < repeatCount; ++r)
+    {
+        str.clear();
+        for (Size i = 0; i < pieceCount; ++i)
+            str.append(parts[i % distinctPieceCount]);
+        bytes += str.length();
+    }
+    return bytes;
+}
+
+static String concat(const String & _a, const char * _b, const String & _c)
+{
+    return String::concat(_a, _b, _c);
+}
+
+static TerminatedString concat(const TerminatedString & _a,
+                               const char * _b,
+                               const TerminatedString & _c)
+{
+    return TerminatedString::concat(_a, _b, _c);
+}
+
+// concatenates a long string with short ones and copies the result
+template <class S>
+static Size concatAndCopy()
+{
+    S head;
+    for (Size i = 0; i < 64; ++i)
+        head.append(pieces[i % distinctPieceCount]);
+    S tail;
+    tail.append(pieces[4]);
+
+    Size bytes = 0;
+    for (Size r = 0; r < repeatCount * 500; ++r)
+    {
+        S joined = concat(head, pieces[r % distinctPieceCount], tail);
+        S copy(joined);
+        bytes += copy.length();
+    }
+    return bytes;
+}
+
+// formats a report line by line, once into a String and once with a StringBuilder
+static Size formatString()
+{
+    Size bytes = 0;
+    for (Size r = 0; r < repeatCount; ++r)
+    {
+        String str;
+        for (Size i = 0; i < pieceCount; ++i)
+            str.appendFormatted("%lu: %s %.3f\n", (unsigned long)i, pieces[i % distinctPieceCount], i * 0.5);
+        bytes += str.length();
+    }
+    return bytes;
+}
+
+static Size formatStringBuilder()
+{
+    Size bytes = 0;
+    for (Size r = 0; r < repeatCount; ++r)
+    {
+        StringBuilder sb;
+        for (Size i = 0; i < pieceCount; ++i)
+            sb.appendFormatted("%lu: %s %.3f\n", (unsigned long)i, pieces[i % distinctPieceCount], i * 0.5);
+        bytes += sb.toString().length();
+    }
+    return bytes;
+}
+
+template <class F>
+static void measure(const char * _name, F _fn)
+{
+    auto start = HighResolutionClock::now();
+    Size bytes = _fn();
+    Float64 seconds = (HighResolutionClock::now() - start).seconds();
+    printf("%-32s %10.2f ms %10.1f MB/s\n",
+           _name,
+           seconds * 1000.0,
+           bytes / seconds / (1024.0 * 1024.0));
+}
+
+int main(int _argc, const char * _args[])
+{
+    printf("%lu repeats of %lu pieces\n", (unsigned long)repeatCount, (unsigned long)pieceCount);
+
+    measure("append c string (strcpy)", appendCStrings<TerminatedString>);
+    measure("append c string (String)", appendCStrings<String>);
+    measure("append String (strcpy)", appendStrings<TerminatedString>);
+    measure("append String (String)", appendStrings<String>);
+    measure("concat and copy (strcpy)", concatAndCopy<TerminatedString>);
+    measure("concat and copy (String)", concatAndCopy<String>);
+    measure("format report (String)", formatString);
+    measure("format report (StringBuilder)", formatStringBuilder);
+
+    return 0;
+}
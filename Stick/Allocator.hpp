@@ -1,12 +1,15 @@
 #ifndef STICK_ALLOCATOR_HPP
 #define STICK_ALLOCATOR_HPP
 
+#include <Stick/Allocators/ArenaAllocator.hpp>
 #include <Stick/Allocators/Mallocator.hpp>
 #include <Stick/Allocators/Segregator.hpp>
+#include <Stick/Allocators/StatsAllocator.hpp>
 #include <Stick/Allocators/PoolAllocator.hpp>
 #include <Stick/Allocators/Bucketizer.hpp>
 #include <Stick/Utility.hpp>
 #include <algorithm>
+#include <cstring>
 #include <stdlib.h>
 
 namespace stick
@@ -20,6 +23,44 @@ class STICK_API Allocator
 
     virtual void deallocate(const mem::Block & _block) = 0;
 
+    // Allocates memory that is filled with zeros.
+    virtual mem::Block allocateZeroed(Size _byteCount, Size _alignment)
+    {
+        mem::Block ret = allocate(_byteCount, _alignment);
+        if (ret)
+            std::memset(ret.ptr, 0, ret.size);
+        return ret;
+    }
+
+    // Tries to grow _block by _delta bytes without moving it. Returns false and leaves _block
+    // untouched if the allocator can't do that.
+    virtual bool expand(mem::Block & _block, Size _delta)
+    {
+        STICK_UNUSED(_block);
+        STICK_UNUSED(_delta);
+        return false;
+    }
+
+    // Resizes _block to _byteCount bytes, potentially moving it (like realloc). The contents are
+    // copied bitwise, so this must only be used for trivially relocatable data. Returns false and
+    // leaves _block untouched if the memory could not be allocated.
+    virtual bool reallocate(mem::Block & _block, Size _byteCount, Size _alignment)
+    {
+        if (_byteCount > _block.size && expand(_block, _byteCount - _block.size))
+            return true;
+
+        mem::Block blk = allocate(_byteCount, _alignment);
+        if (!blk)
+            return false;
+        if (_block)
+        {
+            std::memcpy(blk.ptr, _block.ptr, std::min(_block.size, _byteCount));
+            deallocate(_block);
+        }
+        _block = blk;
+        return true;
+    }
+
     //@TODO: replace modulo with faster ways to align
     // on the other hand its static so maybe not worth it :)
     template <class T, class... Args>
@@ -75,6 +116,16 @@ class STICK_API DefaultAllocator : public Allocator
         m_alloc.deallocate(_block);
     }
 
+    inline mem::Block allocateZeroed(Size _byteCount, Size _alignment) override
+    {
+        return m_alloc.allocateZeroed(_byteCount, _alignment);
+    }
+
+    inline bool reallocate(mem::Block & _block, Size _byteCount, Size _alignment) override
+    {
+        return m_alloc.reallocate(_block, _byteCount, _alignment);
+    }
+
   private:
     mem::Mallocator m_alloc;
 };
@@ -88,6 +139,29 @@ inline STICK_API Allocator & defaultAllocator()
     return *m_def;
 }
 
+namespace detail
+{
+using ExperimentalPoolAlloc =
+    mem::PoolAllocator<mem::Mallocator, mem::DynamicSizeFlag, mem::DynamicSizeFlag, 1024>;
+using ExperimentalSmallAlloc = mem::PoolAllocator<mem::Mallocator, 0, 8, 1024>;
+using ExperimentalSegregator =
+    mem::Segregator<mem::T<8>,
+                    ExperimentalSmallAlloc,
+                    mem::T<128>,
+                    mem::Bucketizer<ExperimentalPoolAlloc, 1, 128, 16>,
+                    mem::T<256>,
+                    mem::Bucketizer<ExperimentalPoolAlloc, 129, 256, 32>,
+                    mem::T<512>,
+                    mem::Bucketizer<ExperimentalPoolAlloc, 257, 512, 64>,
+                    mem::T<1024>,
+                    mem::Bucketizer<ExperimentalPoolAlloc, 513, 1024, 128>,
+                    mem::T<2048>,
+                    mem::Bucketizer<ExperimentalPoolAlloc, 1025, 2048, 256>,
+                    mem::T<4096>,
+                    mem::Bucketizer<ExperimentalPoolAlloc, 2049, 4096, 512>,
+                    mem::Mallocator>;
+} // namespace detail
+
 class STICK_API ExperimentalAllocator : public Allocator
 {
   public:
@@ -104,31 +178,18 @@ class STICK_API ExperimentalAllocator : public Allocator
         return m_alloc.allocate(_byteCount, _alignment);
     }
 
+    inline mem::Block allocateZeroed(Size _byteCount, Size _alignment) override
+    {
+        return m_alloc.allocateZeroed(_byteCount, _alignment);
+    }
+
     inline void deallocate(const mem::Block & _block) override
     {
         m_alloc.deallocate(_block);
     }
 
   private:
-    using PoolAlloc =
-        mem::PoolAllocator<mem::Mallocator, mem::DynamicSizeFlag, mem::DynamicSizeFlag, 1024>;
-    using SmallAlloc = mem::PoolAllocator<mem::Mallocator, 0, 8, 1024>;
-    using SegregatorAlloc = mem::Segregator<mem::T<8>,
-                                            SmallAlloc,
-                                            mem::T<128>,
-                                            mem::Bucketizer<PoolAlloc, 1, 128, 16>,
-                                            mem::T<256>,
-                                            mem::Bucketizer<PoolAlloc, 129, 256, 32>,
-                                            mem::T<512>,
-                                            mem::Bucketizer<PoolAlloc, 257, 512, 64>,
-                                            mem::T<1024>,
-                                            mem::Bucketizer<PoolAlloc, 513, 1024, 128>,
-                                            mem::T<2048>,
-                                            mem::Bucketizer<PoolAlloc, 1025, 2048, 256>,
-                                            mem::T<4096>,
-                                            mem::Bucketizer<PoolAlloc, 2049, 4096, 512>,
-                                            mem::Mallocator>;
-    SegregatorAlloc m_alloc;
+    detail::ExperimentalSegregator m_alloc;
 };
 
 inline STICK_API Allocator & experimentalAllocator()
@@ -138,6 +199,161 @@ inline STICK_API Allocator & experimentalAllocator()
     return *m_def;
 }
 
+// Forwards to another Allocator and records AllocationStats for everything going through it, i.e.
+// to find out which containers are driving the allocation traffic.
+class STICK_API TrackingAllocator : public Allocator
+{
+  public:
+    TrackingAllocator(Allocator & _parent = defaultAllocator()) : m_parent(&_parent)
+    {
+    }
+
+    ~TrackingAllocator()
+    {
+    }
+
+    // the recording functions are not inlined, so the sampled return address is their call site
+    STICK_NOINLINE mem::Block allocate(Size _byteCount, Size _alignment) override
+    {
+        mem::Block ret = m_parent->allocate(_byteCount, _alignment);
+        m_stats.recordAllocation(ret, _byteCount, __builtin_return_address(0));
+        return ret;
+    }
+
+    STICK_NOINLINE mem::Block allocateZeroed(Size _byteCount, Size _alignment) override
+    {
+        mem::Block ret = m_parent->allocateZeroed(_byteCount, _alignment);
+        m_stats.recordAllocation(ret, _byteCount, __builtin_return_address(0));
+        return ret;
+    }
+
+    inline void deallocate(const mem::Block & _block) override
+    {
+        m_stats.recordDeallocation(_block);
+        m_parent->deallocate(_block);
+    }
+
+    // a resize is recorded as the deallocation of the old and the allocation of the new block
+    STICK_NOINLINE bool expand(mem::Block & _block, Size _delta) override
+    {
+        mem::Block old = _block;
+        if (!m_parent->expand(_block, _delta))
+            return false;
+        m_stats.recordDeallocation(old);
+        m_stats.recordAllocation(_block, _block.size, __builtin_return_address(0));
+        return true;
+    }
+
+    STICK_NOINLINE bool reallocate(mem::Block & _block, Size _byteCount, Size _alignment) override
+    {
+        mem::Block old = _block;
+        if (!m_parent->reallocate(_block, _byteCount, _alignment))
+            return false;
+        if (old)
+            m_stats.recordDeallocation(old);
+        m_stats.recordAllocation(_block, _byteCount, __builtin_return_address(0));
+        return true;
+    }
+
+    inline mem::AllocationStats::Snapshot snapshot() const
+    {
+        return m_stats.snapshot();
+    }
+
+    inline mem::AllocationStats & stats()
+    {
+        return m_stats;
+    }
+
+    inline Allocator & parent() const
+    {
+        return *m_parent;
+    }
+
+  private:
+    Allocator * m_parent;
+    mem::AllocationStats m_stats;
+};
+
+// Allocator for short lived temporaries (i.e. everything that is allocated while handling one
+// request or frame). Individual deallocations are no-ops (except for the most recent allocation),
+// all memory is released at once by rewinding to a Marker or when a Scope ends.
+template <class Alloc, Size ChunkSize>
+class STICK_API ArenaT : public Allocator
+{
+  public:
+    using Marker = typename mem::ArenaAllocator<Alloc, ChunkSize>::Marker;
+
+    // Rewinds the arena to where it was when the scope was created.
+    class Scope
+    {
+      public:
+        inline Scope(ArenaT & _arena) : m_arena(_arena), m_marker(_arena.mark())
+        {
+        }
+
+        Scope(const Scope &) = delete;
+        Scope & operator=(const Scope &) = delete;
+
+        inline ~Scope()
+        {
+            m_arena.rewind(m_marker);
+        }
+
+      private:
+        ArenaT & m_arena;
+        Marker m_marker;
+    };
+
+    ArenaT()
+    {
+    }
+
+    ~ArenaT()
+    {
+    }
+
+    inline mem::Block allocate(Size _byteCount, Size _alignment) override
+    {
+        return m_alloc.allocate(_byteCount, _alignment);
+    }
+
+    inline void deallocate(const mem::Block & _block) override
+    {
+        m_alloc.deallocate(_block);
+    }
+
+    inline bool expand(mem::Block & _block, Size _delta) override
+    {
+        return m_alloc.expand(_block, _delta);
+    }
+
+    inline Marker mark() const
+    {
+        return m_alloc.mark();
+    }
+
+    inline void rewind(const Marker & _marker)
+    {
+        m_alloc.rewind(_marker);
+    }
+
+    inline void reset()
+    {
+        m_alloc.deallocateAll();
+    }
+
+    inline Size chunkCount() const
+    {
+        return m_alloc.chunkCount();
+    }
+
+  private:
+    mem::ArenaAllocator<Alloc, ChunkSize> m_alloc;
+};
+
+using Arena = ArenaT<mem::Mallocator, 4096>;
+
 } // namespace stick
 
 #endif // STICK_ALLOCATOR_HPP
@@ -1,7 +1,9 @@
 #ifndef STICK_ALLOCATORS_ALLOCATORUTILITIES_HPP
 #define STICK_ALLOCATORS_ALLOCATORUTILITIES_HPP
 
-#include <Stick/Platform.hpp>
+#include <Stick/Allocators/Block.hpp>
+#include <cstring>
+#include <type_traits>
 #include <utility> //for std::declval
 
 namespace stick
@@ -41,6 +43,144 @@ inline Size alignmentAdjustmentWithHeader(const void * _ptr, Size _alignment, Si
     return adjustment;
 }
 
+// index of the most significant set bit, _s must not be zero
+inline Size log2Floor(Size _s)
+{
+    STICK_ASSERT(_s);
+    return sizeof(Size) * 8 - 1 - __builtin_clzl(_s);
+}
+
+// index of the least significant set bit, _s must not be zero
+inline Size countTrailingZeros(Size _s)
+{
+    STICK_ASSERT(_s);
+    return __builtin_ctzl(_s);
+}
+
+// true if A can grow a Block in place, i.e. A has bool expand(Block & _blk, Size _delta)
+template <class A, class B = void>
+struct HasExpand : std::false_type
+{
+};
+
+template <class A>
+struct HasExpand<A, decltype(void(std::declval<A &>().expand(std::declval<Block &>(), Size())))>
+    : std::true_type
+{
+};
+
+// true if A has its own bool reallocate(Block & _blk, Size _byteCount, Size _alignment)
+template <class A, class B = void>
+struct HasReallocate : std::false_type
+{
+};
+
+template <class A>
+struct HasReallocate<A,
+                     decltype(void(std::declval<A &>().reallocate(
+                         std::declval<Block &>(), Size(), Size())))> : std::true_type
+{
+};
+
+// true if A has Block allocateZeroed(Size _byteCount, Size _alignment)
+template <class A, class B = void>
+struct HasAllocateZeroed : std::false_type
+{
+};
+
+template <class A>
+struct HasAllocateZeroed<A, decltype(void(std::declval<A &>().allocateZeroed(Size(), Size())))>
+    : std::true_type
+{
+};
+
+namespace detail
+{
+template <class A>
+inline Block allocateZeroed(A & _alloc, Size _byteCount, Size _alignment, std::true_type)
+{
+    return _alloc.allocateZeroed(_byteCount, _alignment);
+}
+
+template <class A>
+inline Block allocateZeroed(A & _alloc, Size _byteCount, Size _alignment, std::false_type)
+{
+    Block ret = _alloc.allocate(_byteCount, _alignment);
+    if (ret)
+        std::memset(ret.ptr, 0, ret.size);
+    return ret;
+}
+
+template <class A>
+inline bool expand(A & _alloc, Block & _blk, Size _delta, std::true_type)
+{
+    return _alloc.expand(_blk, _delta);
+}
+
+template <class A>
+inline bool expand(A &, Block &, Size, std::false_type)
+{
+    return false;
+}
+
+template <class A>
+inline bool reallocate(A & _alloc, Block & _blk, Size _byteCount, Size _alignment, std::true_type)
+{
+    return _alloc.reallocate(_blk, _byteCount, _alignment);
+}
+
+template <class A>
+inline bool reallocate(A & _alloc, Block & _blk, Size _byteCount, Size _alignment, std::false_type);
+} // namespace detail
+
+// Allocates memory that is filled with zeros. Allocators that know that their memory is zero
+// already (i.e. calloc or fresh pages) implement allocateZeroed, all others get memset.
+template <class A>
+inline Block allocateZeroed(A & _alloc, Size _byteCount, Size _alignment)
+{
+    return detail::allocateZeroed(_alloc, _byteCount, _alignment, HasAllocateZeroed<A>());
+}
+
+// Tries to grow _blk by _delta bytes without moving it. Returns false and leaves _blk untouched if
+// the allocator does not support that or there is no room.
+template <class A>
+inline bool expand(A & _alloc, Block & _blk, Size _delta)
+{
+    if (!_delta)
+        return true;
+    return detail::expand(_alloc, _blk, _delta, HasExpand<A>());
+}
+
+// Resizes _blk to _byteCount bytes, moving the memory if needed (i.e. like realloc). Since the
+// contents might get copied bitwise, this is only safe for trivially relocatable data.
+// Returns false and leaves _blk untouched if no memory could be allocated.
+template <class A>
+inline bool reallocate(A & _alloc, Block & _blk, Size _byteCount, Size _alignment)
+{
+    return detail::reallocate(_alloc, _blk, _byteCount, _alignment, HasReallocate<A>());
+}
+
+namespace detail
+{
+template <class A>
+inline bool reallocate(A & _alloc, Block & _blk, Size _byteCount, Size _alignment, std::false_type)
+{
+    if (_byteCount > _blk.size && mem::expand(_alloc, _blk, _byteCount - _blk.size))
+        return true;
+
+    Block blk = _alloc.allocate(_byteCount, _alignment);
+    if (!blk)
+        return false;
+    if (_blk)
+    {
+        std::memcpy(blk.ptr, _blk.ptr, _blk.size < _byteCount ? _blk.size : _byteCount);
+        _alloc.deallocate(_blk);
+    }
+    _blk = blk;
+    return true;
+}
+} // namespace detail
+
 // template <class A, class B = void>
 // struct HasOwns : std::false_type
 // {
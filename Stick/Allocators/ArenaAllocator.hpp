@@ -0,0 +1,182 @@
+#ifndef STICK_ALLOCATORS_ARENAALLOCATOR_HPP
+#define STICK_ALLOCATORS_ARENAALLOCATOR_HPP
+
+#include <Stick/Allocators/AllocatorUtilities.hpp>
+#include <Stick/Allocators/MemoryChunk.hpp>
+#include <new>
+
+namespace stick
+{
+namespace mem
+{
+// Growable version of LinearAllocator. Memory is bumped out of a list of chunks of (at least) S
+// bytes, a new chunk is appended whenever the current one is exhausted. Allocations that don't fit
+// into S bytes get a chunk of their own.
+// Besides deallocateAll, the allocator can be rewound to any Marker obtained from mark(), which
+// releases everything that was allocated after it at once. Chunks are kept around after a rewind
+// and reused by subsequent allocations until the allocator is destroyed.
+template <class Alloc, Size S>
+class STICK_API ArenaAllocator
+{
+  public:
+    static constexpr Size alignment = Alloc::alignment;
+
+    using ParentAllocator = Alloc;
+
+    struct Marker
+    {
+        MemoryChunk * chunk;
+        void * position;
+    };
+
+    inline ArenaAllocator() : m_firstChunk(nullptr), m_currentChunk(nullptr), m_position(nullptr)
+    {
+    }
+
+    ArenaAllocator(const ArenaAllocator &) = delete;
+    ArenaAllocator & operator=(const ArenaAllocator &) = delete;
+
+    inline ~ArenaAllocator()
+    {
+        MemoryChunk * pb = m_firstChunk;
+        while (pb)
+        {
+            MemoryChunk * tmp = pb->next;
+            m_alloc.deallocate({ pb, pb->memory.size + headerAdjustment });
+            pb = tmp;
+        }
+    }
+
+    inline Block allocate(Size _byteCount, Size _alignment)
+    {
+        STICK_ASSERT(_byteCount > 0);
+
+        if (m_currentChunk)
+        {
+            void * ret = bump(m_currentChunk, m_position, _byteCount, _alignment);
+            if (ret)
+                return { ret, _byteCount };
+        }
+
+        // move on to the next (empty) chunk, or insert a new one if it is too small
+        MemoryChunk * next = m_currentChunk ? m_currentChunk->next : m_firstChunk;
+        void * ret = next ? bump(next, next->memory.ptr, _byteCount, _alignment) : nullptr;
+        if (!ret)
+        {
+            next = allocateChunk(_byteCount + _alignment, next);
+            if (!next)
+                return { nullptr, 0 };
+            ret = bump(next, next->memory.ptr, _byteCount, _alignment);
+            STICK_ASSERT(ret);
+        }
+        m_currentChunk = next;
+        return { ret, _byteCount };
+    }
+
+    inline bool owns(const Block & _blk) const
+    {
+        const MemoryChunk * pb = m_firstChunk;
+        while (pb)
+        {
+            if (pb->owns(_blk))
+                return true;
+            pb = pb->next;
+        }
+        return false;
+    }
+
+    inline void deallocate(const Block & _blk)
+    {
+        // just like LinearAllocator, only the last allocation can be rolled back
+        void * tmp = reinterpret_cast<void *>(reinterpret_cast<UPtr>(m_position) - _blk.size);
+        if (tmp == _blk.ptr)
+            m_position = tmp;
+    }
+
+    // only the last allocation can grow, as long as its chunk has room left
+    inline bool expand(Block & _blk, Size _delta)
+    {
+        if (!m_currentChunk || _blk.end() != reinterpret_cast<UPtr>(m_position) ||
+            m_currentChunk->memory.end() - reinterpret_cast<UPtr>(m_position) < _delta)
+            return false;
+
+        m_position = reinterpret_cast<void *>(reinterpret_cast<UPtr>(m_position) + _delta);
+        _blk.size += _delta;
+        return true;
+    }
+
+    inline void deallocateAll()
+    {
+        m_currentChunk = nullptr;
+        m_position = nullptr;
+    }
+
+    inline Marker mark() const
+    {
+        return { m_currentChunk, m_position };
+    }
+
+    inline void rewind(const Marker & _marker)
+    {
+        STICK_ASSERT(!_marker.chunk || _marker.chunk->owns({ _marker.position, 0 }));
+        m_currentChunk = _marker.chunk;
+        m_position = _marker.position;
+    }
+
+    inline Size chunkCount() const
+    {
+        Size ret = 0;
+        const MemoryChunk * pb = m_firstChunk;
+        while (pb)
+        {
+            pb = pb->next;
+            ret++;
+        }
+        return ret;
+    }
+
+  private:
+    static constexpr Size headerSize = sizeof(MemoryChunk);
+    static constexpr Size headerAdjustment =
+        headerSize % alignment == 0 ? headerSize : headerSize + alignment - headerSize % alignment;
+
+    // bumps _position in _chunk and returns the aligned address or nullptr if it does not fit
+    inline void * bump(MemoryChunk * _chunk, void * _position, Size _byteCount, Size _alignment)
+    {
+        Size adjustment = alignmentAdjustment(_position, _alignment);
+        Size used = reinterpret_cast<UPtr>(_position) - reinterpret_cast<UPtr>(_chunk->memory.ptr);
+        if (_chunk->memory.size - used < adjustment + _byteCount)
+            return nullptr;
+
+        UPtr ret = reinterpret_cast<UPtr>(_position) + adjustment;
+        m_position = reinterpret_cast<void *>(ret + _byteCount);
+        return reinterpret_cast<void *>(ret);
+    }
+
+    // allocates a chunk of at least S bytes and links it in front of _next
+    inline MemoryChunk * allocateChunk(Size _minSize, MemoryChunk * _next)
+    {
+        Size size = _minSize > S ? _minSize : S;
+        Block mem = m_alloc.allocate(size + headerAdjustment, alignment);
+        if (!mem)
+            return nullptr;
+
+        MemoryChunk * chunk = new (mem.ptr)
+            MemoryChunk({ (void *)((UPtr)mem.ptr + headerAdjustment), mem.size - headerAdjustment });
+        chunk->next = _next;
+        if (m_currentChunk)
+            m_currentChunk->next = chunk;
+        else
+            m_firstChunk = chunk;
+        return chunk;
+    }
+
+    ParentAllocator m_alloc;
+    MemoryChunk * m_firstChunk;
+    MemoryChunk * m_currentChunk;
+    void * m_position;
+};
+} // namespace mem
+} // namespace stick
+
+#endif // STICK_ALLOCATORS_ARENAALLOCATOR_HPP
@@ -1,7 +1,7 @@
 #ifndef STICK_ALLOCATORS_BUCKETIZER_HPP
 #define STICK_ALLOCATORS_BUCKETIZER_HPP
 
-#include <Stick/Allocators/Block.hpp>
+#include <Stick/Allocators/AllocatorUtilities.hpp>
 
 namespace stick
 {
@@ -39,6 +39,16 @@ class STICK_API Bucketizer
         return { nullptr, 0 };
     }
 
+    inline Block allocateZeroed(Size _byteCount, Size _alignment)
+    {
+        Alloc * a = findAllocator(_byteCount);
+        if (a)
+        {
+            return mem::allocateZeroed(*a, _byteCount, _alignment);
+        }
+        return { nullptr, 0 };
+    }
+
     inline void deallocate(const Block & _blk)
     {
         STICK_ASSERT(owns(_blk));
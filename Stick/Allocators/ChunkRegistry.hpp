@@ -0,0 +1,115 @@
+#ifndef STICK_ALLOCATORS_CHUNKREGISTRY_HPP
+#define STICK_ALLOCATORS_CHUNKREGISTRY_HPP
+
+#include <Stick/Allocators/MemoryChunk.hpp>
+#include <cstring>
+
+namespace stick
+{
+namespace mem
+{
+// Address sorted index of the MemoryChunks of a chunked allocator. Finding the chunk that owns a
+// Block is a binary search rather than a walk over the whole chunk list.
+// The registry does not keep its own allocator, the storage for the index is allocated from
+// (and has to be released to) the parent allocator of the owning allocator.
+class STICK_API ChunkRegistry
+{
+  public:
+    inline ChunkRegistry() : m_count(0)
+    {
+    }
+
+    template <class Alloc>
+    inline void add(const MemoryChunk * _chunk, Alloc & _alloc)
+    {
+        STICK_ASSERT(_chunk && _chunk->memory);
+
+        if (m_count == capacity())
+        {
+            Size cap = m_count ? m_count * 2 : 16;
+            Block mem = _alloc.allocate(cap * sizeof(const MemoryChunk *), alignof(void *));
+            STICK_ASSERT(mem);
+            if (m_count)
+                std::memcpy(mem.ptr, m_storage.ptr, m_count * sizeof(const MemoryChunk *));
+            if (m_storage)
+                _alloc.deallocate(m_storage);
+            m_storage = mem;
+        }
+
+        const MemoryChunk ** chunks = data();
+        Size idx = upperBound(_chunk->memory.ptr);
+        std::memmove(chunks + idx + 1, chunks + idx, (m_count - idx) * sizeof(const MemoryChunk *));
+        chunks[idx] = _chunk;
+        ++m_count;
+    }
+
+    template <class Alloc>
+    inline void release(Alloc & _alloc)
+    {
+        if (m_storage)
+        {
+            _alloc.deallocate(m_storage);
+            m_storage = Block();
+        }
+        m_count = 0;
+    }
+
+    inline const MemoryChunk * find(const Block & _blk) const
+    {
+        Size idx = upperBound(_blk.ptr);
+        if (!idx)
+            return nullptr;
+
+        const MemoryChunk * ret = data()[idx - 1];
+        return ret->owns(_blk) ? ret : nullptr;
+    }
+
+    inline bool owns(const Block & _blk) const
+    {
+        return find(_blk) != nullptr;
+    }
+
+    inline Size count() const
+    {
+        return m_count;
+    }
+
+  private:
+    inline Size capacity() const
+    {
+        return m_storage.size / sizeof(const MemoryChunk *);
+    }
+
+    inline const MemoryChunk ** data() const
+    {
+        return reinterpret_cast<const MemoryChunk **>(m_storage.ptr);
+    }
+
+    // index of the first chunk that starts after _ptr
+    inline Size upperBound(const void * _ptr) const
+    {
+        const MemoryChunk ** chunks = data();
+        Size first = 0;
+        Size count = m_count;
+        while (count > 0)
+        {
+            Size step = count / 2;
+            Size idx = first + step;
+            if (reinterpret_cast<UPtr>(chunks[idx]->memory.ptr) <= reinterpret_cast<UPtr>(_ptr))
+            {
+                first = idx + 1;
+                count -= step + 1;
+            }
+            else
+                count = step;
+        }
+        return first;
+    }
+
+    Block m_storage;
+    Size m_count;
+};
+} // namespace mem
+} // namespace stick
+
+#endif // STICK_ALLOCATORS_CHUNKREGISTRY_HPP
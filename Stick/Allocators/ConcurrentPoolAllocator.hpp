@@ -0,0 +1,256 @@
+#ifndef STICK_ALLOCATORS_CONCURRENTPOOLALLOCATOR_HPP
+#define STICK_ALLOCATORS_CONCURRENTPOOLALLOCATOR_HPP
+
+#include <Stick/Allocators/PoolAllocator.hpp>
+#include <atomic>
+#include <new>
+
+namespace stick
+{
+namespace mem
+{
+// Thread safe version of PoolAllocator. The free list is a lock-free stack whose head carries a
+// modification tag in the upper (unused) pointer bits to protect against ABA. New chunks are
+// pushed onto a lock-free chunk list, so the ParentAllocator needs to be thread safe, too. Every
+// thread that finds the pool empty allocates a chunk, so threads that drain it at the same time
+// might add a few more chunks than needed.
+//
+// setMinMax and deallocateAll are not thread safe.
+template <class Alloc, Size MinSize, Size MaxSize, Size BucketCount>
+class STICK_API ConcurrentPoolAllocator
+{
+  public:
+    static constexpr Size alignment = Alloc::alignment;
+
+    using ParentAllocator = Alloc;
+
+    inline ConcurrentPoolAllocator() : m_freeList(0), m_chunks(nullptr)
+    {
+    }
+
+    inline ConcurrentPoolAllocator(Size _min, Size _max) : m_freeList(0), m_chunks(nullptr)
+    {
+        setMinMax(_min, _max);
+    }
+
+    ConcurrentPoolAllocator(const ConcurrentPoolAllocator &) = delete;
+    ConcurrentPoolAllocator & operator=(const ConcurrentPoolAllocator &) = delete;
+
+    inline ~ConcurrentPoolAllocator()
+    {
+        MemoryChunk * pb = m_chunks.load(std::memory_order_acquire);
+        while (pb)
+        {
+            MemoryChunk * tmp = pb->next;
+            m_alloc.deallocate({ pb, pb->memory.size + headerAdjustment });
+            pb = tmp;
+        }
+    }
+
+    inline void setMinMax(Size _min, Size _max)
+    {
+        // this function should only be called once
+        STICK_ASSERT(m_min.size() == detail::Undefined);
+        STICK_ASSERT(m_max.size() == detail::Undefined);
+        STICK_ASSERT(_max >= sizeof(Node));
+
+        m_min.set(_min);
+        m_max.set(_max);
+    }
+
+    inline Block allocate(Size _byteCount, Size _alignment)
+    {
+        if (_byteCount <= m_max.size() && _byteCount >= m_min.size())
+        {
+            Tagged head = m_freeList.load(std::memory_order_acquire);
+            while (true)
+            {
+                Node * n = pointer(head);
+                if (!n)
+                {
+                    if (!allocateChunk())
+                        return { nullptr, 0 };
+                    head = m_freeList.load(std::memory_order_acquire);
+                    continue;
+                }
+
+                if (reinterpret_cast<UPtr>(n) % _alignment != 0)
+                    return { nullptr, 0 };
+
+                // n might have been popped and reused by another thread in the meantime, in which
+                // case next is garbage. The tag makes sure that the exchange fails if that happened.
+                Node * next = n->next;
+                if (m_freeList.compare_exchange_weak(head,
+                                                     pack(next, tag(head) + 1),
+                                                     std::memory_order_acq_rel,
+                                                     std::memory_order_acquire))
+                {
+                    return { n, _byteCount };
+                }
+            }
+        }
+
+        return { nullptr, 0 };
+    }
+
+    inline bool owns(const Block & _blk) const
+    {
+        const MemoryChunk * pb = m_chunks.load(std::memory_order_acquire);
+        while (pb)
+        {
+            if (pb->owns(_blk))
+                return true;
+            pb = pb->next;
+        }
+        return false;
+    }
+
+    inline void deallocate(const Block & _blk)
+    {
+        STICK_ASSERT(owns(_blk));
+        Node * p = reinterpret_cast<Node *>(_blk.ptr);
+        push(p, p);
+    }
+
+    inline void deallocateAll()
+    {
+        m_freeList.store(0, std::memory_order_relaxed);
+        MemoryChunk * pb = m_chunks.load(std::memory_order_acquire);
+        while (pb)
+        {
+            Node * first;
+            Node * last;
+            buildChunkList(*pb, first, last);
+            push(first, last);
+            pb = pb->next;
+        }
+    }
+
+    inline Size min() const
+    {
+        return m_min.size();
+    }
+
+    inline Size max() const
+    {
+        return m_max.size();
+    }
+
+    // Only accurate if no other thread is using the allocator.
+    inline Size freeCount() const
+    {
+        Size ret = 0;
+        Node * p = pointer(m_freeList.load(std::memory_order_acquire));
+        while (p)
+        {
+            p = p->next;
+            ret++;
+        }
+        return ret;
+    }
+
+    inline Size chunkCount() const
+    {
+        Size ret = 0;
+        const MemoryChunk * p = m_chunks.load(std::memory_order_acquire);
+        while (p)
+        {
+            p = p->next;
+            ret++;
+        }
+        return ret;
+    }
+
+  private:
+    struct Node
+    {
+        Node * next;
+    };
+
+    // free list head: the pointer lives in the lower bits, a counter that is incremented with
+    // every modification in the upper bits.
+    using Tagged = UInt64;
+
+    static constexpr Size pointerBits = sizeof(void *) == 8 ? 48 : 32;
+    static constexpr Tagged pointerMask = (Tagged(1) << pointerBits) - 1;
+
+    static constexpr Size headerSize = sizeof(MemoryChunk);
+    static constexpr Size headerAdjustment =
+        headerSize % alignment == 0 ? headerSize : headerSize + alignment - headerSize % alignment;
+
+    inline static Node * pointer(Tagged _t)
+    {
+        return reinterpret_cast<Node *>(static_cast<UPtr>(_t & pointerMask));
+    }
+
+    inline static Tagged tag(Tagged _t)
+    {
+        return _t >> pointerBits;
+    }
+
+    inline static Tagged pack(Node * _n, Tagged _tag)
+    {
+        return (static_cast<Tagged>(reinterpret_cast<UPtr>(_n)) & pointerMask) |
+               (_tag << pointerBits);
+    }
+
+    inline void push(Node * _first, Node * _last)
+    {
+        Tagged head = m_freeList.load(std::memory_order_relaxed);
+        do
+        {
+            _last->next = pointer(head);
+        } while (!m_freeList.compare_exchange_weak(head,
+                                                   pack(_first, tag(head) + 1),
+                                                   std::memory_order_release,
+                                                   std::memory_order_relaxed));
+    }
+
+    inline void buildChunkList(const MemoryChunk & _chunk, Node *& _outFirst, Node *& _outLast)
+    {
+        Node * p = reinterpret_cast<Node *>(_chunk.memory.ptr);
+        _outFirst = p;
+        for (Size i = 1; i < BucketCount; ++i)
+        {
+            p->next = reinterpret_cast<Node *>(reinterpret_cast<UPtr>(p) + m_max.size());
+            p = p->next;
+        }
+        p->next = nullptr;
+        _outLast = p;
+    }
+
+    // returns false if the ParentAllocator is out of memory
+    inline bool allocateChunk()
+    {
+        Size size = m_max.size() * BucketCount + headerAdjustment;
+        Block mem = m_alloc.allocate(size, alignment);
+        if (!mem)
+            return false;
+        MemoryChunk * chunk = new (mem.ptr)
+            MemoryChunk({ (void *)((UPtr)mem.ptr + headerAdjustment), mem.size - headerAdjustment });
+
+        // publish the chunk so owns() can see it before any of its nodes are handed out
+        MemoryChunk * head = m_chunks.load(std::memory_order_relaxed);
+        do
+        {
+            chunk->next = head;
+        } while (!m_chunks.compare_exchange_weak(
+            head, chunk, std::memory_order_release, std::memory_order_relaxed));
+
+        Node * first;
+        Node * last;
+        buildChunkList(*chunk, first, last);
+        push(first, last);
+        return true;
+    }
+
+    ParentAllocator m_alloc;
+    detail::DynamicSizeHelper<MinSize> m_min;
+    detail::DynamicSizeHelper<MaxSize> m_max;
+    std::atomic<Tagged> m_freeList;
+    std::atomic<MemoryChunk *> m_chunks;
+};
+} // namespace mem
+} // namespace stick
+
+#endif // STICK_ALLOCATORS_CONCURRENTPOOLALLOCATOR_HPP
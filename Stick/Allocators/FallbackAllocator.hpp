@@ -1,7 +1,7 @@
 #ifndef STICK_ALLOCATORS_FALLBACKALLOCATOR_HPP
 #define STICK_ALLOCATORS_FALLBACKALLOCATOR_HPP
 
-#include <Stick/Allocators/Block.hpp>
+#include <Stick/Allocators/AllocatorUtilities.hpp>
 
 namespace stick
 {
@@ -33,6 +33,15 @@ class STICK_API FallbackAllocator
         return m_fallback.allocate(_byteCount, _alignment);
     }
 
+    inline Block allocateZeroed(Size _byteCount, Size _alignment)
+    {
+        STICK_ASSERT(_byteCount);
+        Block ret = mem::allocateZeroed(m_primary, _byteCount, _alignment);
+        if (ret)
+            return ret;
+        return mem::allocateZeroed(m_fallback, _byteCount, _alignment);
+    }
+
     inline void deallocate(const Block & _blk)
     {
         if (m_primary.owns(_blk))
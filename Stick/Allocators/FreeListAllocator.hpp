@@ -1,7 +1,9 @@
 #ifndef STICK_ALLOCATORS_FREELISTALLOCATOR_HPP
 #define STICK_ALLOCATORS_FREELISTALLOCATOR_HPP
 
-#include <Stick/Allocators/MemoryChunk.hpp>
+#include <Stick/Allocators/AllocatorUtilities.hpp>
+#include <Stick/Allocators/ChunkRegistry.hpp>
+#include <utility>
 
 namespace stick
 {
@@ -17,7 +19,7 @@ class STICK_API FreeListAllocator
 
     // static_assert(S > sizeof(FreeBlock), "The memory is too small.")
 
-    inline FreeListAllocator() : m_freeList(nullptr)
+    inline FreeListAllocator() : m_lastChunk(nullptr), m_freeList(nullptr)
     {
         // m_memory = m_alloc.allocate(S, alignment);
         // STICK_ASSERT(m_memory);
@@ -45,6 +47,7 @@ class STICK_API FreeListAllocator
                 pb = tmp;
             }
         }
+        m_registry.release(m_alloc);
     }
 
     inline Block allocate(Size _byteCount, Size _alignment)
@@ -115,15 +118,7 @@ class STICK_API FreeListAllocator
 
     inline bool owns(const Block & _blk) const
     {
-        const MemoryChunk * pb = &m_firstBlock;
-        while (pb)
-        {
-            auto ret = pb->owns(_blk);
-            if (ret)
-                return ret;
-            pb = pb->next;
-        }
-        return false;
+        return m_registry.owns(_blk);
     }
 
     inline void deallocate(const Block & _blk)
@@ -188,6 +183,63 @@ class STICK_API FreeListAllocator
         }
     }
 
+    // grows _blk in place by absorbing (parts of) the free block that directly follows it
+    inline bool expand(Block & _blk, Size _delta)
+    {
+        STICK_ASSERT(owns(_blk));
+
+        AllocationHeader * header = reinterpret_cast<AllocationHeader *>(
+            reinterpret_cast<UPtr>(_blk.ptr) - sizeof(AllocationHeader));
+        UPtr blockEnd = reinterpret_cast<UPtr>(_blk.ptr) - header->adjustment + header->size;
+        UPtr newEnd = _blk.end() + _delta;
+
+        // the block might have enough unused space at its end already
+        if (newEnd <= blockEnd)
+        {
+            _blk.size += _delta;
+            return true;
+        }
+
+        FreeBlock * prevBlock = nullptr;
+        FreeBlock * currentBlock = m_freeList;
+        while (currentBlock != nullptr && reinterpret_cast<UPtr>(currentBlock) != blockEnd)
+        {
+            prevBlock = currentBlock;
+            currentBlock = currentBlock->next;
+        }
+
+        if (!currentBlock || blockEnd + currentBlock->size < newEnd)
+            return false;
+
+        STICK_ASSERT(chunk({ currentBlock, currentBlock->size }) == chunk(_blk));
+
+        Size needed = roundToAlignment(newEnd - blockEnd, alignof(FreeBlock));
+        if (needed < currentBlock->size &&
+            currentBlock->size - needed > sizeof(AllocationHeader))
+        {
+            FreeBlock * rest = reinterpret_cast<FreeBlock *>(blockEnd + needed);
+            rest->size = currentBlock->size - needed;
+            rest->next = currentBlock->next;
+            if (prevBlock)
+                prevBlock->next = rest;
+            else
+                m_freeList = rest;
+        }
+        else
+        {
+            // if the remaining space is too small, we absorb the whole free block
+            needed = currentBlock->size;
+            if (prevBlock)
+                prevBlock->next = currentBlock->next;
+            else
+                m_freeList = currentBlock->next;
+        }
+
+        header->size += needed;
+        _blk.size += _delta;
+        return true;
+    }
+
     inline void deallocateAll()
     {
         // m_freeList = reinterpret_cast<FreeBlock *>(m_memory.ptr);
@@ -254,13 +306,16 @@ class STICK_API FreeListAllocator
         if (!m_firstBlock.memory)
         {
             m_firstBlock = std::move(blk);
+            m_lastChunk = &m_firstBlock;
         }
         else
         {
-            MemoryChunk * last = m_firstBlock.lastChunk();
-            last->next = reinterpret_cast<MemoryChunk *>((UPtr)blk.memory.ptr - headerAdjustment);
-            *last->next = std::move(blk);
+            m_lastChunk->next =
+                reinterpret_cast<MemoryChunk *>((UPtr)blk.memory.ptr - headerAdjustment);
+            *m_lastChunk->next = std::move(blk);
+            m_lastChunk = m_lastChunk->next;
         }
+        m_registry.add(m_lastChunk, m_alloc);
 
         if (!m_freeList)
         {
@@ -284,14 +339,7 @@ class STICK_API FreeListAllocator
 
     inline const MemoryChunk * chunk(const Block & _blk) const
     {
-        const MemoryChunk * pb = &m_firstBlock;
-        while (pb)
-        {
-            if (pb->owns(_blk))
-                return pb;
-            pb = pb->next;
-        }
-        return nullptr;
+        return m_registry.find(_blk);
     }
 
     struct FreeBlock
@@ -308,6 +356,8 @@ class STICK_API FreeListAllocator
 
     ParentAllocator m_alloc;
     MemoryChunk m_firstBlock;
+    MemoryChunk * m_lastChunk;
+    ChunkRegistry m_registry;
     FreeBlock * m_freeList;
 };
 } // namespace mem
@@ -1,6 +1,8 @@
 #ifndef STICK_ALLOCATORS_GLOBALALLOCATOR_HPP
 #define STICK_ALLOCATORS_GLOBALALLOCATOR_HPP
 
+#include <Stick/Allocators/AllocatorUtilities.hpp>
+
 namespace stick
 {
 namespace mem
@@ -16,6 +18,11 @@ class STICK_API GlobalAllocator
         return instance().allocate(_byteCount, _alignment);
     }
 
+    inline Block allocateZeroed(Size _byteCount, Size _alignment)
+    {
+        return mem::allocateZeroed(instance(), _byteCount, _alignment);
+    }
+
     inline bool owns(const Block & _blk)
     {
         return instance().owns(_blk);
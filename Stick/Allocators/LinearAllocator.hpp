@@ -60,6 +60,18 @@ class STICK_API LinearAllocator
         //... otherwise we can't :(
     }
 
+    // only the last allocation can grow, as long as there is room left
+    inline bool expand(Block & _blk, Size _delta)
+    {
+        if (_blk.end() != reinterpret_cast<UPtr>(m_position) ||
+            m_memory.end() - reinterpret_cast<UPtr>(m_position) < _delta)
+            return false;
+
+        m_position = reinterpret_cast<void *>(reinterpret_cast<UPtr>(m_position) + _delta);
+        _blk.size += _delta;
+        return true;
+    }
+
     inline void deallocateAll()
     {
         m_position = m_memory.ptr;
@@ -1,7 +1,7 @@
 #ifndef STICK_ALLOCATORS_MALLOCATOR_HPP
 #define STICK_ALLOCATORS_MALLOCATOR_HPP
 
-#include <Stick/Allocators/Block.hpp>
+#include <Stick/Allocators/AllocatorUtilities.hpp>
 #include <stdlib.h>
 
 namespace stick
@@ -21,11 +21,47 @@ class STICK_API Mallocator
         {
             //@TODO: check if c11 aligned_alloc is available on non posix platforms?
             void * ptr = nullptr;
-            posix_memalign(&ptr, (Size)sizeof(void *), _byteCount);
+            if (posix_memalign(&ptr, _alignment, _byteCount) != 0)
+                return { nullptr, 0 };
             return { ptr, _byteCount };
         }
     }
 
+    inline Block allocateZeroed(Size _byteCount, Size _alignment)
+    {
+        if (_alignment <= sizeof(void *))
+            return { calloc(1, _byteCount), _byteCount };
+
+        Block ret = allocate(_byteCount, _alignment);
+        if (ret)
+            std::memset(ret.ptr, 0, ret.size);
+        return ret;
+    }
+
+    inline bool reallocate(Block & _blk, Size _byteCount, Size _alignment)
+    {
+        // realloc does not preserve alignments beyond the malloc default
+        if (_alignment > sizeof(void *))
+        {
+            Block blk = allocate(_byteCount, _alignment);
+            if (!blk)
+                return false;
+            if (_blk)
+            {
+                std::memcpy(blk.ptr, _blk.ptr, _blk.size < _byteCount ? _blk.size : _byteCount);
+                deallocate(_blk);
+            }
+            _blk = blk;
+            return true;
+        }
+
+        void * ptr = realloc(_blk.ptr, _byteCount);
+        if (!ptr)
+            return false;
+        _blk = { ptr, _byteCount };
+        return true;
+    }
+
     inline void deallocate(const Block & _blk)
     {
         free(_blk.ptr);
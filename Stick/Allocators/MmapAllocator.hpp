@@ -0,0 +1,310 @@
+#ifndef STICK_ALLOCATORS_MMAPALLOCATOR_HPP
+#define STICK_ALLOCATORS_MMAPALLOCATOR_HPP
+
+#include <Stick/Allocators/AllocatorUtilities.hpp>
+#include <Stick/Allocators/Block.hpp>
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace stick
+{
+namespace mem
+{
+enum MmapFlags : UInt32
+{
+    // back the reserved ranges with explicit huge pages (falls back to normal pages if the system
+    // has none configured)
+    MmapHugeTLB = 1,
+    // ask the kernel to back the reserved ranges with transparent huge pages
+    MmapTransparentHugePages = 1 << 1
+};
+
+// Root allocator that hands out page granular Blocks from large virtual address ranges that are
+// reserved with mmap. Pages only get committed when they are handed out (and physically only
+// once they are touched), deallocated Blocks are returned to the OS with MADV_DONTNEED and kept on
+// an address ordered free list for reuse, where they are merged with adjacent free spans. Meant as
+// the ParentAllocator of chunked allocators (i.e. PoolAllocator or FreeListAllocator) whose chunks
+// are large compared to the page size.
+//
+// ReserveSize is the size of the address ranges that get reserved (rounded up to the page size),
+// a new one is reserved once the previous ones are used up.
+template <Size ReserveSize = (Size(1) << 30), UInt32 Flags = 0>
+class STICK_API MmapAllocator
+{
+  public:
+    static constexpr Size alignment = 4096;
+
+    static constexpr Size hugePageSize = Size(1) << 21;
+
+    inline MmapAllocator() : m_ranges(nullptr), m_freeSpans(nullptr)
+    {
+        m_pageSize = static_cast<Size>(sysconf(_SC_PAGESIZE));
+        if (Flags & (MmapHugeTLB | MmapTransparentHugePages))
+            m_pageSize = hugePageSize;
+        STICK_ASSERT(m_pageSize % alignment == 0);
+    }
+
+    MmapAllocator(const MmapAllocator &) = delete;
+    MmapAllocator & operator=(const MmapAllocator &) = delete;
+
+    inline ~MmapAllocator()
+    {
+        Range * r = m_ranges;
+        while (r)
+        {
+            Range * tmp = r->next;
+            munmap(r->memory.ptr, r->memory.size);
+            r = tmp;
+        }
+    }
+
+    inline Block allocate(Size _byteCount, Size _alignment)
+    {
+        STICK_ASSERT(_byteCount > 0);
+
+        // the pages of a free span are committed already
+        void * ret = takeFreeSpan(roundToPage(_byteCount), _alignment);
+        if (ret)
+            return { ret, _byteCount };
+        return allocateFresh(_byteCount, _alignment);
+    }
+
+    // Fresh pages are zero and so are the pages of a free span (they were released with
+    // MADV_DONTNEED), except for the free list node at its start. Fresh pages are not touched, so
+    // they stay uncommitted physically until they are used.
+    inline Block allocateZeroed(Size _byteCount, Size _alignment)
+    {
+        STICK_ASSERT(_byteCount > 0);
+
+        void * ret = takeFreeSpan(roundToPage(_byteCount), _alignment);
+        if (!ret)
+            return allocateFresh(_byteCount, _alignment);
+        std::memset(ret, 0, sizeof(FreeSpan));
+        return { ret, _byteCount };
+    }
+
+    inline bool owns(const Block & _blk) const
+    {
+        const Range * r = m_ranges;
+        while (r)
+        {
+            if (reinterpret_cast<UPtr>(_blk.ptr) >= reinterpret_cast<UPtr>(r->memory.ptr) &&
+                _blk.end() <= r->memory.end())
+                return true;
+            r = r->next;
+        }
+        return false;
+    }
+
+    inline void deallocate(const Block & _blk)
+    {
+        STICK_ASSERT(owns(_blk));
+        Size size = roundToPage(_blk.size);
+        // give the physical pages back to the OS but keep the address range around
+        madvise(_blk.ptr, size, MADV_DONTNEED);
+        insertFreeSpan(_blk.ptr, size);
+    }
+
+    // the granularity of all allocations
+    inline Size pageSize() const
+    {
+        return m_pageSize;
+    }
+
+    inline Size rangeCount() const
+    {
+        Size ret = 0;
+        const Range * r = m_ranges;
+        while (r)
+        {
+            r = r->next;
+            ret++;
+        }
+        return ret;
+    }
+
+    inline Size freeSpanCount() const
+    {
+        Size ret = 0;
+        const FreeSpan * s = m_freeSpans;
+        while (s)
+        {
+            s = s->next;
+            ret++;
+        }
+        return ret;
+    }
+
+  private:
+    // lives in the first (always committed) page of each reserved range
+    struct Range
+    {
+        Block memory;
+        UPtr position;
+        Range * next;
+    };
+
+    // lives in the first page of each free span, which is the only page of it that stays committed
+    struct FreeSpan
+    {
+        Size size;
+        FreeSpan * next;
+    };
+
+    inline Size roundToPage(Size _byteCount) const
+    {
+        return (_byteCount + m_pageSize - 1) / m_pageSize * m_pageSize;
+    }
+
+    // bumps the pages off the current range (or a new one) and commits them
+    inline Block allocateFresh(Size _byteCount, Size _alignment)
+    {
+        Size size = roundToPage(_byteCount);
+        void * ret = bump(m_ranges, size, _alignment);
+        if (!ret)
+        {
+            if (!reserve(size + _alignment))
+                return { nullptr, 0 };
+            ret = bump(m_ranges, size, _alignment);
+            STICK_ASSERT(ret);
+        }
+
+        // commit the pages, the kernel only backs them with physical memory once touched
+        if (mprotect(ret, size, PROT_READ | PROT_WRITE) != 0)
+        {
+            // the pages are still inaccessible, give them back to the range they were bumped from
+            m_ranges->position = reinterpret_cast<UPtr>(ret);
+            return { nullptr, 0 };
+        }
+        return { ret, _byteCount };
+    }
+
+    inline bool reserve(Size _minSize)
+    {
+        Size size = roundToPage((_minSize > ReserveSize ? _minSize : ReserveSize) + m_pageSize);
+        void * mem = MAP_FAILED;
+        int flags = MAP_PRIVATE | MAP_ANONYMOUS;
+#ifdef MAP_NORESERVE
+        flags |= MAP_NORESERVE;
+#endif // MAP_NORESERVE
+
+#ifdef MAP_HUGETLB
+        if (Flags & MmapHugeTLB)
+            mem = mmap(nullptr, size, PROT_NONE, flags | MAP_HUGETLB, -1, 0);
+#endif // MAP_HUGETLB
+
+        if (mem == MAP_FAILED)
+        {
+            mem = mmap(nullptr, size, PROT_NONE, flags, -1, 0);
+            if (mem == MAP_FAILED)
+                return false;
+
+#ifdef MADV_HUGEPAGE
+            if (Flags & (MmapHugeTLB | MmapTransparentHugePages))
+                madvise(mem, size, MADV_HUGEPAGE);
+#endif // MADV_HUGEPAGE
+        }
+
+        if (mprotect(mem, m_pageSize, PROT_READ | PROT_WRITE) != 0)
+        {
+            munmap(mem, size);
+            return false;
+        }
+
+        Range * r = reinterpret_cast<Range *>(mem);
+        r->memory = { mem, size };
+        r->position = reinterpret_cast<UPtr>(mem) + m_pageSize;
+        r->next = m_ranges;
+        m_ranges = r;
+        return true;
+    }
+
+    inline void * bump(Range * _range, Size _size, Size _alignment)
+    {
+        if (!_range)
+            return nullptr;
+
+        UPtr start = _range->position;
+        start += alignmentAdjustment(reinterpret_cast<void *>(start), _alignment);
+        if (start + _size > _range->memory.end())
+            return nullptr;
+
+        // the pages skipped for alignment are lost until the range gets unmapped
+        _range->position = start + _size;
+        return reinterpret_cast<void *>(start);
+    }
+
+    // Keeps the free list sorted by address and merges the span with its neighbours, so that
+    // spans that were split for smaller allocations can serve big ones again once all of them are
+    // deallocated.
+    inline void insertFreeSpan(void * _ptr, Size _size)
+    {
+        UPtr start = reinterpret_cast<UPtr>(_ptr);
+        FreeSpan * prev = nullptr;
+        FreeSpan * next = m_freeSpans;
+        while (next && reinterpret_cast<UPtr>(next) < start)
+        {
+            prev = next;
+            next = next->next;
+        }
+
+        FreeSpan * s;
+        if (prev && reinterpret_cast<UPtr>(prev) + prev->size == start)
+        {
+            prev->size += _size;
+            s = prev;
+        }
+        else
+        {
+            s = reinterpret_cast<FreeSpan *>(_ptr);
+            s->size = _size;
+            s->next = next;
+            if (prev)
+                prev->next = s;
+            else
+                m_freeSpans = s;
+        }
+
+        if (next && reinterpret_cast<UPtr>(s) + s->size == reinterpret_cast<UPtr>(next))
+        {
+            s->size += next->size;
+            s->next = next->next;
+            // only the node at the start of a span may be non zero
+            std::memset(next, 0, sizeof(FreeSpan));
+        }
+    }
+
+    // first fit, a bigger span is split and its tail takes its place in the free list
+    inline void * takeFreeSpan(Size _size, Size _alignment)
+    {
+        FreeSpan ** link = &m_freeSpans;
+        while (*link)
+        {
+            FreeSpan * s = *link;
+            if (s->size >= _size && reinterpret_cast<UPtr>(s) % _alignment == 0)
+            {
+                if (s->size > _size)
+                {
+                    FreeSpan * tail =
+                        reinterpret_cast<FreeSpan *>(reinterpret_cast<UPtr>(s) + _size);
+                    tail->size = s->size - _size;
+                    tail->next = s->next;
+                    *link = tail;
+                }
+                else
+                    *link = s->next;
+                return s;
+            }
+            link = &s->next;
+        }
+        return nullptr;
+    }
+
+    Size m_pageSize;
+    Range * m_ranges;
+    FreeSpan * m_freeSpans;
+};
+} // namespace mem
+} // namespace stick
+
+#endif // STICK_ALLOCATORS_MMAPALLOCATOR_HPP
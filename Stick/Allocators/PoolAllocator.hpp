@@ -2,7 +2,7 @@
 #define STICK_ALLOCATORS_POOLALLOCATOR_HPP
 
 #include <limits>
-#include <Stick/Allocators/MemoryChunk.hpp>
+#include <Stick/Allocators/ChunkRegistry.hpp>
 
 namespace stick
 {
@@ -56,7 +56,7 @@ class STICK_API PoolAllocator
 
     using ParentAllocator = Alloc;
 
-    inline PoolAllocator() : m_freeList(nullptr)
+    inline PoolAllocator() : m_lastChunk(nullptr), m_freeList(nullptr)
     {
         // if (m_min.size() != detail::Undefined && m_max.size() != detail::Undefined)
         // {
@@ -64,7 +64,7 @@ class STICK_API PoolAllocator
         // }
     }
 
-    inline PoolAllocator(Size _min, Size _max) : m_freeList(nullptr)
+    inline PoolAllocator(Size _min, Size _max) : m_lastChunk(nullptr), m_freeList(nullptr)
     {
         setMinMax(_min, _max);
     }
@@ -88,6 +88,7 @@ class STICK_API PoolAllocator
                 pb = tmp;
             }
         }
+        m_registry.release(m_alloc);
     }
 
     inline void setMinMax(Size _min, Size _max)
@@ -124,15 +125,7 @@ class STICK_API PoolAllocator
 
     inline bool owns(const Block & _blk) const
     {
-        const MemoryChunk * pb = &m_firstBlock;
-        while (pb)
-        {
-            auto ret = pb->owns(_blk);
-            if (ret)
-                return ret;
-            pb = pb->next;
-        }
-        return false;
+        return m_registry.owns(_blk);
     }
 
     inline void deallocate(const Block & _blk)
@@ -246,13 +239,16 @@ class STICK_API PoolAllocator
         if (!m_firstBlock.memory)
         {
             m_firstBlock = std::move(blk);
+            m_lastChunk = &m_firstBlock;
         }
         else
         {
-            MemoryChunk * last = m_firstBlock.lastChunk();
-            last->next = reinterpret_cast<MemoryChunk *>((UPtr)blk.memory.ptr - headerAdjustment);
-            *last->next = std::move(blk);
+            m_lastChunk->next =
+                reinterpret_cast<MemoryChunk *>((UPtr)blk.memory.ptr - headerAdjustment);
+            *m_lastChunk->next = std::move(blk);
+            m_lastChunk = m_lastChunk->next;
         }
+        m_registry.add(m_lastChunk, m_alloc);
 
         // build the linked list of buckets
         Node * p = reinterpret_cast<Node *>(blk.memory.ptr);
@@ -284,6 +280,8 @@ class STICK_API PoolAllocator
     detail::DynamicSizeHelper<MinSize> m_min;
     detail::DynamicSizeHelper<MaxSize> m_max;
     MemoryChunk m_firstBlock;
+    MemoryChunk * m_lastChunk;
+    ChunkRegistry m_registry;
     struct Node
     {
         Node * next;
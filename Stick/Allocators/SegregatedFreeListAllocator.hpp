@@ -0,0 +1,359 @@
+#ifndef STICK_ALLOCATORS_SEGREGATEDFREELISTALLOCATOR_HPP
+#define STICK_ALLOCATORS_SEGREGATEDFREELISTALLOCATOR_HPP
+
+#include <Stick/Allocators/AllocatorUtilities.hpp>
+#include <Stick/Allocators/ChunkRegistry.hpp>
+#include <new>
+
+namespace stick
+{
+namespace mem
+{
+// Segregated fit version of FreeListAllocator. Free blocks are kept in size bins (every power of two
+// range is split into four linear sub ranges) and a two level bitmap of the non empty bins, so
+// finding a fitting block does not require walking a long free list.
+// Every block stores its own size and the size of the physically preceding block, which allows
+// coalescing with both neighbours in constant time when a block is deallocated.
+template <class Alloc, Size S>
+class STICK_API SegregatedFreeListAllocator
+{
+  public:
+    static constexpr Size alignment = Alloc::alignment;
+
+    using ParentAllocator = Alloc;
+
+    inline SegregatedFreeListAllocator() : m_chunks(nullptr)
+    {
+        clearBins();
+    }
+
+    SegregatedFreeListAllocator(const SegregatedFreeListAllocator &) = delete;
+    SegregatedFreeListAllocator & operator=(const SegregatedFreeListAllocator &) = delete;
+
+    inline ~SegregatedFreeListAllocator()
+    {
+        // the chunk headers live at the start of each chunk allocation
+        MemoryChunk * pb = m_chunks;
+        while (pb)
+        {
+            MemoryChunk * tmp = pb->next;
+            m_alloc.deallocate({ pb, chunkAllocationSize });
+            pb = tmp;
+        }
+        m_registry.release(m_alloc);
+    }
+
+    inline Block allocate(Size _byteCount, Size _alignment)
+    {
+        STICK_ASSERT(_byteCount > 0);
+
+        Size size = blockSize(_byteCount);
+        Size searchSize = _alignment > granularity ? size + 2 * _alignment : size;
+        if (searchSize > chunkCapacity)
+            return Block();
+
+        BlockHeader * hdr = findFreeBlock(searchSize);
+        if (!hdr)
+        {
+            allocateChunk();
+            hdr = findFreeBlock(searchSize);
+            STICK_ASSERT(hdr);
+        }
+        removeFreeBlock(hdr);
+
+        if (_alignment > granularity)
+        {
+            // split off the part in front of the aligned address as its own free block
+            UPtr start = reinterpret_cast<UPtr>(hdr);
+            UPtr userAddr = start + headerSize;
+            UPtr gap = alignmentAdjustment(reinterpret_cast<void *>(userAddr), _alignment);
+            if (gap && gap < minBlockSize)
+                gap += _alignment;
+
+            if (gap)
+            {
+                BlockHeader * aligned = reinterpret_cast<BlockHeader *>(start + gap);
+                aligned->size = hdr->size - gap;
+                aligned->prevSize = gap;
+                nextBlock(aligned)->prevSize = aligned->size;
+                hdr->size = gap;
+                insertFreeBlock(hdr);
+                hdr = aligned;
+            }
+        }
+
+        splitBlock(hdr, size);
+        hdr->size |= usedFlag;
+
+        void * ret = reinterpret_cast<void *>(reinterpret_cast<UPtr>(hdr) + headerSize);
+        STICK_ASSERT(reinterpret_cast<UPtr>(ret) % _alignment == 0);
+        STICK_ASSERT(owns({ ret, _byteCount }));
+        return { ret, _byteCount };
+    }
+
+    inline bool owns(const Block & _blk) const
+    {
+        return m_registry.owns(_blk);
+    }
+
+    inline void deallocate(const Block & _blk)
+    {
+        STICK_ASSERT(owns(_blk));
+
+        BlockHeader * hdr = header(_blk.ptr);
+        STICK_ASSERT(isUsed(hdr));
+        hdr->size &= ~usedFlag;
+
+        // merge with the following block
+        BlockHeader * next = nextBlock(hdr);
+        if (!isUsed(next))
+        {
+            removeFreeBlock(next);
+            hdr->size += next->size;
+        }
+
+        // merge with the preceding block
+        if (hdr->prevSize)
+        {
+            BlockHeader * prev =
+                reinterpret_cast<BlockHeader *>(reinterpret_cast<UPtr>(hdr) - hdr->prevSize);
+            if (!isUsed(prev))
+            {
+                removeFreeBlock(prev);
+                prev->size += hdr->size;
+                hdr = prev;
+            }
+        }
+
+        nextBlock(hdr)->prevSize = hdr->size;
+        insertFreeBlock(hdr);
+    }
+
+    inline void deallocateAll()
+    {
+        clearBins();
+
+        MemoryChunk * pb = m_chunks;
+        while (pb)
+        {
+            resetChunk(*pb);
+            pb = pb->next;
+        }
+    }
+
+    inline Size freeCount() const
+    {
+        Size ret = 0;
+        for (Size i = 0; i < binCount; ++i)
+        {
+            FreeBlock * p = m_bins[i];
+            while (p)
+            {
+                p = p->next;
+                ret++;
+            }
+        }
+        return ret;
+    }
+
+    inline Size chunkCount() const
+    {
+        return m_registry.count();
+    }
+
+  private:
+    struct BlockHeader
+    {
+        // size of the block including the header, the lowest bit marks a used block
+        Size size;
+        // size of the physically preceding block, zero for the first block of a chunk
+        Size prevSize;
+    };
+
+    struct FreeBlock
+    {
+        BlockHeader header;
+        FreeBlock * prev;
+        FreeBlock * next;
+    };
+
+    static constexpr Size granularity = 16;
+    static constexpr Size usedFlag = 1;
+    static constexpr Size subBinBits = 2;
+    static constexpr Size subBinCount = 1 << subBinBits;
+    static constexpr Size rangeCount = sizeof(Size) * 8;
+    static constexpr Size binCount = rangeCount * subBinCount;
+    static constexpr Size headerSize =
+        (sizeof(BlockHeader) + granularity - 1) / granularity * granularity;
+    static constexpr Size minBlockSize =
+        (sizeof(FreeBlock) + granularity - 1) / granularity * granularity;
+    static constexpr Size chunkCapacity = S / granularity * granularity;
+    static constexpr Size chunkHeaderSize = sizeof(MemoryChunk);
+    // MemoryChunk header plus worst case padding to align the first block to the granularity
+    static constexpr Size chunkOverhead = chunkHeaderSize + granularity;
+    // the chunk capacity plus the sentinel header at the end of the chunk
+    static constexpr Size chunkAllocationSize = chunkOverhead + chunkCapacity + headerSize;
+
+    static_assert(chunkCapacity >= minBlockSize, "The chunk size is too small.");
+
+    inline static Size blockSize(Size _byteCount)
+    {
+        Size ret = (_byteCount + headerSize + granularity - 1) / granularity * granularity;
+        return ret < minBlockSize ? minBlockSize : ret;
+    }
+
+    inline static bool isUsed(const BlockHeader * _hdr)
+    {
+        return _hdr->size & usedFlag;
+    }
+
+    inline static BlockHeader * header(void * _ptr)
+    {
+        return reinterpret_cast<BlockHeader *>(reinterpret_cast<UPtr>(_ptr) - headerSize);
+    }
+
+    inline static BlockHeader * nextBlock(BlockHeader * _hdr)
+    {
+        return reinterpret_cast<BlockHeader *>(reinterpret_cast<UPtr>(_hdr) +
+                                               (_hdr->size & ~usedFlag));
+    }
+
+    inline static Size binIndex(Size _size)
+    {
+        // blocks are at least minBlockSize big, so the range is always > subBinBits
+        Size range = log2Floor(_size);
+        return range * subBinCount + ((_size >> (range - subBinBits)) & (subBinCount - 1));
+    }
+
+    inline void clearBins()
+    {
+        for (Size i = 0; i < binCount; ++i)
+            m_bins[i] = nullptr;
+        for (Size i = 0; i < rangeCount; ++i)
+            m_subBinMasks[i] = 0;
+        m_rangeMask = 0;
+    }
+
+    inline BlockHeader * findFreeBlock(Size _size)
+    {
+        // Only the head of the bin that _size falls into is checked to keep the larger blocks
+        // intact. Walking that bin could take time linear in the number of free blocks...
+        FreeBlock * p = m_bins[binIndex(_size)];
+        if (p && p->header.size >= _size)
+            return &p->header;
+
+        // ...so otherwise take the first block of the bins that start at or above _size, all of
+        // which are big enough.
+        Size range = log2Floor(_size);
+        Size rounded = _size + (Size(1) << (range - subBinBits)) - 1;
+        if (rounded < _size)
+            return nullptr;
+        Size bin = binIndex(rounded);
+        range = bin / subBinCount;
+
+        Size subMask = m_subBinMasks[range] & (~Size(0) << (bin % subBinCount));
+        if (!subMask)
+        {
+            Size rangeMask = range + 1 < rangeCount ? m_rangeMask & (~Size(0) << (range + 1)) : 0;
+            if (!rangeMask)
+                return nullptr;
+            range = countTrailingZeros(rangeMask);
+            subMask = m_subBinMasks[range];
+        }
+        return &m_bins[range * subBinCount + countTrailingZeros(subMask)]->header;
+    }
+
+    inline void insertFreeBlock(BlockHeader * _hdr)
+    {
+        STICK_ASSERT(!isUsed(_hdr));
+        Size bin = binIndex(_hdr->size);
+        FreeBlock * fb = reinterpret_cast<FreeBlock *>(_hdr);
+        fb->prev = nullptr;
+        fb->next = m_bins[bin];
+        if (fb->next)
+            fb->next->prev = fb;
+        m_bins[bin] = fb;
+        m_subBinMasks[bin / subBinCount] |= UInt8(1) << (bin % subBinCount);
+        m_rangeMask |= Size(1) << (bin / subBinCount);
+    }
+
+    inline void removeFreeBlock(BlockHeader * _hdr)
+    {
+        Size bin = binIndex(_hdr->size);
+        FreeBlock * fb = reinterpret_cast<FreeBlock *>(_hdr);
+        if (fb->prev)
+            fb->prev->next = fb->next;
+        else
+            m_bins[bin] = fb->next;
+        if (fb->next)
+            fb->next->prev = fb->prev;
+
+        if (!m_bins[bin])
+        {
+            Size range = bin / subBinCount;
+            m_subBinMasks[range] &= ~(UInt8(1) << (bin % subBinCount));
+            if (!m_subBinMasks[range])
+                m_rangeMask &= ~(Size(1) << range);
+        }
+    }
+
+    // shrinks the free block _hdr to _size and puts the remainder back into the bins
+    inline void splitBlock(BlockHeader * _hdr, Size _size)
+    {
+        STICK_ASSERT(_hdr->size >= _size);
+        Size remainder = _hdr->size - _size;
+        if (remainder >= minBlockSize)
+        {
+            _hdr->size = _size;
+            BlockHeader * rest = nextBlock(_hdr);
+            rest->size = remainder;
+            rest->prevSize = _size;
+            nextBlock(rest)->prevSize = remainder;
+            insertFreeBlock(rest);
+        }
+    }
+
+    inline void resetChunk(const MemoryChunk & _chunk)
+    {
+        BlockHeader * hdr = reinterpret_cast<BlockHeader *>(_chunk.memory.ptr);
+        hdr->size = chunkCapacity;
+        hdr->prevSize = 0;
+
+        BlockHeader * sentinel = nextBlock(hdr);
+        sentinel->size = usedFlag;
+        sentinel->prevSize = chunkCapacity;
+
+        insertFreeBlock(hdr);
+    }
+
+    inline void allocateChunk()
+    {
+        Block mem = m_alloc.allocate(chunkAllocationSize, alignment);
+        STICK_ASSERT(mem);
+
+        UPtr first = reinterpret_cast<UPtr>(mem.ptr) + chunkHeaderSize;
+        first += alignmentAdjustment(reinterpret_cast<void *>(first), granularity);
+        STICK_ASSERT(first + chunkCapacity + headerSize <= mem.end());
+
+        MemoryChunk * chunk =
+            new (mem.ptr) MemoryChunk({ reinterpret_cast<void *>(first), chunkCapacity });
+        chunk->next = m_chunks;
+        m_chunks = chunk;
+        m_registry.add(chunk, m_alloc);
+
+        resetChunk(*chunk);
+    }
+
+    ParentAllocator m_alloc;
+    MemoryChunk * m_chunks;
+    ChunkRegistry m_registry;
+    FreeBlock * m_bins[binCount];
+    // bit i is set if any of the sub bins of the power of two range i is not empty
+    Size m_rangeMask;
+    // bit j of m_subBinMasks[i] is set if sub bin j of range i is not empty
+    UInt8 m_subBinMasks[rangeCount];
+};
+} // namespace mem
+} // namespace stick
+
+#endif // STICK_ALLOCATORS_SEGREGATEDFREELISTALLOCATOR_HPP
@@ -1,7 +1,7 @@
 #ifndef STICK_ALLOCATORS_SEGREGATOR_HPP
 #define STICK_ALLOCATORS_SEGREGATOR_HPP
 
-#include <Stick/Allocators/Block.hpp>
+#include <Stick/Allocators/AllocatorUtilities.hpp>
 #include <tuple>
 
 namespace stick
@@ -36,6 +36,11 @@ class STICK_API Segregator<Allocator>
         return m_alloc.allocate(_byteCount, _alignment);
     }
 
+    inline Block allocateZeroed(Size _byteCount, Size _alignment)
+    {
+        return mem::allocateZeroed(m_alloc, _byteCount, _alignment);
+    }
+
     inline void deallocate(const Block & _blk)
     {
         m_alloc.deallocate(_blk);
@@ -51,17 +56,22 @@ class STICK_API Segregator<>
   public:
     static constexpr Size alignment = -1;
 
-    inline bool owns(const Block & _blk)
+    inline bool owns(const Block &)
     {
         return false;
     }
 
-    inline Block allocate(Size _byteCount, Size _alignment)
+    inline Block allocate(Size, Size)
     {
         return { nullptr, 0 };
     }
 
-    inline void deallocate(const Block & _blk)
+    inline Block allocateZeroed(Size, Size)
+    {
+        return { nullptr, 0 };
+    }
+
+    inline void deallocate(const Block &)
     {
         //@TODO: Assert false?
     }
@@ -97,6 +107,15 @@ class STICK_API Segregator<T<Threshold>, Alloc, Args...>
             return m_large.allocate(_byteCount, _alignment);
     }
 
+    inline Block allocateZeroed(Size _byteCount, Size _alignment)
+    {
+        STICK_ASSERT(_byteCount);
+        if (_byteCount <= Threshold)
+            return mem::allocateZeroed(m_small, _byteCount, _alignment);
+        else
+            return m_large.allocateZeroed(_byteCount, _alignment);
+    }
+
     inline void deallocate(const Block & _blk)
     {
         if (_blk.size <= Threshold)
@@ -0,0 +1,341 @@
+#ifndef STICK_ALLOCATORS_STATSALLOCATOR_HPP
+#define STICK_ALLOCATORS_STATSALLOCATOR_HPP
+
+#include <Stick/Allocators/AllocatorUtilities.hpp>
+#include <Stick/Allocators/Block.hpp>
+#include <Stick/HighResolutionClock.hpp>
+#include <atomic>
+
+namespace stick
+{
+namespace mem
+{
+// Allocation counters shared by StatsAllocator and stick::TrackingAllocator. All counters are
+// relaxed atomics, so recording is cheap and safe no matter if the tracked allocator is thread
+// safe or not. To keep threads from contending on the same cache lines, every thread records into
+// one of shardCount cache line sized shards, which are only summed up by snapshot(). The live bytes
+// of a shard are moved to the shared counter in batches of liveBytesBatch bytes, so peakBytes is
+// exact for a single thread but might be off by up to shardCount * liveBytesBatch bytes if multiple
+// threads allocate. A Snapshot only reads the counters, it does not stop other threads from
+// allocating, which means the values of a snapshot taken under load are not necessarily consistent
+// with each other.
+class STICK_API AllocationStats
+{
+  public:
+    // size class i counts the allocations of (2^(i-1), 2^i] bytes, the last one everything above
+    static constexpr Size sizeClassCount = 32;
+
+    static constexpr Size callSiteCount = 64;
+
+    static constexpr Size shardCount = 16;
+
+    static constexpr Int64 liveBytesBatch = 1 << 16;
+
+    struct CallSite
+    {
+        // the return address of the sampled allocate call
+        void * address;
+        Size byteCount;
+    };
+
+    struct Snapshot
+    {
+        // allocations per second between _earlier and this snapshot
+        inline Float64 allocationRate(const Snapshot & _earlier) const
+        {
+            return perSecond(allocationCount - _earlier.allocationCount, _earlier);
+        }
+
+        // allocated bytes per second between _earlier and this snapshot
+        inline Float64 byteRate(const Snapshot & _earlier) const
+        {
+            return perSecond(totalBytes - _earlier.totalBytes, _earlier);
+        }
+
+        HighResolutionClock::TimePoint time;
+        UInt64 allocationCount;
+        UInt64 deallocationCount;
+        UInt64 failedCount;
+        UInt64 liveBytes;
+        UInt64 peakBytes;
+        UInt64 totalBytes;
+        UInt64 sizeClasses[sizeClassCount];
+        // the most recent sampled call sites, oldest first
+        CallSite callSites[callSiteCount];
+        Size sampledCount;
+
+      private:
+        inline Float64 perSecond(UInt64 _count, const Snapshot & _earlier) const
+        {
+            Float64 secs = (time - _earlier.time).seconds();
+            return secs > 0 ? _count / secs : 0.0;
+        }
+    };
+
+    inline AllocationStats() : m_sampleInterval(0)
+    {
+        reset();
+    }
+
+    AllocationStats(const AllocationStats &) = delete;
+    AllocationStats & operator=(const AllocationStats &) = delete;
+
+    // Records the return address of every _interval-th allocation of a shard, zero disables
+    // sampling.
+    inline void setSampleInterval(Size _interval)
+    {
+        m_sampleInterval.store(_interval, std::memory_order_relaxed);
+    }
+
+    inline void recordAllocation(const Block & _blk, Size _byteCount, void * _callSite)
+    {
+        Shard & s = shard();
+        if (!_blk)
+        {
+            s.failedCount.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+
+        UInt64 idx = s.allocationCount.fetch_add(1, std::memory_order_relaxed);
+        s.totalBytes.fetch_add(_blk.size, std::memory_order_relaxed);
+        s.sizeClasses[sizeClass(_byteCount)].fetch_add(1, std::memory_order_relaxed);
+
+        Int64 live = s.liveBytes.fetch_add(_blk.size, std::memory_order_relaxed) + _blk.size;
+        if (live > s.peakBytes.load(std::memory_order_relaxed))
+            s.peakBytes.store(live, std::memory_order_relaxed);
+        if (live >= liveBytesBatch)
+            flushLiveBytes(s);
+
+        Size interval = m_sampleInterval.load(std::memory_order_relaxed);
+        if (interval && idx % interval == 0)
+        {
+            UInt64 slot = m_sampledCount.fetch_add(1, std::memory_order_relaxed) % callSiteCount;
+            m_callSites[slot].address.store(_callSite, std::memory_order_relaxed);
+            m_callSites[slot].byteCount.store(_byteCount, std::memory_order_relaxed);
+        }
+    }
+
+    inline void recordDeallocation(const Block & _blk)
+    {
+        Shard & s = shard();
+        s.deallocationCount.fetch_add(1, std::memory_order_relaxed);
+        Int64 live = s.liveBytes.fetch_sub(_blk.size, std::memory_order_relaxed) - _blk.size;
+        if (live <= -liveBytesBatch)
+            flushLiveBytes(s);
+    }
+
+    // everything that is still alive is gone
+    inline void recordDeallocateAll()
+    {
+        // move the peaks of the shards over before they are lost
+        for (Size i = 0; i < shardCount; ++i)
+            flushLiveBytes(m_shards[i]);
+        m_liveBytes.store(0, std::memory_order_relaxed);
+    }
+
+    inline Snapshot snapshot() const
+    {
+        Snapshot ret;
+        ret.time = HighResolutionClock::now();
+        ret.allocationCount = 0;
+        ret.deallocationCount = 0;
+        ret.failedCount = 0;
+        ret.totalBytes = 0;
+        for (Size i = 0; i < sizeClassCount; ++i)
+            ret.sizeClasses[i] = 0;
+
+        Int64 flushed = m_liveBytes.load(std::memory_order_relaxed);
+        Int64 live = flushed;
+        Int64 peak = m_peakBytes.load(std::memory_order_relaxed);
+        for (Size i = 0; i < shardCount; ++i)
+        {
+            const Shard & s = m_shards[i];
+            ret.allocationCount += s.allocationCount.load(std::memory_order_relaxed);
+            ret.deallocationCount += s.deallocationCount.load(std::memory_order_relaxed);
+            ret.failedCount += s.failedCount.load(std::memory_order_relaxed);
+            ret.totalBytes += s.totalBytes.load(std::memory_order_relaxed);
+            for (Size j = 0; j < sizeClassCount; ++j)
+                ret.sizeClasses[j] += s.sizeClasses[j].load(std::memory_order_relaxed);
+
+            live += s.liveBytes.load(std::memory_order_relaxed);
+            Int64 shardPeak = flushed + s.peakBytes.load(std::memory_order_relaxed);
+            if (shardPeak > peak)
+                peak = shardPeak;
+        }
+        live = live > 0 ? live : 0;
+        ret.liveBytes = live;
+        ret.peakBytes = peak > live ? peak : live;
+
+        UInt64 sampled = m_sampledCount.load(std::memory_order_relaxed);
+        ret.sampledCount = sampled < callSiteCount ? sampled : callSiteCount;
+        for (Size i = 0; i < ret.sampledCount; ++i)
+        {
+            const SampledCallSite & cs = m_callSites[(sampled - ret.sampledCount + i) % callSiteCount];
+            ret.callSites[i].address = cs.address.load(std::memory_order_relaxed);
+            ret.callSites[i].byteCount = cs.byteCount.load(std::memory_order_relaxed);
+        }
+        return ret;
+    }
+
+    inline void reset()
+    {
+        for (Size i = 0; i < shardCount; ++i)
+        {
+            Shard & s = m_shards[i];
+            s.allocationCount.store(0, std::memory_order_relaxed);
+            s.deallocationCount.store(0, std::memory_order_relaxed);
+            s.failedCount.store(0, std::memory_order_relaxed);
+            s.totalBytes.store(0, std::memory_order_relaxed);
+            s.liveBytes.store(0, std::memory_order_relaxed);
+            s.peakBytes.store(0, std::memory_order_relaxed);
+            for (Size j = 0; j < sizeClassCount; ++j)
+                s.sizeClasses[j].store(0, std::memory_order_relaxed);
+        }
+        m_liveBytes.store(0, std::memory_order_relaxed);
+        m_peakBytes.store(0, std::memory_order_relaxed);
+        m_sampledCount.store(0, std::memory_order_relaxed);
+    }
+
+    inline static Size sizeClass(Size _byteCount)
+    {
+        Size ret = _byteCount <= 1 ? 0 : log2Floor(_byteCount - 1) + 1;
+        return ret < sizeClassCount ? ret : sizeClassCount - 1;
+    }
+
+  private:
+    struct SampledCallSite
+    {
+        std::atomic<void *> address;
+        std::atomic<Size> byteCount;
+    };
+
+    // Mostly written by a single thread. Its live bytes are the bytes allocated minus the bytes
+    // deallocated through it since they were last moved to m_liveBytes, peakBytes the maximum
+    // they reached since then.
+    struct alignas(64) Shard
+    {
+        std::atomic<UInt64> allocationCount;
+        std::atomic<UInt64> deallocationCount;
+        std::atomic<UInt64> failedCount;
+        std::atomic<UInt64> totalBytes;
+        std::atomic<Int64> liveBytes;
+        std::atomic<Int64> peakBytes;
+        std::atomic<UInt64> sizeClasses[sizeClassCount];
+    };
+
+    inline Shard & shard()
+    {
+        // threads are assigned to the shards round robin
+        static std::atomic<Size> s_nextShard(0);
+        static thread_local Size s_shard =
+            s_nextShard.fetch_add(1, std::memory_order_relaxed) % shardCount;
+        return m_shards[s_shard];
+    }
+
+    inline void flushLiveBytes(Shard & _shard)
+    {
+        Int64 peak = _shard.peakBytes.exchange(0, std::memory_order_relaxed);
+        Int64 live = _shard.liveBytes.exchange(0, std::memory_order_relaxed);
+        Int64 flushed = m_liveBytes.fetch_add(live, std::memory_order_relaxed);
+        peak += flushed;
+        Int64 globalPeak = m_peakBytes.load(std::memory_order_relaxed);
+        while (peak > globalPeak &&
+               !m_peakBytes.compare_exchange_weak(globalPeak, peak, std::memory_order_relaxed))
+        {
+        }
+    }
+
+    Shard m_shards[shardCount];
+    std::atomic<Size> m_sampleInterval;
+    std::atomic<Int64> m_liveBytes;
+    std::atomic<Int64> m_peakBytes;
+    std::atomic<UInt64> m_sampledCount;
+    SampledCallSite m_callSites[callSiteCount];
+};
+
+// Decorator that records AllocationStats for all allocations going through Alloc.
+template <class Alloc>
+class STICK_API StatsAllocator
+{
+  public:
+    static constexpr Size alignment = Alloc::alignment;
+
+    using ParentAllocator = Alloc;
+
+    // the recording functions are not inlined, so the sampled return address is their call site
+    STICK_NOINLINE Block allocate(Size _byteCount, Size _alignment)
+    {
+        Block ret = m_alloc.allocate(_byteCount, _alignment);
+        m_stats.recordAllocation(ret, _byteCount, __builtin_return_address(0));
+        return ret;
+    }
+
+    STICK_NOINLINE Block allocateZeroed(Size _byteCount, Size _alignment)
+    {
+        Block ret = mem::allocateZeroed(m_alloc, _byteCount, _alignment);
+        m_stats.recordAllocation(ret, _byteCount, __builtin_return_address(0));
+        return ret;
+    }
+
+    inline bool owns(const Block & _blk)
+    {
+        return m_alloc.owns(_blk);
+    }
+
+    inline void deallocate(const Block & _blk)
+    {
+        m_stats.recordDeallocation(_blk);
+        m_alloc.deallocate(_blk);
+    }
+
+    // a resize is recorded as the deallocation of the old and the allocation of the new block
+    STICK_NOINLINE bool expand(Block & _blk, Size _delta)
+    {
+        Block old = _blk;
+        if (!mem::expand(m_alloc, _blk, _delta))
+            return false;
+        m_stats.recordDeallocation(old);
+        m_stats.recordAllocation(_blk, _blk.size, __builtin_return_address(0));
+        return true;
+    }
+
+    STICK_NOINLINE bool reallocate(Block & _blk, Size _byteCount, Size _alignment)
+    {
+        Block old = _blk;
+        if (!mem::reallocate(m_alloc, _blk, _byteCount, _alignment))
+            return false;
+        if (old)
+            m_stats.recordDeallocation(old);
+        m_stats.recordAllocation(_blk, _byteCount, __builtin_return_address(0));
+        return true;
+    }
+
+    inline void deallocateAll()
+    {
+        m_stats.recordDeallocateAll();
+        m_alloc.deallocateAll();
+    }
+
+    inline AllocationStats::Snapshot snapshot() const
+    {
+        return m_stats.snapshot();
+    }
+
+    inline AllocationStats & stats()
+    {
+        return m_stats;
+    }
+
+    inline ParentAllocator & parent()
+    {
+        return m_alloc;
+    }
+
+  private:
+    ParentAllocator m_alloc;
+    AllocationStats m_stats;
+};
+} // namespace mem
+} // namespace stick
+
+#endif // STICK_ALLOCATORS_STATSALLOCATOR_HPP
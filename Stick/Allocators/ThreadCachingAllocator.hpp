@@ -0,0 +1,254 @@
+#ifndef STICK_ALLOCATORS_THREADCACHINGALLOCATOR_HPP
+#define STICK_ALLOCATORS_THREADCACHINGALLOCATOR_HPP
+
+#include <Stick/Allocators/AllocatorUtilities.hpp>
+#include <Stick/Mutex.hpp>
+#include <Stick/ScopedLock.hpp>
+
+namespace stick
+{
+namespace mem
+{
+// Thread safe front-end for an allocator that is not thread safe (i.e. a Segregator of
+// PoolAllocators and Bucketizers). Each thread keeps a magazine of free blocks per size class.
+// Allocations and deallocations only touch that magazine, the shared central allocator is only
+// locked to refill an empty or to flush a full magazine, one batch of blocks at a time.
+//
+// This is a monostate: just like GlobalAllocator, all instances of the same ThreadCachingAllocator
+// type share one central allocator and the same per thread caches. Memory allocated through one
+// instance can be deallocated through any other and owns() answers for all of them.
+template <class Alloc, Size MaxSize, Size StepSize, Size MagazineSize = 32>
+class STICK_API ThreadCachingAllocator
+{
+  public:
+    static_assert(MaxSize % StepSize == 0, "MaxSize has to be a multiple of StepSize.");
+    static_assert(MagazineSize >= 2, "MagazineSize has to be at least two.");
+
+    static constexpr Size alignment = Alloc::alignment;
+
+    static constexpr Size sizeClassCount = MaxSize / StepSize;
+
+    static constexpr Size batchSize = MagazineSize / 2;
+
+    using CentralAllocator = Alloc;
+
+    inline Block allocate(Size _byteCount, Size _alignment)
+    {
+        STICK_ASSERT(_byteCount);
+        ThreadCache * tc = threadCache();
+        if (_byteCount > MaxSize || !tc)
+        {
+            // small blocks are deallocated at their size class size, allocate them at it, too
+            Block blk = allocateCentral(centralSize(_byteCount), _alignment);
+            return { blk.ptr, blk ? _byteCount : 0 };
+        }
+
+        Size sc = sizeClass(_byteCount);
+        Magazine & mag = tc->magazines[sc];
+        if (!mag.count)
+            refill(mag, sc, _alignment);
+
+        if (!mag.count)
+            return { nullptr, 0 };
+
+        void * ret = mag.blocks[mag.count - 1];
+        if (reinterpret_cast<UPtr>(ret) % _alignment != 0)
+        {
+            // the cached blocks do not satisfy the alignment, ask the central allocator directly
+            Block blk = allocateCentral(sizeClassSize(sc), _alignment);
+            return { blk.ptr, blk ? _byteCount : 0 };
+        }
+
+        --mag.count;
+        return { ret, _byteCount };
+    }
+
+    inline Block allocateZeroed(Size _byteCount, Size _alignment)
+    {
+        if (_byteCount > MaxSize || !threadCache())
+        {
+            Central & c = central();
+            ScopedLock<Mutex> lock(c.mutex);
+            Block blk = mem::allocateZeroed(c.alloc, centralSize(_byteCount), _alignment);
+            return { blk.ptr, blk ? _byteCount : 0 };
+        }
+
+        // cached blocks are recycled, so there is nothing to be gained from the central allocator
+        Block ret = allocate(_byteCount, _alignment);
+        if (ret)
+            std::memset(ret.ptr, 0, ret.size);
+        return ret;
+    }
+
+    inline bool owns(const Block & _blk)
+    {
+        Central & c = central();
+        ScopedLock<Mutex> lock(c.mutex);
+        return c.alloc.owns({ _blk.ptr, centralSize(_blk.size) });
+    }
+
+    inline void deallocate(const Block & _blk)
+    {
+        ThreadCache * tc = threadCache();
+        if (_blk.size > MaxSize || !tc)
+        {
+            deallocateCentral({ _blk.ptr, centralSize(_blk.size) });
+            return;
+        }
+
+        Size sc = sizeClass(_blk.size);
+        Magazine & mag = tc->magazines[sc];
+        if (mag.count == MagazineSize)
+            flush(mag, sc, batchSize);
+
+        mag.blocks[mag.count++] = _blk.ptr;
+    }
+
+    // Returns all blocks cached by the calling thread to the central allocator.
+    inline void flushThreadCache()
+    {
+        ThreadCache * tc = threadCache();
+        if (!tc)
+            return;
+
+        for (Size i = 0; i < sizeClassCount; ++i)
+            flush(tc->magazines[i], i, tc->magazines[i].count);
+    }
+
+    inline Size cachedCount(Size _byteCount)
+    {
+        ThreadCache * tc = threadCache();
+        if (_byteCount > MaxSize || !tc)
+            return 0;
+        return tc->magazines[sizeClass(_byteCount)].count;
+    }
+
+  private:
+    struct Central
+    {
+        inline Central()
+        {
+            // Mutex initializes itself on the first lock, which is not thread safe. Make sure that
+            // happens before the central allocator is shared.
+            mutex.lock();
+            mutex.unlock();
+        }
+
+        Mutex mutex;
+        Alloc alloc;
+    };
+
+    struct Magazine
+    {
+        void * blocks[MagazineSize];
+        Size count;
+    };
+
+    struct ThreadCache
+    {
+        inline ThreadCache()
+        {
+            for (Size i = 0; i < sizeClassCount; ++i)
+                magazines[i].count = 0;
+        }
+
+        inline ~ThreadCache()
+        {
+            for (Size i = 0; i < sizeClassCount; ++i)
+                ThreadCachingAllocator::flush(magazines[i], i, magazines[i].count);
+
+            // deallocations that happen after this (i.e. from other thread local destructors)
+            // go straight to the central allocator.
+            bDestroyed() = true;
+        }
+
+        Magazine magazines[sizeClassCount];
+    };
+
+    inline static Central & central()
+    {
+        // Never destructed for the same reasons as defaultAllocator(), threads might still return
+        // memory while static objects are destroyed.
+        static Central * s_central = new Central;
+        return *s_central;
+    }
+
+    inline static bool & bDestroyed()
+    {
+        static thread_local bool s_bDestroyed = false;
+        return s_bDestroyed;
+    }
+
+    inline static ThreadCache * threadCache()
+    {
+        if (bDestroyed())
+            return nullptr;
+        static thread_local ThreadCache s_cache;
+        return &s_cache;
+    }
+
+    inline static Size sizeClass(Size _byteCount)
+    {
+        return _byteCount ? (_byteCount - 1) / StepSize : 0;
+    }
+
+    inline static Size sizeClassSize(Size _sizeClass)
+    {
+        return (_sizeClass + 1) * StepSize;
+    }
+
+    inline static Size roundedSize(Size _byteCount)
+    {
+        return sizeClassSize(sizeClass(_byteCount));
+    }
+
+    // the size a block of _byteCount bytes has in the central allocator
+    inline static Size centralSize(Size _byteCount)
+    {
+        return _byteCount > MaxSize ? _byteCount : roundedSize(_byteCount);
+    }
+
+    inline static Block allocateCentral(Size _byteCount, Size _alignment)
+    {
+        Central & c = central();
+        ScopedLock<Mutex> lock(c.mutex);
+        return c.alloc.allocate(_byteCount, _alignment);
+    }
+
+    inline static void deallocateCentral(const Block & _blk)
+    {
+        Central & c = central();
+        ScopedLock<Mutex> lock(c.mutex);
+        c.alloc.deallocate(_blk);
+    }
+
+    inline static void refill(Magazine & _mag, Size _sizeClass, Size _alignment)
+    {
+        Size s = sizeClassSize(_sizeClass);
+        Central & c = central();
+        ScopedLock<Mutex> lock(c.mutex);
+        while (_mag.count < batchSize)
+        {
+            Block blk = c.alloc.allocate(s, _alignment);
+            if (!blk)
+                break;
+            _mag.blocks[_mag.count++] = blk.ptr;
+        }
+    }
+
+    inline static void flush(Magazine & _mag, Size _sizeClass, Size _count)
+    {
+        if (!_count)
+            return;
+
+        Size s = sizeClassSize(_sizeClass);
+        Central & c = central();
+        ScopedLock<Mutex> lock(c.mutex);
+        for (Size i = 0; i < _count; ++i)
+            c.alloc.deallocate({ _mag.blocks[--_mag.count], s });
+    }
+};
+} // namespace mem
+} // namespace stick
+
+#endif // STICK_ALLOCATORS_THREADCACHINGALLOCATOR_HPP
@@ -267,7 +267,7 @@ Error ArgumentParser::parse(const char ** _args, UInt32 _argc)
     return Error();
 }
 
-bool ArgumentParser::argumentWasProvided(const String & _name) const
+bool ArgumentParser::argumentWasProvided(StringView _name) const
 {
     if (auto arg = argument(_name))
     {
@@ -351,9 +351,28 @@ String ArgumentParser::help() const
     return ret;
 }
 
-const ArgumentParser::Argument * ArgumentParser::argument(const String & _name) const
+const ArgumentParser::Argument * ArgumentParser::argument(StringView _name) const
 {
-    auto it = m_indices.find(detail::delimitName(_name));
+    IndexMap::ConstIter it;
+    if (!_name.length() || _name[0] == '-')
+    {
+        it = m_indices.find(_name);
+    }
+    else
+    {
+        // prepend the dashes on the stack to not allocate a delimited copy of the name
+        char buf[128];
+        Size dashCount = _name.length() > 1 ? 2 : 1;
+        if (_name.length() + dashCount <= sizeof(buf))
+        {
+            std::memset(buf, '-', dashCount);
+            std::memcpy(buf + dashCount, _name.data(), _name.length());
+            it = m_indices.find(StringView(buf, _name.length() + dashCount));
+        }
+        else
+            it = m_indices.find(detail::delimitName(String(_name.begin(), _name.end())));
+    }
+
     if (it != m_indices.end())
     {
         return &m_args[it->value];
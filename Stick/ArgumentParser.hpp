@@ -3,7 +3,7 @@
 
 #include <Stick/DynamicArray.hpp>
 #include <Stick/Error.hpp>
-#include <Stick/HashMap.hpp>
+#include <Stick/FlatHashMap.hpp>
 #include <Stick/Maybe.hpp>
 #include <Stick/StringConversion.hpp>
 
@@ -53,7 +53,7 @@ class STICK_API ArgumentParser
         bool bArgumentWasProvided;
     };
 
-    using IndexMap = HashMap<String, Size>;
+    using IndexMap = FlatHashMap<String, Size>;
     using ArgumentArray = DynamicArray<Argument>;
 
     ArgumentParser(const String & _info = "");
@@ -76,18 +76,18 @@ class STICK_API ArgumentParser
 
     String help() const;
 
-    const Argument * argument(const String & _name) const;
+    const Argument * argument(StringView _name) const;
 
-    bool argumentWasProvided(const String & _name) const;
+    bool argumentWasProvided(StringView _name) const;
 
     template <class T>
-    inline Maybe<T> maybe(const String & _name) const;
+    inline Maybe<T> maybe(StringView _name) const;
 
     template <class T>
-    inline T maybe(const String & _name, T _or) const;
+    inline T maybe(StringView _name, T _or) const;
 
     template <class T>
-    inline T get(const String & _name) const;
+    inline T get(StringView _name) const;
 
   private:
     Error addArgumentHelper(const Argument & _arg);
@@ -142,7 +142,7 @@ inline T ArgumentParser::Argument::get(Size _index) const
 }
 
 template <class T>
-inline Maybe<T> ArgumentParser::maybe(const String & _name) const
+inline Maybe<T> ArgumentParser::maybe(StringView _name) const
 {
     const Argument * arg = argument(_name);
     if (arg && arg->values.count())
@@ -151,7 +151,7 @@ inline Maybe<T> ArgumentParser::maybe(const String & _name) const
 }
 
 template <class T>
-inline T ArgumentParser::maybe(const String & _name, T _or) const
+inline T ArgumentParser::maybe(StringView _name, T _or) const
 {
     auto m = maybe<T>(_name);
     if (m)
@@ -160,7 +160,7 @@ inline T ArgumentParser::maybe(const String & _name, T _or) const
 }
 
 template <class T>
-inline T ArgumentParser::get(const String & _name) const
+inline T ArgumentParser::get(StringView _name) const
 {
     return maybe<T>(_name).value();
 }
@@ -0,0 +1,1097 @@
+#ifndef STICK_BTREEMAP_HPP
+#define STICK_BTREEMAP_HPP
+
+#include <Stick/DynamicArray.hpp>
+#include <Stick/Iterator.hpp>
+#include <initializer_list>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace stick
+{
+namespace detail
+{
+constexpr Size btreeNodeCapacity(Size _capacity)
+{
+    return _capacity < 4 ? 4 : (_capacity > 128 ? 128 : _capacity);
+}
+} // namespace detail
+
+// Ordered map implemented as a B+ tree. All key value pairs live in wide leaf nodes of roughly
+// NodeByteSize bytes that are linked to their neighbours, inner nodes only hold separator keys and
+// child pointers. Compared to Map, lookups touch a handful of nodes instead of one node per
+// level of a binary tree, and iteration walks the leaves in key order.
+// Has the same interface as Map. Inserting or removing keys invalidates all iterators.
+template <class K, class V, Size NodeByteSize = 256>
+class BTreeMap
+{
+  public:
+    typedef K KeyType;
+    typedef V ValueType;
+
+    // selects the KeyValuePair constructor that forwards to the key and value constructors
+    struct EmplaceTag
+    {
+    };
+
+    struct KeyValuePair
+    {
+        KeyValuePair(const KeyType & _key, const ValueType & _value) : key(_key), value(_value)
+        {
+        }
+
+        KeyValuePair(KeyType && _key, ValueType && _value) :
+            key(std::move(_key)),
+            value(std::move(_value))
+        {
+        }
+
+        template <class KT, class... Args>
+        KeyValuePair(EmplaceTag, KT && _key, Args &&... _args) :
+            key(std::forward<KT>(_key)),
+            value(std::forward<Args>(_args)...)
+        {
+        }
+
+        KeyType key;
+        ValueType value;
+    };
+
+    static constexpr Size leafCapacity =
+        detail::btreeNodeCapacity(NodeByteSize / sizeof(KeyValuePair));
+
+    static constexpr Size innerCapacity =
+        detail::btreeNodeCapacity(NodeByteSize / (sizeof(KeyType) + sizeof(void *)));
+
+  private:
+    struct Node
+    {
+        bool bLeaf;
+        Size count;
+    };
+
+    // both node types have room for one extra element, so that a full node can take the new
+    // element before it gets split in half
+    struct Leaf : public Node
+    {
+        Leaf * prev;
+        Leaf * next;
+        typename std::aligned_storage<sizeof(KeyValuePair), alignof(KeyValuePair)>::type
+            storage[leafCapacity + 1];
+
+        inline KeyValuePair * items()
+        {
+            return reinterpret_cast<KeyValuePair *>(storage);
+        }
+
+        inline const KeyValuePair * items() const
+        {
+            return reinterpret_cast<const KeyValuePair *>(storage);
+        }
+    };
+
+    // children[i] holds the keys less than keys()[i], children[i + 1] the ones not less than it
+    struct Inner : public Node
+    {
+        typename std::aligned_storage<sizeof(KeyType), alignof(KeyType)>::type
+            storage[innerCapacity + 1];
+        Node * children[innerCapacity + 2];
+
+        inline KeyType * keys()
+        {
+            return reinterpret_cast<KeyType *>(storage);
+        }
+
+        inline const KeyType * keys() const
+        {
+            return reinterpret_cast<const KeyType *>(storage);
+        }
+    };
+
+  public:
+    template <class T, class LT, class VT>
+    struct IterT
+    {
+        typedef LT LeafType;
+        typedef VT ValueType;
+        typedef ValueType & ReferenceType;
+        typedef ValueType * PointerType;
+
+        IterT() : map(nullptr), leaf(nullptr), index(0)
+        {
+        }
+
+        IterT(T * _map, LeafType * _leaf, Size _index) : map(_map), leaf(_leaf), index(_index)
+        {
+        }
+
+        template <class OT, class OLT, class OVT>
+        IterT(const IterT<OT, OLT, OVT> & _other) :
+            map(_other.map),
+            leaf(_other.leaf),
+            index(_other.index)
+        {
+        }
+
+        inline void increment()
+        {
+            if (!leaf)
+                return;
+
+            if (++index == leaf->count)
+            {
+                leaf = leaf->next;
+                index = 0;
+            }
+        }
+
+        inline void decrement()
+        {
+            if (!leaf)
+            {
+                leaf = map->m_lastLeaf;
+                index = leaf ? leaf->count - 1 : 0;
+            }
+            else if (index == 0)
+            {
+                leaf = leaf->prev;
+                index = leaf ? leaf->count - 1 : 0;
+            }
+            else
+                --index;
+        }
+
+        inline bool operator==(const IterT & _other) const
+        {
+            return leaf == _other.leaf && index == _other.index;
+        }
+
+        inline bool operator!=(const IterT & _other) const
+        {
+            return !(*this == _other);
+        }
+
+        inline IterT & operator--()
+        {
+            decrement();
+            return *this;
+        }
+
+        inline IterT operator--(int)
+        {
+            IterT ret = *this;
+            decrement();
+            return ret;
+        }
+
+        inline IterT & operator-=(Size _i)
+        {
+            for (Size i = 0; i < _i; ++i)
+                decrement();
+            return *this;
+        }
+
+        inline IterT operator-(Size _i) const
+        {
+            IterT ret = *this;
+            ret -= _i;
+            return ret;
+        }
+
+        inline IterT & operator++()
+        {
+            increment();
+            return *this;
+        }
+
+        inline IterT operator++(int)
+        {
+            IterT ret = *this;
+            increment();
+            return ret;
+        }
+
+        inline IterT & operator+=(Size _i)
+        {
+            for (Size i = 0; i < _i; ++i)
+                increment();
+            return *this;
+        }
+
+        inline IterT operator+(Size _i) const
+        {
+            IterT ret = *this;
+            ret += _i;
+            return ret;
+        }
+
+        inline ValueType & operator*() const
+        {
+            return leaf->items()[index];
+        }
+
+        inline ValueType * operator->() const
+        {
+            return &leaf->items()[index];
+        }
+
+        T * map;
+        LeafType * leaf;
+        Size index;
+    };
+
+    typedef IterT<BTreeMap, Leaf, KeyValuePair> Iter;
+    typedef IterT<const BTreeMap, const Leaf, const KeyValuePair> ConstIter;
+    typedef ReverseIterator<Iter> ReverseIter;
+    typedef ReverseIterator<ConstIter> ReverseConstIter;
+
+    struct InsertResult
+    {
+        Iter iterator;
+        bool inserted;
+    };
+
+    BTreeMap(Allocator & _alloc = defaultAllocator()) :
+        m_alloc(&_alloc),
+        m_root(nullptr),
+        m_firstLeaf(nullptr),
+        m_lastLeaf(nullptr),
+        m_count(0)
+    {
+    }
+
+    BTreeMap(std::initializer_list<KeyValuePair> _l, Allocator & _alloc = defaultAllocator()) :
+        BTreeMap(_alloc)
+    {
+        insert(_l);
+    }
+
+    BTreeMap(const BTreeMap & _other) : BTreeMap(*_other.m_alloc)
+    {
+        assignSorted(_other.begin(), _other.end());
+    }
+
+    BTreeMap(BTreeMap && _other) :
+        m_alloc(_other.m_alloc),
+        m_root(_other.m_root),
+        m_firstLeaf(_other.m_firstLeaf),
+        m_lastLeaf(_other.m_lastLeaf),
+        m_count(_other.m_count)
+    {
+        _other.m_root = nullptr;
+        _other.m_firstLeaf = nullptr;
+        _other.m_lastLeaf = nullptr;
+        _other.m_count = 0;
+    }
+
+    ~BTreeMap()
+    {
+        clear();
+    }
+
+    inline BTreeMap & operator=(const BTreeMap & _other)
+    {
+        if (this != &_other)
+        {
+            clear();
+            m_alloc = _other.m_alloc;
+            assignSorted(_other.begin(), _other.end());
+        }
+        return *this;
+    }
+
+    inline BTreeMap & operator=(BTreeMap && _other)
+    {
+        if (this != &_other)
+        {
+            clear();
+            m_alloc = _other.m_alloc;
+            m_root = _other.m_root;
+            m_firstLeaf = _other.m_firstLeaf;
+            m_lastLeaf = _other.m_lastLeaf;
+            m_count = _other.m_count;
+            _other.m_root = nullptr;
+            _other.m_firstLeaf = nullptr;
+            _other.m_lastLeaf = nullptr;
+            _other.m_count = 0;
+        }
+        return *this;
+    }
+
+    inline BTreeMap & operator=(std::initializer_list<KeyValuePair> _l)
+    {
+        clear();
+        insert(_l);
+        return *this;
+    }
+
+    inline InsertResult insert(const KeyValuePair & _val)
+    {
+        return insertImpl(_val.key, _val.value);
+    }
+
+    inline InsertResult insert(KeyValuePair && _val)
+    {
+        return insertImpl(std::move(_val.key), std::move(_val.value));
+    }
+
+    inline InsertResult insert(const KeyType & _key, const ValueType & _val)
+    {
+        return insertImpl(_key, _val);
+    }
+
+    inline InsertResult insert(const KeyType & _key, ValueType && _val)
+    {
+        return insertImpl(_key, std::move(_val));
+    }
+
+    // Constructs the value in place from _args if _key does not exist yet. Unlike insert, an
+    // existing value is left untouched.
+    template <class... Args>
+    inline InsertResult tryEmplace(const KeyType & _key, Args &&... _args)
+    {
+        return tryEmplaceImpl(_key, std::forward<Args>(_args)...);
+    }
+
+    template <class... Args>
+    inline InsertResult tryEmplace(KeyType && _key, Args &&... _args)
+    {
+        return tryEmplaceImpl(std::move(_key), std::forward<Args>(_args)...);
+    }
+
+    template <class InputIterT>
+    inline void insert(InputIterT _begin, InputIterT _end)
+    {
+        while (_begin != _end)
+        {
+            insert(*_begin);
+            ++_begin;
+        }
+    }
+
+    inline void insert(std::initializer_list<KeyValuePair> _l)
+    {
+        insert(_l.begin(), _l.end());
+    }
+
+    // Replaces the content of the map with the key value pairs in [_begin, _end), which have to be
+    // sorted by key without duplicates. Builds the tree bottom up with densely packed nodes, which
+    // is a lot faster than inserting the pairs one by one. InputIterT has to be multi pass.
+    template <class InputIterT>
+    inline void assignSorted(InputIterT _begin, InputIterT _end)
+    {
+        clear();
+
+        Size n = 0;
+        for (InputIterT it = _begin; it != _end; ++it)
+            ++n;
+        if (!n)
+            return;
+
+        // spread the pairs evenly over as few leaves as possible
+        Size leafCount = (n + leafCapacity - 1) / leafCapacity;
+        DynamicArray<Node *> level(*m_alloc);
+        level.reserve(leafCount);
+        Leaf * prev = nullptr;
+        for (Size i = 0; i < leafCount; ++i)
+        {
+            Leaf * leaf = createLeaf();
+            Size c = n / leafCount + (i < n % leafCount ? 1 : 0);
+            for (; leaf->count < c; ++_begin)
+            {
+                STICK_ASSERT(!(leaf->count || prev) ||
+                             (*_begin).key > (leaf->count ? leaf->items()[leaf->count - 1].key
+                                                         : prev->items()[prev->count - 1].key));
+                new (leaf->items() + leaf->count++) KeyValuePair{ (*_begin).key, (*_begin).value };
+            }
+            leaf->prev = prev;
+            if (prev)
+                prev->next = leaf;
+            else
+                m_firstLeaf = leaf;
+            prev = leaf;
+            level.append(leaf);
+        }
+        m_lastLeaf = prev;
+        m_count = n;
+
+        // then build the inner levels the same way until only the root is left
+        while (level.count() > 1)
+        {
+            Size childCount = level.count();
+            Size nodeCount = (childCount + innerCapacity) / (innerCapacity + 1);
+            DynamicArray<Node *> nextLevel(*m_alloc);
+            nextLevel.reserve(nodeCount);
+            Size child = 0;
+            for (Size i = 0; i < nodeCount; ++i)
+            {
+                Inner * inner = createInner();
+                Size c = childCount / nodeCount + (i < childCount % nodeCount ? 1 : 0);
+                inner->children[0] = level[child++];
+                for (Size j = 1; j < c; ++j, ++child)
+                {
+                    new (inner->keys() + inner->count++) KeyType(minKey(level[child]));
+                    inner->children[j] = level[child];
+                }
+                nextLevel.append(inner);
+            }
+            level = std::move(nextLevel);
+        }
+        m_root = level[0];
+    }
+
+    inline ValueType & operator[](const KeyType & _key)
+    {
+        return tryEmplace(_key).iterator->value;
+    }
+
+    inline Iter find(const KeyType & _key)
+    {
+        return findImpl<Iter>(this, _key);
+    }
+
+    inline ConstIter find(const KeyType & _key) const
+    {
+        return findImpl<ConstIter>(this, _key);
+    }
+
+    // Lookup with a different key type (i.e. a StringView or c string for String keys) without
+    // converting it to KeyType. Only available if KeyType can be compared with L.
+    template <class L,
+              class Enable = decltype(std::declval<const KeyType &>() == std::declval<const L &>() &&
+                                      std::declval<const KeyType &>() > std::declval<const L &>())>
+    inline Iter find(const L & _key)
+    {
+        return findImpl<Iter>(this, _key);
+    }
+
+    template <class L,
+              class Enable = decltype(std::declval<const KeyType &>() == std::declval<const L &>() &&
+                                      std::declval<const KeyType &>() > std::declval<const L &>())>
+    inline ConstIter find(const L & _key) const
+    {
+        return findImpl<ConstIter>(this, _key);
+    }
+
+    // the first pair whose key is not less than _key
+    template <class L>
+    inline Iter lowerBound(const L & _key)
+    {
+        return boundImpl<Iter, false>(this, _key);
+    }
+
+    template <class L>
+    inline ConstIter lowerBound(const L & _key) const
+    {
+        return boundImpl<ConstIter, false>(this, _key);
+    }
+
+    // the first pair whose key is greater than _key
+    template <class L>
+    inline Iter upperBound(const L & _key)
+    {
+        return boundImpl<Iter, true>(this, _key);
+    }
+
+    template <class L>
+    inline ConstIter upperBound(const L & _key) const
+    {
+        return boundImpl<ConstIter, true>(this, _key);
+    }
+
+    inline Iter remove(Iter _it)
+    {
+        if (!_it.leaf)
+            return end();
+
+        PathEntry path[maxDepth];
+        Size depth = 0;
+        Leaf * leaf = descend(_it->key, path, depth);
+        STICK_ASSERT(leaf == _it.leaf);
+        return removeImpl(leaf, _it.index, path, depth);
+    }
+
+    inline Iter remove(const KeyType & _key)
+    {
+        if (!m_root)
+            return end();
+
+        PathEntry path[maxDepth];
+        Size depth = 0;
+        Leaf * leaf = descend(_key, path, depth);
+        Size idx = upperBoundIndex(leaf->items(), leaf->count, _key);
+        if (idx == 0 || !(leaf->items()[idx - 1].key == _key))
+            return end();
+        return removeImpl(leaf, idx - 1, path, depth);
+    }
+
+    inline Iter begin()
+    {
+        return Iter(this, m_firstLeaf, 0);
+    }
+
+    inline ConstIter begin() const
+    {
+        return ConstIter(this, m_firstLeaf, 0);
+    }
+
+    inline ReverseIter rbegin()
+    {
+        return ReverseIter(end());
+    }
+
+    inline ReverseConstIter rbegin() const
+    {
+        return ReverseConstIter(end());
+    }
+
+    inline Iter end()
+    {
+        return Iter(this, nullptr, 0);
+    }
+
+    inline ConstIter end() const
+    {
+        return ConstIter(this, nullptr, 0);
+    }
+
+    inline ReverseIter rend()
+    {
+        return ReverseIter(begin());
+    }
+
+    inline ReverseConstIter rend() const
+    {
+        return ReverseConstIter(begin());
+    }
+
+    inline Size count() const
+    {
+        return m_count;
+    }
+
+    inline void clear()
+    {
+        if (m_root)
+            destroyNode(m_root);
+        m_root = nullptr;
+        m_firstLeaf = nullptr;
+        m_lastLeaf = nullptr;
+        m_count = 0;
+    }
+
+    inline Allocator & allocator()
+    {
+        return *m_alloc;
+    }
+
+    inline const Allocator & allocator() const
+    {
+        return *m_alloc;
+    }
+
+  private:
+    static constexpr Size minLeafCount = leafCapacity / 2;
+    static constexpr Size minInnerCount = (innerCapacity - 1) / 2;
+    // even with the minimum fan out of three this is plenty
+    static constexpr Size maxDepth = 40;
+
+    struct PathEntry
+    {
+        Inner * node;
+        Size child;
+    };
+
+    inline static const KeyType & keyOf(const KeyValuePair & _kv)
+    {
+        return _kv.key;
+    }
+
+    inline static const KeyType & keyOf(const KeyType & _key)
+    {
+        return _key;
+    }
+
+    // the index of the first element whose key is greater than _key
+    template <class T, class L>
+    inline static Size upperBoundIndex(const T * _elements, Size _count, const L & _key)
+    {
+        Size lo = 0, hi = _count;
+        while (lo < hi)
+        {
+            Size mid = (lo + hi) / 2;
+            if (keyOf(_elements[mid]) > _key)
+                hi = mid;
+            else
+                lo = mid + 1;
+        }
+        return lo;
+    }
+
+    // the index of the first element whose key is not less than _key
+    template <class L>
+    inline static Size lowerBoundIndex(const KeyValuePair * _elements, Size _count, const L & _key)
+    {
+        Size lo = 0, hi = _count;
+        while (lo < hi)
+        {
+            Size mid = (lo + hi) / 2;
+            if (_elements[mid].key > _key || _elements[mid].key == _key)
+                hi = mid;
+            else
+                lo = mid + 1;
+        }
+        return lo;
+    }
+
+    // walks down to the leaf that contains _key (or would contain it), recording the path
+    template <class L>
+    inline Leaf * descend(const L & _key, PathEntry * _path, Size & _depth) const
+    {
+        Node * n = m_root;
+        while (!n->bLeaf)
+        {
+            Inner * inner = static_cast<Inner *>(n);
+            Size child = upperBoundIndex(inner->keys(), inner->count, _key);
+            STICK_ASSERT(_depth < maxDepth);
+            _path[_depth++] = { inner, child };
+            n = inner->children[child];
+        }
+        return static_cast<Leaf *>(n);
+    }
+
+    template <class L>
+    inline Leaf * descend(const L & _key) const
+    {
+        Node * n = m_root;
+        while (!n->bLeaf)
+        {
+            Inner * inner = static_cast<Inner *>(n);
+            n = inner->children[upperBoundIndex(inner->keys(), inner->count, _key)];
+        }
+        return static_cast<Leaf *>(n);
+    }
+
+    template <class IT, class MapT, class L>
+    inline static IT findImpl(MapT * _map, const L & _key)
+    {
+        if (!_map->m_root)
+            return IT(_map, nullptr, 0);
+
+        Leaf * leaf = _map->descend(_key);
+        Size idx = upperBoundIndex(leaf->items(), leaf->count, _key);
+        if (idx && leaf->items()[idx - 1].key == _key)
+            return IT(_map, leaf, idx - 1);
+        return IT(_map, nullptr, 0);
+    }
+
+    template <class IT, bool Upper, class MapT, class L>
+    inline static IT boundImpl(MapT * _map, const L & _key)
+    {
+        if (!_map->m_root)
+            return IT(_map, nullptr, 0);
+
+        Leaf * leaf = _map->descend(_key);
+        Size idx = Upper ? upperBoundIndex(leaf->items(), leaf->count, _key)
+                         : lowerBoundIndex(leaf->items(), leaf->count, _key);
+        if (idx == leaf->count)
+            return IT(_map, leaf->next, 0);
+        return IT(_map, leaf, idx);
+    }
+
+    template <class KT, class VT>
+    inline InsertResult insertImpl(KT && _key, VT && _value)
+    {
+        // _value is only consumed if the key was inserted
+        InsertResult ret = tryEmplaceImpl(std::forward<KT>(_key), std::forward<VT>(_value));
+
+        // the key allready exists, change the value
+        if (!ret.inserted)
+            ret.iterator->value = std::forward<VT>(_value);
+        return ret;
+    }
+
+    template <class KT, class... Args>
+    inline InsertResult tryEmplaceImpl(KT && _key, Args &&... _args)
+    {
+        if (!m_root)
+        {
+            Leaf * leaf = createLeaf();
+            m_root = m_firstLeaf = m_lastLeaf = leaf;
+        }
+
+        PathEntry path[maxDepth];
+        Size depth = 0;
+        Leaf * leaf = descend(_key, path, depth);
+        Size idx = upperBoundIndex(leaf->items(), leaf->count, _key);
+
+        if (idx && leaf->items()[idx - 1].key == _key)
+            return { Iter(this, leaf, idx - 1), false };
+
+        shiftRight(leaf->items(), idx, leaf->count);
+        new (leaf->items() + idx)
+            KeyValuePair(EmplaceTag(), std::forward<KT>(_key), std::forward<Args>(_args)...);
+        ++leaf->count;
+        ++m_count;
+
+        if (leaf->count <= leafCapacity)
+            return { Iter(this, leaf, idx), true };
+
+        // split the leaf in half and link the new one in after it
+        Leaf * right = createLeaf();
+        Size mid = leaf->count / 2;
+        for (Size i = mid; i < leaf->count; ++i)
+            moveConstruct(right->items() + right->count++, leaf->items() + i);
+        leaf->count = mid;
+
+        right->prev = leaf;
+        right->next = leaf->next;
+        if (leaf->next)
+            leaf->next->prev = right;
+        else
+            m_lastLeaf = right;
+        leaf->next = right;
+
+        Iter ret = idx < mid ? Iter(this, leaf, idx) : Iter(this, right, idx - mid);
+        insertIntoParent(path, depth, leaf, KeyType(right->items()[0].key), right);
+        return { ret, true };
+    }
+
+    // inserts _separator and _right after _left into the parent of _left, splitting all the way
+    // up as needed
+    inline void insertIntoParent(PathEntry * _path, Size _depth, Node * _left, KeyType _separator,
+                                 Node * _right)
+    {
+        while (true)
+        {
+            if (!_depth)
+            {
+                Inner * root = createInner();
+                new (root->keys()) KeyType(std::move(_separator));
+                root->children[0] = _left;
+                root->children[1] = _right;
+                root->count = 1;
+                m_root = root;
+                return;
+            }
+
+            PathEntry & e = _path[--_depth];
+            Inner * p = e.node;
+            shiftRight(p->keys(), e.child, p->count);
+            new (p->keys() + e.child) KeyType(std::move(_separator));
+            for (Size i = p->count + 1; i > e.child + 1; --i)
+                p->children[i] = p->children[i - 1];
+            p->children[e.child + 1] = _right;
+            ++p->count;
+
+            if (p->count <= innerCapacity)
+                return;
+
+            // the middle key moves up, the keys right of it go to the new node
+            Inner * r = createInner();
+            Size mid = p->count / 2;
+            for (Size i = mid + 1; i < p->count; ++i)
+                moveConstruct(r->keys() + r->count++, p->keys() + i);
+            for (Size i = mid + 1; i <= p->count; ++i)
+                r->children[i - mid - 1] = p->children[i];
+            _separator = std::move(p->keys()[mid]);
+            p->keys()[mid].~KeyType();
+            p->count = mid;
+
+            _left = p;
+            _right = r;
+        }
+    }
+
+    inline Iter removeImpl(Leaf * _leaf, Size _index, PathEntry * _path, Size _depth)
+    {
+        _leaf->items()[_index].~KeyValuePair();
+        shiftLeft(_leaf->items(), _index, _leaf->count);
+        --_leaf->count;
+        --m_count;
+
+        // the element following the removed one, kept up to date while rebalancing
+        Leaf * nextLeaf = _leaf;
+        Size nextIndex = _index;
+        if (nextIndex == _leaf->count)
+        {
+            nextLeaf = _leaf->next;
+            nextIndex = 0;
+        }
+
+        if (!_depth)
+        {
+            if (!_leaf->count)
+            {
+                freeLeaf(_leaf);
+                m_root = m_firstLeaf = m_lastLeaf = nullptr;
+            }
+            return Iter(this, nextLeaf, nextIndex);
+        }
+
+        if (_leaf->count >= minLeafCount)
+            return Iter(this, nextLeaf, nextIndex);
+
+        Inner * p = _path[_depth - 1].node;
+        Size ci = _path[_depth - 1].child;
+        Leaf * left = ci > 0 ? static_cast<Leaf *>(p->children[ci - 1]) : nullptr;
+        Leaf * right = ci < p->count ? static_cast<Leaf *>(p->children[ci + 1]) : nullptr;
+
+        if (left && left->count > minLeafCount)
+        {
+            // borrow the last element of the left sibling
+            shiftRight(_leaf->items(), 0, _leaf->count);
+            moveConstruct(_leaf->items(), left->items() + --left->count);
+            ++_leaf->count;
+            p->keys()[ci - 1] = _leaf->items()[0].key;
+            if (nextLeaf == _leaf)
+                ++nextIndex;
+        }
+        else if (right && right->count > minLeafCount)
+        {
+            // borrow the first element of the right sibling
+            moveConstruct(_leaf->items() + _leaf->count++, right->items());
+            shiftLeft(right->items(), 0, right->count);
+            --right->count;
+            p->keys()[ci] = right->items()[0].key;
+            if (nextLeaf == right)
+            {
+                if (nextIndex == 0)
+                {
+                    nextLeaf = _leaf;
+                    nextIndex = _leaf->count - 1;
+                }
+                else
+                    --nextIndex;
+            }
+        }
+        else if (left)
+        {
+            if (nextLeaf == _leaf)
+            {
+                nextLeaf = left;
+                nextIndex += left->count;
+            }
+            mergeLeaves(left, _leaf);
+            removeFromInner(p, ci - 1, ci);
+            rebalanceInner(_path, _depth - 1);
+        }
+        else
+        {
+            STICK_ASSERT(right);
+            if (nextLeaf == right)
+            {
+                nextLeaf = _leaf;
+                nextIndex += _leaf->count;
+            }
+            mergeLeaves(_leaf, right);
+            removeFromInner(p, ci, ci + 1);
+            rebalanceInner(_path, _depth - 1);
+        }
+
+        return Iter(this, nextLeaf, nextIndex);
+    }
+
+    // moves all elements of _right to the end of _left and frees _right
+    inline void mergeLeaves(Leaf * _left, Leaf * _right)
+    {
+        for (Size i = 0; i < _right->count; ++i)
+            moveConstruct(_left->items() + _left->count++, _right->items() + i);
+
+        _left->next = _right->next;
+        if (_right->next)
+            _right->next->prev = _left;
+        else
+            m_lastLeaf = _left;
+        freeLeaf(_right);
+    }
+
+    inline void removeFromInner(Inner * _node, Size _keyIndex, Size _childIndex)
+    {
+        _node->keys()[_keyIndex].~KeyType();
+        shiftLeft(_node->keys(), _keyIndex, _node->count);
+        for (Size i = _childIndex; i < _node->count; ++i)
+            _node->children[i] = _node->children[i + 1];
+        --_node->count;
+    }
+
+    // restores the minimum fill of the inner node at _path[_level] after one of its keys was
+    // removed
+    inline void rebalanceInner(PathEntry * _path, Size _level)
+    {
+        while (true)
+        {
+            Inner * n = _path[_level].node;
+            if (!_level)
+            {
+                // the root collapses once it only has one child left
+                if (!n->count)
+                {
+                    m_root = n->children[0];
+                    freeInner(n);
+                }
+                return;
+            }
+
+            if (n->count >= minInnerCount)
+                return;
+
+            Inner * p = _path[_level - 1].node;
+            Size ci = _path[_level - 1].child;
+            Inner * left = ci > 0 ? static_cast<Inner *>(p->children[ci - 1]) : nullptr;
+            Inner * right = ci < p->count ? static_cast<Inner *>(p->children[ci + 1]) : nullptr;
+
+            if (left && left->count > minInnerCount)
+            {
+                // rotate the last key of the left sibling through the parent
+                shiftRight(n->keys(), 0, n->count);
+                new (n->keys()) KeyType(std::move(p->keys()[ci - 1]));
+                for (Size i = n->count + 1; i > 0; --i)
+                    n->children[i] = n->children[i - 1];
+                n->children[0] = left->children[left->count];
+                p->keys()[ci - 1] = std::move(left->keys()[left->count - 1]);
+                left->keys()[--left->count].~KeyType();
+                ++n->count;
+                return;
+            }
+            else if (right && right->count > minInnerCount)
+            {
+                // rotate the first key of the right sibling through the parent
+                new (n->keys() + n->count) KeyType(std::move(p->keys()[ci]));
+                n->children[n->count + 1] = right->children[0];
+                ++n->count;
+                p->keys()[ci] = std::move(right->keys()[0]);
+                right->keys()[0].~KeyType();
+                shiftLeft(right->keys(), 0, right->count);
+                for (Size i = 0; i < right->count; ++i)
+                    right->children[i] = right->children[i + 1];
+                --right->count;
+                return;
+            }
+            else if (left)
+            {
+                mergeInner(left, std::move(p->keys()[ci - 1]), n);
+                removeFromInner(p, ci - 1, ci);
+            }
+            else
+            {
+                STICK_ASSERT(right);
+                mergeInner(n, std::move(p->keys()[ci]), right);
+                removeFromInner(p, ci, ci + 1);
+            }
+            --_level;
+        }
+    }
+
+    // appends _separator and all keys and children of _right to _left and frees _right
+    inline void mergeInner(Inner * _left, KeyType && _separator, Inner * _right)
+    {
+        new (_left->keys() + _left->count) KeyType(std::move(_separator));
+        _left->children[_left->count + 1] = _right->children[0];
+        ++_left->count;
+        for (Size i = 0; i < _right->count; ++i)
+        {
+            moveConstruct(_left->keys() + _left->count, _right->keys() + i);
+            _left->children[_left->count + 1] = _right->children[i + 1];
+            ++_left->count;
+        }
+        _right->count = 0;
+        freeInner(_right);
+    }
+
+    inline const KeyType & minKey(const Node * _node) const
+    {
+        while (!_node->bLeaf)
+            _node = static_cast<const Inner *>(_node)->children[0];
+        return static_cast<const Leaf *>(_node)->items()[0].key;
+    }
+
+    // moves the constructed elements [_from, _count) one slot to the right, _from is left
+    // unconstructed
+    template <class T>
+    inline static void shiftRight(T * _elements, Size _from, Size _count)
+    {
+        for (Size i = _count; i > _from; --i)
+            moveConstruct(_elements + i, _elements + i - 1);
+    }
+
+    // moves the constructed elements (_from, _count) one slot to the left, _from has to be
+    // unconstructed
+    template <class T>
+    inline static void shiftLeft(T * _elements, Size _from, Size _count)
+    {
+        for (Size i = _from; i + 1 < _count; ++i)
+            moveConstruct(_elements + i, _elements + i + 1);
+    }
+
+    template <class T>
+    inline static void moveConstruct(T * _dst, T * _src)
+    {
+        new (_dst) T(std::move(*_src));
+        _src->~T();
+    }
+
+    inline Leaf * createLeaf()
+    {
+        auto mem = m_alloc->allocate(sizeof(Leaf), alignof(Leaf));
+        STICK_ASSERT(mem);
+        Leaf * ret = new (mem.ptr) Leaf;
+        ret->bLeaf = true;
+        ret->count = 0;
+        ret->prev = nullptr;
+        ret->next = nullptr;
+        return ret;
+    }
+
+    inline Inner * createInner()
+    {
+        auto mem = m_alloc->allocate(sizeof(Inner), alignof(Inner));
+        STICK_ASSERT(mem);
+        Inner * ret = new (mem.ptr) Inner;
+        ret->bLeaf = false;
+        ret->count = 0;
+        return ret;
+    }
+
+    inline void freeLeaf(Leaf * _leaf)
+    {
+        _leaf->~Leaf();
+        m_alloc->deallocate({ _leaf, sizeof(Leaf) });
+    }
+
+    inline void freeInner(Inner * _inner)
+    {
+        _inner->~Inner();
+        m_alloc->deallocate({ _inner, sizeof(Inner) });
+    }
+
+    inline void destroyNode(Node * _node)
+    {
+        if (_node->bLeaf)
+        {
+            Leaf * leaf = static_cast<Leaf *>(_node);
+            for (Size i = 0; i < leaf->count; ++i)
+                leaf->items()[i].~KeyValuePair();
+            freeLeaf(leaf);
+        }
+        else
+        {
+            Inner * inner = static_cast<Inner *>(_node);
+            for (Size i = 0; i <= inner->count; ++i)
+                destroyNode(inner->children[i]);
+            for (Size i = 0; i < inner->count; ++i)
+                inner->keys()[i].~KeyType();
+            freeInner(inner);
+        }
+    }
+
+    Allocator * m_alloc;
+    Node * m_root;
+    Leaf * m_firstLeaf;
+    Leaf * m_lastLeaf;
+    Size m_count;
+};
+} // namespace stick
+
+#endif // STICK_BTREEMAP_HPP
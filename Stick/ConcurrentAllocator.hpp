@@ -0,0 +1,49 @@
+#ifndef STICK_CONCURRENTALLOCATOR_HPP
+#define STICK_CONCURRENTALLOCATOR_HPP
+
+#include <Stick/Allocator.hpp>
+#include <Stick/Allocators/ThreadCachingAllocator.hpp>
+
+namespace stick
+{
+// Thread safe version of ExperimentalAllocator. Small allocations are served from per thread caches
+// so that worker threads don't contend on the shared size class pools.
+class STICK_API ConcurrentAllocator : public Allocator
+{
+  public:
+    ConcurrentAllocator()
+    {
+    }
+
+    ~ConcurrentAllocator()
+    {
+    }
+
+    inline mem::Block allocate(Size _byteCount, Size _alignment) override
+    {
+        return m_alloc.allocate(_byteCount, _alignment);
+    }
+
+    inline mem::Block allocateZeroed(Size _byteCount, Size _alignment) override
+    {
+        return m_alloc.allocateZeroed(_byteCount, _alignment);
+    }
+
+    inline void deallocate(const mem::Block & _block) override
+    {
+        m_alloc.deallocate(_block);
+    }
+
+  private:
+    mem::ThreadCachingAllocator<detail::ExperimentalSegregator, 1024, 16> m_alloc;
+};
+
+inline STICK_API Allocator & concurrentAllocator()
+{
+    // See note at defaultAllocator()
+    static ConcurrentAllocator * m_def = new ConcurrentAllocator;
+    return *m_def;
+}
+} // namespace stick
+
+#endif // STICK_CONCURRENTALLOCATOR_HPP
@@ -0,0 +1,180 @@
+#ifndef STICK_CONCURRENTHASHMAP_HPP
+#define STICK_CONCURRENTHASHMAP_HPP
+
+#include <Stick/FlatHashMap.hpp>
+#include <Stick/Mutex.hpp>
+#include <Stick/ScopedLock.hpp>
+#include <atomic>
+
+namespace stick
+{
+// Thread safe hash map that spreads its keys across a fixed number of shards. Each shard is a
+// FlatHashMap guarded by its own Mutex, so threads only contend if they access keys of the same
+// shard. Values are never handed out by reference, they can only be accessed through
+// findAndApply while the shard is locked.
+template <class K, class V, template <class> class H = DefaultHash>
+class ConcurrentHashMap
+{
+  public:
+    typedef K KeyType;
+    typedef V ValueType;
+    typedef H<KeyType> Hash;
+    typedef FlatHashMap<K, V, H> ShardMap;
+
+    // _shardCount is rounded up to the next power of two
+    inline ConcurrentHashMap(Size _shardCount = 16, Allocator & _alloc = defaultAllocator()) :
+        m_alloc(&_alloc),
+        m_shardCount(1)
+    {
+        while (m_shardCount < _shardCount)
+            m_shardCount *= 2;
+
+        m_memory = m_alloc->allocate(sizeof(Shard) * m_shardCount, alignof(Shard));
+        STICK_ASSERT(m_memory);
+        m_shards = static_cast<Shard *>(m_memory.ptr);
+        for (Size i = 0; i < m_shardCount; ++i)
+        {
+            new (m_shards + i) Shard(_alloc);
+            // Mutex initializes itself on the first lock, which is not thread safe. Make sure that
+            // happens before the map is shared.
+            m_shards[i].mutex.lock();
+            m_shards[i].mutex.unlock();
+        }
+    }
+
+    ConcurrentHashMap(const ConcurrentHashMap &) = delete;
+    ConcurrentHashMap & operator=(const ConcurrentHashMap &) = delete;
+
+    inline ~ConcurrentHashMap()
+    {
+        for (Size i = 0; i < m_shardCount; ++i)
+            m_shards[i].~Shard();
+        m_alloc->deallocate(m_memory);
+    }
+
+    // Inserts the key value pair or assigns the value if the key exists already. Returns true if
+    // the key was inserted.
+    inline bool insertOrAssign(const KeyType & _key, const ValueType & _value)
+    {
+        Shard & s = shard(_key);
+        ScopedLock<Mutex> lock(s.mutex);
+        bool ret = s.map.insert(_key, _value).inserted;
+        s.count.store(s.map.count(), std::memory_order_relaxed);
+        return ret;
+    }
+
+    inline bool insertOrAssign(const KeyType & _key, ValueType && _value)
+    {
+        Shard & s = shard(_key);
+        ScopedLock<Mutex> lock(s.mutex);
+        bool ret = s.map.insert(_key, std::move(_value)).inserted;
+        s.count.store(s.map.count(), std::memory_order_relaxed);
+        return ret;
+    }
+
+    // Calls _fn with a reference to the value of _key while its shard is locked. Returns false if
+    // the key does not exist. _fn must not access the map.
+    template <class F>
+    inline bool findAndApply(const KeyType & _key, F && _fn)
+    {
+        Shard & s = shard(_key);
+        ScopedLock<Mutex> lock(s.mutex);
+        auto it = s.map.find(_key);
+        if (it == s.map.end())
+            return false;
+        _fn(it->value);
+        return true;
+    }
+
+    template <class F>
+    inline bool findAndApply(const KeyType & _key, F && _fn) const
+    {
+        Shard & s = shard(_key);
+        ScopedLock<Mutex> lock(s.mutex);
+        auto it = s.map.find(_key);
+        if (it == s.map.end())
+            return false;
+        _fn(static_cast<const ValueType &>(it->value));
+        return true;
+    }
+
+    inline bool contains(const KeyType & _key) const
+    {
+        Shard & s = shard(_key);
+        ScopedLock<Mutex> lock(s.mutex);
+        return s.map.find(_key) != s.map.end();
+    }
+
+    // Returns true if the key existed.
+    inline bool erase(const KeyType & _key)
+    {
+        Shard & s = shard(_key);
+        ScopedLock<Mutex> lock(s.mutex);
+        auto it = s.map.find(_key);
+        if (it == s.map.end())
+            return false;
+        s.map.remove(it);
+        s.count.store(s.map.count(), std::memory_order_relaxed);
+        return true;
+    }
+
+    // Clears one shard after the other, keys inserted concurrently might survive.
+    inline void clear()
+    {
+        for (Size i = 0; i < m_shardCount; ++i)
+        {
+            ScopedLock<Mutex> lock(m_shards[i].mutex);
+            m_shards[i].map.clear();
+            m_shards[i].count.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    // The number of keys, without locking the shards. Only exact if no other thread modifies the
+    // map at the same time.
+    inline Size count() const
+    {
+        Size ret = 0;
+        for (Size i = 0; i < m_shardCount; ++i)
+            ret += m_shards[i].count.load(std::memory_order_relaxed);
+        return ret;
+    }
+
+    inline Size shardCount() const
+    {
+        return m_shardCount;
+    }
+
+    Allocator & allocator() const
+    {
+        return *m_alloc;
+    }
+
+  private:
+    // each shard gets its own cache lines so that locking one does not slow down its neighbours
+    struct alignas(64) Shard
+    {
+        Shard(Allocator & _alloc) : map(16, _alloc), count(0)
+        {
+        }
+
+        Mutex mutex;
+        ShardMap map;
+        std::atomic<Size> count;
+    };
+
+    inline Shard & shard(const KeyType & _key) const
+    {
+        // use the upper bits of a different mix than the one FlatHashMap uses to pick the slot
+        UInt64 h = static_cast<UInt64>(m_hasher(_key)) * 0xC2B2AE3D27D4EB4FULL;
+        return m_shards[(h >> 32) & (m_shardCount - 1)];
+    }
+
+    Allocator * m_alloc;
+    mem::Block m_memory;
+    Shard * m_shards;
+    Size m_shardCount;
+    Hash m_hasher;
+};
+} // namespace stick
+
+#endif // STICK_CONCURRENTHASHMAP_HPP
@@ -34,6 +34,11 @@ class DefaultCleanup
 
     Allocator * allocator;
 };
+
+template <class T>
+struct IsTriviallyRelocatable<DefaultCleanup<T>> : std::true_type
+{
+};
 } // namespace stick
 
 #endif // STICK_DEFAULTCLEANUP_HPP
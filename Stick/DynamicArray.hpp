@@ -4,8 +4,10 @@
 #include <Stick/Allocator.hpp>
 #include <Stick/Iterator.hpp>
 #include <Stick/Utility.hpp>
+#include <cstring>
 #include <initializer_list>
 #include <new>
+#include <type_traits>
 
 namespace stick
 {
@@ -133,22 +135,26 @@ class DynamicArray
         if (_s > c)
         {
             STICK_ASSERT(m_allocator);
-            auto blk = m_allocator->allocate(_s * sizeof(T), alignof(T));
-            STICK_ASSERT(blk);
-            T * arrayPtr = reinterpret_cast<T *>(blk.ptr);
-            T * sourcePtr = reinterpret_cast<T *>(m_data.ptr);
 
-            // move the existing elements over
-            for (Size i = 0; i < m_count; ++i)
+            if (m_data)
             {
-                new (arrayPtr + i) T(std::move(sourcePtr[i]));
+                // growing in place does not move the elements, so this works for any T
+                if (m_allocator->expand(m_data, _s * sizeof(T) - m_data.size))
+                    return;
+
+                // trivially relocatable elements can be moved bitwise, i.e. by realloc
+                if (IsTriviallyRelocatable<T>::value)
+                {
+                    bool bSuccess = m_allocator->reallocate(m_data, _s * sizeof(T), alignof(T));
+                    STICK_ASSERT(bSuccess);
+                    STICK_UNUSED(bSuccess);
+                    return;
+                }
             }
 
-            // call the destructors on the old elements
-            for (Size i = 0; i < m_count; ++i)
-            {
-                sourcePtr[i].~T();
-            }
+            auto blk = m_allocator->allocate(_s * sizeof(T), alignof(T));
+            STICK_ASSERT(blk);
+            relocate(reinterpret_cast<T *>(blk.ptr), reinterpret_cast<T *>(m_data.ptr), m_count);
 
             if (m_data)
                 m_allocator->deallocate(m_data);
@@ -180,6 +186,20 @@ class DynamicArray
         new (reinterpret_cast<T *>(m_data.ptr) + m_count++) T(std::move(_element));
     }
 
+    // constructs the new last element in place from _args
+    template <class... Args>
+    inline T & emplaceBack(Args &&... _args)
+    {
+        if (capacity() <= m_count)
+        {
+            // _args might refer to elements of this array
+            T tmp(std::forward<Args>(_args)...);
+            reserve(max((Size)1, m_count * 2));
+            return *new (reinterpret_cast<T *>(m_data.ptr) + m_count++) T(std::move(tmp));
+        }
+        return *new (reinterpret_cast<T *>(m_data.ptr) + m_count++) T(std::forward<Args>(_args)...);
+    }
+
     template <class InputIter>
     inline void append(InputIter _first, InputIter _last)
     {
@@ -199,13 +219,7 @@ class DynamicArray
             reserve(max(mc, m_count * 2));
         }
 
-        Size fidx = index + diff - 1;
-        Size iidx = fidx + idiff;
-        for (Size i = 0; i < diff; ++i)
-        {
-            new (reinterpret_cast<T *>(m_data.ptr) + iidx - i) T(std::move((*this)[fidx - i]));
-        }
-
+        openGap(index, diff, idiff);
         for (Size i = 0; _first != _last; ++_first, ++i)
         {
             new (reinterpret_cast<T *>(m_data.ptr) + index + i) T(*_first);
@@ -231,14 +245,35 @@ class DynamicArray
             reserve(max(mc, m_count * 2));
         }
 
-        Size fidx = index + diff - 1;
-        Size iidx = fidx + 1;
-        for (Size i = 0; i < diff; ++i)
+        openGap(index, diff, 1);
+        new (reinterpret_cast<T *>(m_data.ptr) + index) T(std::forward<T>(_val));
+
+        m_count++;
+        return begin() + index;
+    }
+
+    // Constructs the new element at _it in place from _args. If one of _args is a T, it might be
+    // an element of this array that opening the gap moves, so a temporary is constructed first.
+    template <class... Args>
+    inline Iter emplace(ConstIter _it, Args &&... _args)
+    {
+        if (_it == end())
         {
-            new (reinterpret_cast<T *>(m_data.ptr) + iidx - i) T(std::move((*this)[fidx - i]));
+            emplaceBack(std::forward<Args>(_args)...);
+            return end() - 1;
         }
+        if (IsSameAsAny<T, Args...>::value)
+            return insert(_it, T(std::forward<Args>(_args)...));
 
-        new (reinterpret_cast<T *>(m_data.ptr) + index) T(std::forward<T>(_val));
+        Size index = (_it - begin());
+        Size mc = m_count + 1;
+        if (capacity() < mc)
+        {
+            reserve(max(mc, m_count * 2));
+        }
+
+        openGap(index, m_count - index, 1);
+        new (reinterpret_cast<T *>(m_data.ptr) + index) T(std::forward<Args>(_args)...);
 
         m_count++;
         return begin() + index;
@@ -251,6 +286,21 @@ class DynamicArray
         Size index = (_first - begin());
         Size endIndex = m_count - diff;
 
+        if (IsTriviallyRelocatable<T>::value)
+        {
+            // destroy the removed elements and move the remaining ones down bitwise
+            for (Size i = index; i < endIndex; ++i)
+            {
+                (*this)[i].~T();
+            }
+            if (diff)
+            {
+                std::memmove(static_cast<void *>(ptr() + index), ptr() + endIndex, diff * sizeof(T));
+            }
+            m_count -= idiff;
+            return begin() + index;
+        }
+
         // fill the resulting gap if needed by shifting the remaining elements down
         if (diff)
         {
@@ -416,10 +466,52 @@ class DynamicArray
     }
 
   private:
+    // moves _count elements from _src to the uninitialized memory at _dst and destroys the
+    // originals, the two ranges must not overlap
+    inline static void relocate(T * _dst, T * _src, Size _count)
+    {
+        if (IsTriviallyRelocatable<T>::value)
+        {
+            if (_count)
+                std::memcpy(static_cast<void *>(_dst), _src, _count * sizeof(T));
+            return;
+        }
+
+        for (Size i = 0; i < _count; ++i)
+        {
+            new (_dst + i) T(std::move(_src[i]));
+            _src[i].~T();
+        }
+    }
+
+    // moves the _tail elements starting at _index _gap slots to the right, leaving uninitialized
+    // memory behind. The capacity has to be large enough.
+    inline void openGap(Size _index, Size _tail, Size _gap)
+    {
+        T * p = ptr();
+        if (IsTriviallyRelocatable<T>::value)
+        {
+            if (_tail)
+                std::memmove(static_cast<void *>(p + _index + _gap), p + _index, _tail * sizeof(T));
+            return;
+        }
+
+        for (Size i = _index + _tail; i > _index; --i)
+        {
+            new (p + i - 1 + _gap) T(std::move(p[i - 1]));
+            p[i - 1].~T();
+        }
+    }
+
     mem::Block m_data;
     Size m_count;
     Allocator * m_allocator;
 };
+
+template <class T>
+struct IsTriviallyRelocatable<DynamicArray<T>> : std::true_type
+{
+};
 } // namespace stick
 
 #endif // STICK_DYNAMICARRAY_HPP
@@ -116,6 +116,11 @@ const String & DirectoryEntry::path() const
     return m_path;
 }
 
+StringView DirectoryEntry::fileName() const
+{
+    return path::fileNameView(m_path);
+}
+
 const FileStatus & DirectoryEntry::status() const
 {
     return m_status;
@@ -184,18 +189,17 @@ DirectoryIterator & DirectoryIterator::increment()
     STICK_ASSERT(m_dir);
     errno = 0;
     struct dirent * de = nullptr;
-    String tmp;
     de = readdir(m_dir);
     if (de)
     {
-        tmp = String(de->d_name);
+        StringView name(de->d_name);
         // skip these
-        if (tmp == "." || tmp == "..")
+        if (name == "." || name == "..")
         {
             return increment();
         }
 
-        m_currentEntry = DirectoryEntry(path::join(m_path, tmp));
+        m_currentEntry = DirectoryEntry(path::join(m_path, String(name)));
     }
     else
     {
@@ -356,11 +360,13 @@ RecursiveDirectoryIterator & RecursiveDirectoryIterator::operator++()
 
 Error createDirectories(const String & _path)
 {
-    auto segs = path::segments(_path);
+    // creates the directories for all the leading portions of the path, i.e. a, a/b and a/b/c
     String tmp;
-    for (auto & seg : segs)
+    tmp.reserve(_path.length());
+    for (StringView seg : StringView(_path).split('/', true))
     {
-        tmp = path::join(tmp, seg);
+        tmp.clear();
+        tmp.append(_path.begin(), seg.end());
         auto err = createDirectory(tmp);
         if (err)
             return err;
@@ -143,6 +143,11 @@ class STICK_API DirectoryEntry
      */
     const String & path() const;
 
+    /**
+     * @brief Returns the file name portion of the entry's path as a view into it.
+     */
+    StringView fileName() const;
+
     /**
      * @brief Returns the file status of the entry.
      */
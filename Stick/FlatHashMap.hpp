@@ -0,0 +1,716 @@
+#ifndef STICK_FLATHASHMAP_HPP
+#define STICK_FLATHASHMAP_HPP
+
+#include <Stick/Allocator.hpp>
+#include <Stick/Hash.hpp>
+#include <initializer_list>
+#include <new>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif // defined(__SSE2__)
+
+namespace stick
+{
+namespace detail
+{
+// Control bytes of a FlatHashMap slot. Full slots store the lower seven bits of the hash.
+enum FlatHashMapControl : Int8
+{
+    FlatHashMapEmpty = -128,
+    FlatHashMapDeleted = -2
+};
+
+// A group of control bytes that is probed at once. All functions return a bitmask with bit i
+// set for every matching control byte i.
+struct FlatHashMapGroup
+{
+    static constexpr Size width = 16;
+
+#if defined(__SSE2__)
+    inline FlatHashMapGroup(const Int8 * _ctrl) :
+        ctrl(_mm_loadu_si128(reinterpret_cast<const __m128i *>(_ctrl)))
+    {
+    }
+
+    inline UInt32 match(Int8 _h2) const
+    {
+        return static_cast<UInt32>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(_h2), ctrl)));
+    }
+
+    inline UInt32 matchEmpty() const
+    {
+        return match(FlatHashMapEmpty);
+    }
+
+    inline UInt32 matchEmptyOrDeleted() const
+    {
+        // both have the sign bit set, full slots don't
+        return static_cast<UInt32>(_mm_movemask_epi8(ctrl));
+    }
+
+    __m128i ctrl;
+#else
+    inline FlatHashMapGroup(const Int8 * _ctrl)
+    {
+        for (Size i = 0; i < width; ++i)
+            ctrl[i] = _ctrl[i];
+    }
+
+    inline UInt32 match(Int8 _h2) const
+    {
+        UInt32 ret = 0;
+        for (Size i = 0; i < width; ++i)
+            ret |= UInt32(ctrl[i] == _h2) << i;
+        return ret;
+    }
+
+    inline UInt32 matchEmpty() const
+    {
+        return match(FlatHashMapEmpty);
+    }
+
+    inline UInt32 matchEmptyOrDeleted() const
+    {
+        UInt32 ret = 0;
+        for (Size i = 0; i < width; ++i)
+            ret |= UInt32(ctrl[i] < 0) << i;
+        return ret;
+    }
+
+    Int8 ctrl[width];
+#endif // defined(__SSE2__)
+};
+} // namespace detail
+
+// Open addressing hash map that stores all key value pairs in one contiguous array.
+// Every slot has a control byte that is either empty, deleted or holds seven bits of the hash of
+// the key in the slot. Lookups compare a whole group of control bytes at once (using SSE2 if
+// available) and only touch the slots whose control byte matches. Has the same interface as
+// HashMap, but pointers and iterators are invalidated by inserting new keys.
+template <class K, class V, template <class> class H = DefaultHash>
+class FlatHashMap
+{
+  public:
+    typedef K KeyType;
+    typedef V ValueType;
+    typedef H<KeyType> Hash;
+
+    // selects the KeyValuePair constructor that forwards to the key and value constructors
+    struct EmplaceTag
+    {
+    };
+
+    struct KeyValuePair
+    {
+        KeyValuePair(const KeyType & _key, const ValueType & _value) : key(_key), value(_value)
+        {
+        }
+
+        KeyValuePair(KeyType && _key, ValueType && _value) :
+            key(std::move(_key)),
+            value(std::move(_value))
+        {
+        }
+
+        template <class KT, class... Args>
+        KeyValuePair(EmplaceTag, KT && _key, Args &&... _args) :
+            key(std::forward<KT>(_key)),
+            value(std::forward<Args>(_args)...)
+        {
+        }
+
+        KeyType key;
+        ValueType value;
+    };
+
+    template <class T>
+    struct IterT
+    {
+        typedef typename T::KeyValuePair ValueType;
+
+        typedef ValueType & ReferenceType;
+
+        typedef ValueType * PointerType;
+
+        IterT() : map(nullptr), index(0)
+        {
+        }
+
+        template <class B>
+        IterT(const IterT<B> & _other) : map(_other.map), index(_other.index)
+        {
+        }
+
+        IterT(T & _map, Size _index) : map(&_map), index(_index)
+        {
+        }
+
+        inline void increment()
+        {
+            if (!map)
+                return;
+
+            index = map->nextFull(index + 1);
+            if (index == map->m_capacity)
+                map = nullptr;
+        }
+
+        inline bool operator==(const IterT & _other) const
+        {
+            return map == _other.map && (!map || index == _other.index);
+        }
+
+        inline bool operator!=(const IterT & _other) const
+        {
+            return !(*this == _other);
+        }
+
+        inline IterT & operator++()
+        {
+            increment();
+            return *this;
+        }
+
+        inline IterT operator++(int)
+        {
+            IterT ret = *this;
+            increment();
+            return ret;
+        }
+
+        inline IterT & operator+=(Size _i)
+        {
+            for (Size i = 0; i < _i; ++i)
+                increment();
+            return *this;
+        }
+
+        inline IterT operator+(Size _i) const
+        {
+            IterT ret = *this;
+            ret += _i;
+            return ret;
+        }
+
+        inline ValueType & operator*() const
+        {
+            return map->m_slots[index];
+        }
+
+        inline ValueType * operator->() const
+        {
+            return &map->m_slots[index];
+        }
+
+        T * map;
+        Size index;
+    };
+
+    typedef IterT<FlatHashMap> Iter;
+    typedef IterT<const FlatHashMap> ConstIter;
+
+    struct InsertResult
+    {
+        Iter iterator;
+        bool inserted;
+    };
+
+    inline FlatHashMap(Size _initialBucketCount = 16, Allocator & _alloc = defaultAllocator()) :
+        m_alloc(&_alloc)
+    {
+        initialize(_initialBucketCount);
+    }
+
+    inline FlatHashMap(const FlatHashMap & _other) : m_alloc(_other.m_alloc)
+    {
+        initialize(_other.m_capacity);
+        for (const KeyValuePair & kv : _other)
+            insertUnique(kv.key, kv.value);
+    }
+
+    inline FlatHashMap(FlatHashMap && _other) :
+        m_alloc(_other.m_alloc),
+        m_memory(_other.m_memory),
+        m_ctrl(_other.m_ctrl),
+        m_slots(_other.m_slots),
+        m_capacity(_other.m_capacity),
+        m_count(_other.m_count),
+        m_growthLeft(_other.m_growthLeft)
+    {
+        _other.m_memory = mem::Block();
+        _other.m_ctrl = nullptr;
+        _other.m_slots = nullptr;
+        _other.m_capacity = 0;
+        _other.m_count = 0;
+        _other.m_growthLeft = 0;
+    }
+
+    inline FlatHashMap(std::initializer_list<KeyValuePair> _l,
+                       Allocator & _alloc = defaultAllocator()) :
+        m_alloc(&_alloc)
+    {
+        initialize(16);
+        insert(_l);
+    }
+
+    inline ~FlatHashMap()
+    {
+        deallocate();
+    }
+
+    inline FlatHashMap & operator=(const FlatHashMap & _other)
+    {
+        if (this == &_other)
+            return *this;
+
+        deallocate();
+        m_alloc = _other.m_alloc;
+        initialize(_other.m_capacity);
+        for (const KeyValuePair & kv : _other)
+            insertUnique(kv.key, kv.value);
+        return *this;
+    }
+
+    inline FlatHashMap & operator=(FlatHashMap && _other)
+    {
+        if (this == &_other)
+            return *this;
+
+        deallocate();
+        m_alloc = _other.m_alloc;
+        m_memory = _other.m_memory;
+        m_ctrl = _other.m_ctrl;
+        m_slots = _other.m_slots;
+        m_capacity = _other.m_capacity;
+        m_count = _other.m_count;
+        m_growthLeft = _other.m_growthLeft;
+
+        _other.m_memory = mem::Block();
+        _other.m_ctrl = nullptr;
+        _other.m_slots = nullptr;
+        _other.m_capacity = 0;
+        _other.m_count = 0;
+        _other.m_growthLeft = 0;
+        return *this;
+    }
+
+    inline FlatHashMap & operator=(std::initializer_list<KeyValuePair> _l)
+    {
+        clear();
+        insert(_l);
+        return *this;
+    }
+
+    inline InsertResult insert(const KeyType & _key, const ValueType & _value)
+    {
+        return insertImpl(_key, _value);
+    }
+
+    inline InsertResult insert(const KeyType & _key, ValueType && _value)
+    {
+        return insertImpl(_key, std::move(_value));
+    }
+
+    inline InsertResult insert(const KeyValuePair & _val)
+    {
+        return insertImpl(_val.key, _val.value);
+    }
+
+    inline InsertResult insert(KeyValuePair && _val)
+    {
+        return insertImpl(std::move(_val.key), std::move(_val.value));
+    }
+
+    // Constructs the value in place from _args if _key does not exist yet. Unlike insert, an
+    // existing value is left untouched.
+    template <class... Args>
+    inline InsertResult tryEmplace(const KeyType & _key, Args &&... _args)
+    {
+        return tryEmplaceImpl(_key, std::forward<Args>(_args)...);
+    }
+
+    template <class... Args>
+    inline InsertResult tryEmplace(KeyType && _key, Args &&... _args)
+    {
+        return tryEmplaceImpl(std::move(_key), std::forward<Args>(_args)...);
+    }
+
+    template <class InputIterT>
+    inline void insert(InputIterT _begin, InputIterT _end)
+    {
+        while (_begin != _end)
+        {
+            insert(*_begin);
+            ++_begin;
+        }
+    }
+
+    inline void insert(std::initializer_list<KeyValuePair> _l)
+    {
+        insert(_l.begin(), _l.end());
+    }
+
+    inline Iter find(const KeyType & _key)
+    {
+        Size idx = findIndex(_key, hashKey(_key));
+        return idx != m_capacity ? Iter(*this, idx) : end();
+    }
+
+    inline ConstIter find(const KeyType & _key) const
+    {
+        Size idx = findIndex(_key, hashKey(_key));
+        return idx != m_capacity ? ConstIter(*this, idx) : end();
+    }
+
+    // Lookup with a different key type (i.e. a StringView or c string for String keys) without
+    // converting it to KeyType. Only available if Hash is transparent.
+    template <class L,
+              class HT = Hash,
+              class Enable = typename std::enable_if<detail::IsTransparentHash<HT>::value>::type>
+    inline Iter find(const L & _key)
+    {
+        Size idx = findIndex(_key, hashKey(_key));
+        return idx != m_capacity ? Iter(*this, idx) : end();
+    }
+
+    template <class L,
+              class HT = Hash,
+              class Enable = typename std::enable_if<detail::IsTransparentHash<HT>::value>::type>
+    inline ConstIter find(const L & _key) const
+    {
+        Size idx = findIndex(_key, hashKey(_key));
+        return idx != m_capacity ? ConstIter(*this, idx) : end();
+    }
+
+    inline ValueType & operator[](const KeyType & _key)
+    {
+        return tryEmplaceImpl(_key).iterator->value;
+    }
+
+    inline Iter remove(const KeyType & _key)
+    {
+        auto it = find(_key);
+        return remove(it);
+    }
+
+    inline Iter remove(ConstIter _it)
+    {
+        if (!_it.map)
+            return Iter();
+
+        STICK_ASSERT(_it.map == this);
+        Size idx = _it.index;
+        m_slots[idx].~KeyValuePair();
+
+        // if the group still has an empty slot, no probe sequence ever continued past it and the
+        // slot can become empty again. Otherwise it has to be marked as deleted.
+        Size groupStart = idx & ~(detail::FlatHashMapGroup::width - 1);
+        if (detail::FlatHashMapGroup(m_ctrl + groupStart).matchEmpty())
+        {
+            m_ctrl[idx] = detail::FlatHashMapEmpty;
+            ++m_growthLeft;
+        }
+        else
+            m_ctrl[idx] = detail::FlatHashMapDeleted;
+        --m_count;
+
+        Iter ret(*this, idx);
+        ++ret;
+        return ret;
+    }
+
+    inline void clear()
+    {
+        for (Size i = 0; i < m_capacity; ++i)
+        {
+            if (isFull(m_ctrl[i]))
+                m_slots[i].~KeyValuePair();
+            m_ctrl[i] = detail::FlatHashMapEmpty;
+        }
+        m_count = 0;
+        m_growthLeft = maxLoad(m_capacity);
+    }
+
+    // Resizes the slot array to fit at least _bucketCount slots.
+    inline void rehash(Size _bucketCount)
+    {
+        Size cap = capacityFor(_bucketCount);
+        while (maxLoad(cap) < m_count)
+            cap *= 2;
+
+        mem::Block oldMemory = m_memory;
+        Int8 * oldCtrl = m_ctrl;
+        KeyValuePair * oldSlots = m_slots;
+        Size oldCapacity = m_capacity;
+
+        allocate(cap);
+        m_growthLeft -= m_count;
+        for (Size i = 0; i < oldCapacity; ++i)
+        {
+            if (isFull(oldCtrl[i]))
+            {
+                Size hash = hashKey(oldSlots[i].key);
+                Size idx = findInsertSlot(hash);
+                setControl(idx, hash);
+                new (m_slots + idx) KeyValuePair(std::move(oldSlots[i]));
+                oldSlots[i].~KeyValuePair();
+            }
+        }
+
+        if (oldMemory)
+            m_alloc->deallocate(oldMemory);
+    }
+
+    inline Size bucketCount() const
+    {
+        return m_capacity;
+    }
+
+    inline Size count() const
+    {
+        return m_count;
+    }
+
+    inline Float32 maxLoadFactor() const
+    {
+        return 7.0f / 8.0f;
+    }
+
+    inline Float32 loadFactor() const
+    {
+        return m_capacity ? (Float32)count() / (Float32)bucketCount() : 0.0f;
+    }
+
+    inline Iter begin()
+    {
+        Size idx = nextFull(0);
+        return idx != m_capacity ? Iter(*this, idx) : end();
+    }
+
+    inline ConstIter begin() const
+    {
+        Size idx = nextFull(0);
+        return idx != m_capacity ? ConstIter(*this, idx) : end();
+    }
+
+    inline Iter end()
+    {
+        return Iter();
+    }
+
+    inline ConstIter end() const
+    {
+        return ConstIter();
+    }
+
+    Allocator & allocator() const
+    {
+        return *m_alloc;
+    }
+
+  private:
+    static constexpr Size groupWidth = detail::FlatHashMapGroup::width;
+
+    inline static bool isFull(Int8 _ctrl)
+    {
+        return _ctrl >= 0;
+    }
+
+    // at most 7/8 of the slots are used before growing
+    inline static Size maxLoad(Size _capacity)
+    {
+        return _capacity - _capacity / 8;
+    }
+
+    inline static Size capacityFor(Size _count)
+    {
+        Size ret = groupWidth;
+        while (ret < _count)
+            ret *= 2;
+        return ret;
+    }
+
+    template <class L>
+    inline Size hashKey(const L & _key) const
+    {
+        // the DefaultHash family is well mixed, but custom hashes are not necessarily, so we mix
+        // them once more before splitting them into group index and control byte.
+        UInt64 h = static_cast<UInt64>(m_hasher(_key)) * 0x9E3779B97F4A7C15ULL;
+        return static_cast<Size>(h ^ (h >> 32));
+    }
+
+    inline static Int8 h2(Size _hash)
+    {
+        return static_cast<Int8>(_hash & 0x7F);
+    }
+
+    inline Size nextFull(Size _index) const
+    {
+        while (_index < m_capacity && !isFull(m_ctrl[_index]))
+            ++_index;
+        return _index;
+    }
+
+    inline void setControl(Size _index, Size _hash)
+    {
+        m_ctrl[_index] = h2(_hash);
+    }
+
+    // returns m_capacity if the key is not in the map
+    template <class L>
+    inline Size findIndex(const L & _key, Size _hash) const
+    {
+        if (!m_capacity)
+            return 0;
+
+        Size groupMask = m_capacity / groupWidth - 1;
+        Size group = (_hash >> 7) & groupMask;
+        Int8 tag = h2(_hash);
+        for (Size probe = 1;; ++probe)
+        {
+            const Int8 * ctrl = m_ctrl + group * groupWidth;
+            detail::FlatHashMapGroup g(ctrl);
+            UInt32 matches = g.match(tag);
+            while (matches)
+            {
+                Size idx = group * groupWidth + mem::countTrailingZeros(matches);
+                if (m_slots[idx].key == _key)
+                    return idx;
+                matches &= matches - 1;
+            }
+
+            if (g.matchEmpty() || probe > groupMask)
+                return m_capacity;
+
+            // triangular probing visits every group once
+            group = (group + probe) & groupMask;
+        }
+    }
+
+    // the first empty or deleted slot in the probe sequence of _hash
+    inline Size findInsertSlot(Size _hash) const
+    {
+        Size groupMask = m_capacity / groupWidth - 1;
+        Size group = (_hash >> 7) & groupMask;
+        for (Size probe = 1;; ++probe)
+        {
+            UInt32 free = detail::FlatHashMapGroup(m_ctrl + group * groupWidth).matchEmptyOrDeleted();
+            if (free)
+                return group * groupWidth + mem::countTrailingZeros(free);
+            STICK_ASSERT(probe <= groupMask);
+            group = (group + probe) & groupMask;
+        }
+    }
+
+    // finds a slot for a new key, growing the map if needed. The caller constructs the pair.
+    inline Size prepareInsert(Size _hash)
+    {
+        // moved from maps have no slots
+        if (!m_capacity)
+            allocate(groupWidth);
+
+        Size idx = findInsertSlot(_hash);
+        if (!m_growthLeft && m_ctrl[idx] != detail::FlatHashMapDeleted)
+        {
+            // get rid of the tombstones if they make up a good part of the map, grow otherwise
+            rehash(m_count <= m_capacity * 25 / 32 ? m_capacity : m_capacity * 2);
+            idx = findInsertSlot(_hash);
+        }
+
+        if (m_ctrl[idx] == detail::FlatHashMapEmpty)
+            --m_growthLeft;
+        setControl(idx, _hash);
+        ++m_count;
+        return idx;
+    }
+
+    // for copies, the key is known to not be in the map yet
+    template <class KT, class VT>
+    inline InsertResult insertImpl(KT && _key, VT && _value)
+    {
+        Size hash = hashKey(_key);
+        Size idx = findIndex(_key, hash);
+
+        // the key allready exists, change the value
+        if (idx != m_capacity)
+        {
+            m_slots[idx].value = std::forward<VT>(_value);
+            return { Iter(*this, idx), false };
+        }
+
+        idx = prepareInsert(hash);
+        new (m_slots + idx)
+            KeyValuePair(EmplaceTag(), std::forward<KT>(_key), std::forward<VT>(_value));
+        return { Iter(*this, idx), true };
+    }
+
+    template <class KT, class... Args>
+    inline InsertResult tryEmplaceImpl(KT && _key, Args &&... _args)
+    {
+        Size hash = hashKey(_key);
+        Size idx = findIndex(_key, hash);
+        if (idx != m_capacity)
+            return { Iter(*this, idx), false };
+
+        idx = prepareInsert(hash);
+        new (m_slots + idx)
+            KeyValuePair(EmplaceTag(), std::forward<KT>(_key), std::forward<Args>(_args)...);
+        return { Iter(*this, idx), true };
+    }
+
+    inline void insertUnique(const KeyType & _key, const ValueType & _value)
+    {
+        Size idx = prepareInsert(hashKey(_key));
+        new (m_slots + idx) KeyValuePair(_key, _value);
+    }
+
+    inline void initialize(Size _bucketCount)
+    {
+        m_memory = mem::Block();
+        m_count = 0;
+        allocate(capacityFor(_bucketCount));
+    }
+
+    // allocates the control bytes followed by the slots and resets the control bytes
+    inline void allocate(Size _capacity)
+    {
+        Size slotOffset = mem::roundToAlignment(_capacity, alignof(KeyValuePair));
+        m_memory = m_alloc->allocate(slotOffset + _capacity * sizeof(KeyValuePair),
+                                     alignof(KeyValuePair) > 16 ? alignof(KeyValuePair) : 16);
+        STICK_ASSERT(m_memory);
+        m_ctrl = static_cast<Int8 *>(m_memory.ptr);
+        m_slots = reinterpret_cast<KeyValuePair *>(static_cast<char *>(m_memory.ptr) + slotOffset);
+        m_capacity = _capacity;
+        m_growthLeft = maxLoad(_capacity);
+        std::memset(m_ctrl, detail::FlatHashMapEmpty, _capacity);
+    }
+
+    inline void deallocate()
+    {
+        if (m_memory)
+        {
+            clear();
+            m_alloc->deallocate(m_memory);
+            m_memory = mem::Block();
+        }
+        m_ctrl = nullptr;
+        m_slots = nullptr;
+        m_capacity = 0;
+        m_count = 0;
+        m_growthLeft = 0;
+    }
+
+    Allocator * m_alloc;
+    mem::Block m_memory;
+    Int8 * m_ctrl;
+    KeyValuePair * m_slots;
+    Size m_capacity;
+    Size m_count;
+    // number of empty slots that can be used before the map has to grow
+    Size m_growthLeft;
+    Hash m_hasher;
+};
+} // namespace stick
+
+#endif // STICK_FLATHASHMAP_HPP
@@ -0,0 +1,411 @@
+#ifndef STICK_FLATMAP_HPP
+#define STICK_FLATMAP_HPP
+
+#include <Stick/DynamicArray.hpp>
+#include <algorithm>
+#include <utility>
+
+namespace stick
+{
+// Ordered map that keeps its key value pairs sorted by key in one contiguous DynamicArray. There
+// are no per node allocations, which makes it a good fit for small dictionaries that are read a lot
+// more often than they are modified. Inserting or removing a single key is linear in the number of
+// pairs, use the range insert to add many pairs at once.
+// Has the same interface as Map. Inserting or removing keys invalidates all iterators.
+template <class K, class V>
+class FlatMap
+{
+  public:
+    typedef K KeyType;
+    typedef V ValueType;
+
+    // selects the KeyValuePair constructor that forwards to the key and value constructors
+    struct EmplaceTag
+    {
+    };
+
+    struct KeyValuePair
+    {
+        KeyValuePair(const KeyType & _key, const ValueType & _value) : key(_key), value(_value)
+        {
+        }
+
+        KeyValuePair(KeyType && _key, ValueType && _value) :
+            key(std::move(_key)),
+            value(std::move(_value))
+        {
+        }
+
+        template <class KT, class... Args>
+        KeyValuePair(EmplaceTag, KT && _key, Args &&... _args) :
+            key(std::forward<KT>(_key)),
+            value(std::forward<Args>(_args)...)
+        {
+        }
+
+        KeyType key;
+        ValueType value;
+    };
+
+    typedef DynamicArray<KeyValuePair> Storage;
+    typedef typename Storage::Iter Iter;
+    typedef typename Storage::ConstIter ConstIter;
+    typedef typename Storage::ReverseIter ReverseIter;
+    typedef typename Storage::ReverseConstIter ReverseConstIter;
+
+    struct InsertResult
+    {
+        Iter iterator;
+        bool inserted;
+    };
+
+    FlatMap(Allocator & _alloc = defaultAllocator()) : m_data(_alloc)
+    {
+    }
+
+    FlatMap(std::initializer_list<KeyValuePair> _l, Allocator & _alloc = defaultAllocator()) :
+        m_data(_alloc)
+    {
+        insert(_l);
+    }
+
+    FlatMap(const FlatMap & _other) = default;
+    FlatMap(FlatMap && _other) = default;
+
+    inline FlatMap & operator=(const FlatMap & _other) = default;
+    inline FlatMap & operator=(FlatMap && _other) = default;
+
+    inline FlatMap & operator=(std::initializer_list<KeyValuePair> _l)
+    {
+        clear();
+        insert(_l);
+        return *this;
+    }
+
+    inline InsertResult insert(const KeyValuePair & _val)
+    {
+        return insertImpl(_val.key, _val.value);
+    }
+
+    inline InsertResult insert(KeyValuePair && _val)
+    {
+        return insertImpl(std::move(_val.key), std::move(_val.value));
+    }
+
+    inline InsertResult insert(const KeyType & _key, const ValueType & _val)
+    {
+        return insertImpl(_key, _val);
+    }
+
+    inline InsertResult insert(const KeyType & _key, ValueType && _val)
+    {
+        return insertImpl(_key, std::move(_val));
+    }
+
+    // Constructs the value in place from _args if _key does not exist yet. Unlike insert, an
+    // existing value is left untouched.
+    template <class... Args>
+    inline InsertResult tryEmplace(const KeyType & _key, Args &&... _args)
+    {
+        return tryEmplaceImpl(_key, std::forward<Args>(_args)...);
+    }
+
+    template <class... Args>
+    inline InsertResult tryEmplace(KeyType && _key, Args &&... _args)
+    {
+        return tryEmplaceImpl(std::move(_key), std::forward<Args>(_args)...);
+    }
+
+    // Appends all pairs of the range, sorts them and merges them with the existing ones in one
+    // go. Values of keys that exist already are replaced. If the range contains the same key more
+    // than once, it is unspecified which of its values ends up in the map.
+    template <class InputIterT>
+    inline void insert(InputIterT _begin, InputIterT _end)
+    {
+        Size oldCount = m_data.count();
+        for (; _begin != _end; ++_begin)
+            m_data.append(KeyValuePair{ (*_begin).key, (*_begin).value });
+        mergeTail(oldCount);
+    }
+
+    inline void insert(std::initializer_list<KeyValuePair> _l)
+    {
+        insert(_l.begin(), _l.end());
+    }
+
+    inline ValueType & operator[](const KeyType & _key)
+    {
+        return tryEmplace(_key).iterator->value;
+    }
+
+    inline Iter find(const KeyType & _key)
+    {
+        return begin() + findIndex(_key);
+    }
+
+    inline ConstIter find(const KeyType & _key) const
+    {
+        return begin() + findIndex(_key);
+    }
+
+    // Lookup with a different key type (i.e. a StringView or c string for String keys) without
+    // converting it to KeyType. Only available if KeyType can be compared with L.
+    template <class L,
+              class Enable = decltype(std::declval<const KeyType &>() == std::declval<const L &>() &&
+                                      std::declval<const KeyType &>() > std::declval<const L &>())>
+    inline Iter find(const L & _key)
+    {
+        return begin() + findIndex(_key);
+    }
+
+    template <class L,
+              class Enable = decltype(std::declval<const KeyType &>() == std::declval<const L &>() &&
+                                      std::declval<const KeyType &>() > std::declval<const L &>())>
+    inline ConstIter find(const L & _key) const
+    {
+        return begin() + findIndex(_key);
+    }
+
+    // the first pair whose key is not less than _key
+    template <class L>
+    inline Iter lowerBound(const L & _key)
+    {
+        return begin() + lowerBoundIndex(_key);
+    }
+
+    template <class L>
+    inline ConstIter lowerBound(const L & _key) const
+    {
+        return begin() + lowerBoundIndex(_key);
+    }
+
+    // the first pair whose key is greater than _key
+    template <class L>
+    inline Iter upperBound(const L & _key)
+    {
+        return begin() + upperBoundIndex(_key);
+    }
+
+    template <class L>
+    inline ConstIter upperBound(const L & _key) const
+    {
+        return begin() + upperBoundIndex(_key);
+    }
+
+    inline Iter remove(Iter _it)
+    {
+        if (_it == end())
+            return end();
+        return m_data.remove(_it);
+    }
+
+    inline Iter remove(const KeyType & _key)
+    {
+        return remove(find(_key));
+    }
+
+    inline void reserve(Size _count)
+    {
+        m_data.reserve(_count);
+    }
+
+    inline Size capacity() const
+    {
+        return m_data.capacity();
+    }
+
+    inline Iter begin()
+    {
+        return m_data.begin();
+    }
+
+    inline ConstIter begin() const
+    {
+        return m_data.begin();
+    }
+
+    inline ReverseIter rbegin()
+    {
+        return m_data.rbegin();
+    }
+
+    inline ReverseConstIter rbegin() const
+    {
+        return m_data.rbegin();
+    }
+
+    inline Iter end()
+    {
+        return m_data.end();
+    }
+
+    inline ConstIter end() const
+    {
+        return m_data.end();
+    }
+
+    inline ReverseIter rend()
+    {
+        return m_data.rend();
+    }
+
+    inline ReverseConstIter rend() const
+    {
+        return m_data.rend();
+    }
+
+    inline Size count() const
+    {
+        return m_data.count();
+    }
+
+    inline void clear()
+    {
+        m_data.clear();
+    }
+
+    inline Allocator & allocator() const
+    {
+        return m_data.allocator();
+    }
+
+  private:
+    // The searches below halve the range without branching on the comparison, which the compiler
+    // turns into conditional moves. They only rely on the key's operator> and operator== (with the
+    // stored key on the left) just like Map.
+
+    // the index of the first pair whose key is greater than _key
+    template <class L>
+    inline Size upperBoundIndex(const L & _key) const
+    {
+        Size n = m_data.count();
+        if (!n)
+            return 0;
+
+        const KeyValuePair * base = m_data.ptr();
+        while (n > 1)
+        {
+            Size half = n / 2;
+            base = base[half].key > _key ? base : base + half;
+            n -= half;
+        }
+        return (base - m_data.ptr()) + (base->key > _key ? 0 : 1);
+    }
+
+    // the index of the first pair whose key is not less than _key
+    template <class L>
+    inline Size lowerBoundIndex(const L & _key) const
+    {
+        Size n = m_data.count();
+        if (!n)
+            return 0;
+
+        const KeyValuePair * base = m_data.ptr();
+        while (n > 1)
+        {
+            Size half = n / 2;
+            const KeyType & k = base[half].key;
+            base = (k > _key || k == _key) ? base : base + half;
+            n -= half;
+        }
+        return (base - m_data.ptr()) + ((base->key > _key || base->key == _key) ? 0 : 1);
+    }
+
+    // the index of _key or count() if it does not exist
+    template <class L>
+    inline Size findIndex(const L & _key) const
+    {
+        Size idx = upperBoundIndex(_key);
+        if (idx && m_data[idx - 1].key == _key)
+            return idx - 1;
+        return m_data.count();
+    }
+
+    template <class KT, class VT>
+    inline InsertResult insertImpl(KT && _key, VT && _value)
+    {
+        // _value is only consumed if the key was inserted
+        InsertResult ret = tryEmplaceImpl(std::forward<KT>(_key), std::forward<VT>(_value));
+
+        // the key allready exists, change the value
+        if (!ret.inserted)
+            ret.iterator->value = std::forward<VT>(_value);
+        return ret;
+    }
+
+    template <class KT, class... Args>
+    inline InsertResult tryEmplaceImpl(KT && _key, Args &&... _args)
+    {
+        Size idx = upperBoundIndex(_key);
+        if (idx && m_data[idx - 1].key == _key)
+            return { begin() + idx - 1, false };
+
+        // the pair is constructed before opening the gap, _args might reference one of the pairs
+        KeyValuePair kv(EmplaceTag(), std::forward<KT>(_key), std::forward<Args>(_args)...);
+        return { m_data.insert(m_data.begin() + idx, std::move(kv)), true };
+    }
+
+    // sorts the unsorted pairs starting at _from and merges them into the sorted ones before
+    inline void mergeTail(Size _from)
+    {
+        Size n = m_data.count();
+        if (_from == n)
+            return;
+
+        std::sort(m_data.begin() + _from, m_data.end(),
+                  [](const KeyValuePair & _a, const KeyValuePair & _b) { return _b.key > _a.key; });
+
+        // the pairs only had to be appended
+        if (!_from || m_data[_from].key > m_data[_from - 1].key)
+        {
+            removeDuplicates(_from);
+            return;
+        }
+
+        Storage merged(m_data.allocator());
+        merged.reserve(n);
+        Size i = 0, j = _from;
+        while (i < _from || j < n)
+        {
+            // skip all but the last of equal keys in the new pairs
+            if (j < n && j + 1 < n && m_data[j].key == m_data[j + 1].key)
+            {
+                ++j;
+                continue;
+            }
+
+            if (j == n || (i < _from && m_data[j].key > m_data[i].key))
+                merged.append(std::move(m_data[i++]));
+            else
+            {
+                // the new value replaces the existing one
+                if (i < _from && m_data[i].key == m_data[j].key)
+                    ++i;
+                merged.append(std::move(m_data[j++]));
+            }
+        }
+        m_data = std::move(merged);
+    }
+
+    // removes all but the last of equal keys in the sorted range starting at _from
+    inline void removeDuplicates(Size _from)
+    {
+        Size n = m_data.count();
+        Size w = _from;
+        for (Size r = _from; r < n; ++r)
+        {
+            if (r + 1 < n && m_data[r].key == m_data[r + 1].key)
+                continue;
+            if (w != r)
+                m_data[w] = std::move(m_data[r]);
+            ++w;
+        }
+        while (m_data.count() > w)
+            m_data.removeLast();
+    }
+
+    Storage m_data;
+};
+} // namespace stick
+
+#endif // STICK_FLATMAP_HPP
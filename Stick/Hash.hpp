@@ -1,26 +1,75 @@
 #ifndef STICK_HASH_HPP
 #define STICK_HASH_HPP
 
+#include <Stick/Platform.hpp>
+#include <Stick/Private/WyHash.hpp>
+#include <type_traits>
+
 namespace stick
 {
 template <class T>
 struct DefaultHash;
 
+namespace detail
+{
+template <class T>
+struct MakeVoid
+{
+    typedef void Type;
+};
+
+// A hash is transparent if it declares an IsTransparent type. Hash maps then accept lookups with
+// any key type the hash can be called with, i.e. a StringView or const char * for String keys.
+// The hash has to produce the same value for equal keys of the different types.
+template <class H, class Enable = void>
+struct IsTransparentHash : std::false_type
+{
+};
+
+template <class H>
+struct IsTransparentHash<H, typename MakeVoid<typename H::IsTransparent>::Type> : std::true_type
+{
+};
+} // namespace detail
+
+// Hashes _byteCount bytes starting at _data. Used for all string types, so that equal strings
+// hash the same no matter which type holds them.
+inline Size hashBytes(const void * _data, Size _byteCount, UInt64 _seed = 0)
+{
+    return static_cast<Size>(detail::wyhash(_data, _byteCount, _seed));
+}
+
+// Mixes all bits of _value into all bits of the result, so that aligned pointers or strided
+// integers still spread over the low bits used to pick a bucket.
+inline Size hashInteger(UInt64 _value)
+{
+    return static_cast<Size>(detail::wyhash64(_value));
+}
+
 template <>
 struct DefaultHash<Int32>
 {
     Size operator()(Int32 _i) const
     {
-        return _i;
+        return hashInteger(static_cast<UInt32>(_i));
     }
 };
 
 template <>
 struct DefaultHash<UInt32>
 {
-    Size operator()(Int32 _i) const
+    Size operator()(UInt32 _i) const
+    {
+        return hashInteger(_i);
+    }
+};
+
+template <>
+struct DefaultHash<Int64>
+{
+    Size operator()(Int64 _i) const
     {
-        return _i;
+        return hashInteger(static_cast<UInt64>(_i));
     }
 };
 
@@ -29,7 +78,7 @@ struct DefaultHash<Size>
 {
     Size operator()(Size _i) const
     {
-        return _i;
+        return hashInteger(_i);
     }
 };
 
@@ -38,7 +87,7 @@ struct DefaultHash<T *>
 {
     Size operator()(T * _i) const
     {
-        return reinterpret_cast<Size>(_i);
+        return hashInteger(reinterpret_cast<UPtr>(_i));
     }
 };
 } // namespace stick
@@ -3,12 +3,14 @@
 
 #include <Stick/Allocator.hpp>
 #include <Stick/Hash.hpp>
+#include <cmath>
 #include <initializer_list>
 
 namespace stick
 {
-//@TODO Possibly redesign this to not allocate every key value pair independently
-// as described here: http://www.ilikebigbits.com/blog/2016/8/28/designing-a-fast-hash-table
+// Chained hash map. Nodes are carved out of slabs that are allocated from the map's Allocator and
+// recycled through a free list once they are removed, so inserting and removing keys rarely hits
+// the allocator. See FlatHashMap for an open addressing alternative.
 template <class K, class V, template <class> class H = DefaultHash>
 class HashMap
 {
@@ -17,15 +19,44 @@ class HashMap
     typedef V ValueType;
     typedef H<KeyType> Hash;
 
+    // selects the KeyValuePair constructor that forwards to the key and value constructors
+    struct EmplaceTag
+    {
+    };
+
     struct KeyValuePair
     {
+        KeyValuePair(const KeyType & _key, const ValueType & _value) : key(_key), value(_value)
+        {
+        }
+
+        KeyValuePair(KeyType && _key, ValueType && _value) :
+            key(std::move(_key)),
+            value(std::move(_value))
+        {
+        }
+
+        template <class KT, class... Args>
+        KeyValuePair(EmplaceTag, KT && _key, Args &&... _args) :
+            key(std::forward<KT>(_key)),
+            value(std::forward<Args>(_args)...)
+        {
+        }
+
         KeyType key;
         ValueType value;
     };
 
     struct Node
     {
-        Node() : prev(nullptr), next(nullptr), bucketIndex(-1), id(-1)
+        // the value is constructed from _args
+        template <class KT, class... Args>
+        Node(Size _bucketIndex, Size _id, KT && _key, Args &&... _args) :
+            kv(EmplaceTag(), std::forward<KT>(_key), std::forward<Args>(_args)...),
+            prev(nullptr),
+            next(nullptr),
+            bucketIndex(_bucketIndex),
+            id(_id)
         {
         }
 
@@ -173,11 +204,16 @@ class HashMap
         m_bucketAllocationSize(0),
         m_maxLoadFactor(1.0f),
         m_count(0),
-        m_nextNodeID(0)
-    {
-        m_buckets = allocateBuckets(_initialBucketCount, &m_bucketAllocationSize);
+        m_nextNodeID(0),
+        m_slabs(nullptr),
+        m_slabPosition(nullptr),
+        m_slabEnd(nullptr),
+        m_freeNodes(nullptr),
+        m_freeNodeCount(0)
+    {
+        m_bucketCount = powerOfTwoBucketCount(_initialBucketCount);
+        m_buckets = allocateBuckets(m_bucketCount, &m_bucketAllocationSize);
         STICK_ASSERT(m_buckets);
-        m_bucketCount = _initialBucketCount;
     }
 
     inline HashMap(const HashMap & _other) :
@@ -187,11 +223,17 @@ class HashMap
         m_bucketCount(0),
         m_maxLoadFactor(_other.m_maxLoadFactor),
         m_count(_other.m_count),
-        m_nextNodeID(_other.m_nextNodeID)
+        m_nextNodeID(_other.m_nextNodeID),
+        m_slabs(nullptr),
+        m_slabPosition(nullptr),
+        m_slabEnd(nullptr),
+        m_freeNodes(nullptr),
+        m_freeNodeCount(0)
     {
         m_buckets = allocateBuckets(_other.m_bucketCount, &m_bucketAllocationSize);
         STICK_ASSERT(m_buckets);
         m_bucketCount = _other.m_bucketCount;
+        reserveNodes(_other.m_count);
         // iterate over all the buckets and copy each linked list
         for (Size i = 0; i < _other.m_bucketCount; ++i)
         {
@@ -207,9 +249,17 @@ class HashMap
         m_bucketCount(std::move(_other.m_bucketCount)),
         m_maxLoadFactor(std::move(_other.m_maxLoadFactor)),
         m_count(std::move(_other.m_count)),
-        m_nextNodeID(std::move(_other.m_nextNodeID))
+        m_nextNodeID(std::move(_other.m_nextNodeID)),
+        m_slabs(_other.m_slabs),
+        m_slabPosition(_other.m_slabPosition),
+        m_slabEnd(_other.m_slabEnd),
+        m_freeNodes(_other.m_freeNodes),
+        m_freeNodeCount(_other.m_freeNodeCount)
     {
         _other.m_buckets = nullptr;
+        _other.m_bucketCount = 0;
+        _other.m_count = 0;
+        _other.releaseSlabOwnership();
     }
 
     inline HashMap(std::initializer_list<KeyValuePair> _l,
@@ -220,7 +270,12 @@ class HashMap
         m_bucketCount(0),
         m_maxLoadFactor(1.0f),
         m_count(0),
-        m_nextNodeID(0)
+        m_nextNodeID(0),
+        m_slabs(nullptr),
+        m_slabPosition(nullptr),
+        m_slabEnd(nullptr),
+        m_freeNodes(nullptr),
+        m_freeNodeCount(0)
     {
         m_buckets = allocateBuckets(16, &m_bucketAllocationSize);
         m_bucketCount = 16;
@@ -242,13 +297,20 @@ class HashMap
 
             m_alloc->deallocate({ m_buckets, m_bucketAllocationSize });
         }
+        deallocateSlabs();
     }
 
     inline HashMap & operator=(const HashMap & _other)
     {
+        if (this == &_other)
+            return *this;
+
         clear();
         if (m_buckets)
             m_alloc->deallocate({ m_buckets, m_bucketAllocationSize });
+        // the recycled nodes can only be kept if they come from the same allocator
+        if (m_alloc != _other.m_alloc)
+            deallocateSlabs();
 
         m_alloc = _other.m_alloc;
         m_bucketCount = _other.m_bucketCount;
@@ -257,6 +319,7 @@ class HashMap
         m_maxLoadFactor = _other.m_maxLoadFactor;
         m_buckets = allocateBuckets(m_bucketCount, &m_bucketAllocationSize);
         STICK_ASSERT(m_buckets);
+        reserveNodes(m_count);
         for (Size i = 0; i < _other.m_bucketCount; ++i)
         {
             if (_other.m_buckets[i].first)
@@ -267,9 +330,13 @@ class HashMap
 
     inline HashMap & operator=(HashMap && _other)
     {
+        if (this == &_other)
+            return *this;
+
         clear();
         if (m_buckets)
             m_alloc->deallocate({ m_buckets, m_bucketAllocationSize });
+        deallocateSlabs();
 
         m_alloc = std::move(_other.m_alloc);
         m_bucketCount = std::move(_other.m_bucketCount);
@@ -277,8 +344,16 @@ class HashMap
         m_maxLoadFactor = std::move(_other.m_maxLoadFactor);
         m_buckets = std::move(_other.m_buckets);
         m_bucketAllocationSize = std::move(_other.m_bucketAllocationSize);
+        m_slabs = _other.m_slabs;
+        m_slabPosition = _other.m_slabPosition;
+        m_slabEnd = _other.m_slabEnd;
+        m_freeNodes = _other.m_freeNodes;
+        m_freeNodeCount = _other.m_freeNodeCount;
 
         _other.m_buckets = nullptr;
+        _other.m_bucketCount = 0;
+        _other.m_count = 0;
+        _other.releaseSlabOwnership();
 
         return *this;
     }
@@ -292,96 +367,48 @@ class HashMap
 
     inline InsertResult insert(const KeyType & _key, const ValueType & _value)
     {
-        return insert((KeyValuePair){ _key, _value });
+        return insertImpl(_key, _value);
     }
 
     inline InsertResult insert(const KeyType & _key, ValueType && _value)
     {
-        return insert((KeyValuePair){ _key, std::move(_value) });
+        return insertImpl(_key, std::move(_value));
     }
 
     inline InsertResult insert(const KeyValuePair & _val)
     {
-        Size bi = bucketIndex(_val.key);
-        Bucket & b = m_buckets[bi];
-
-        // check if the key allready exists
-        Node *n, *prev;
-        findHelper(bi, _val.key, n, prev);
-
-        // the key allready exists, change the value
-        if (n)
-        {
-            n->kv.value = _val.value;
-            return { Iter(*this, bi, n), false };
-        }
-        else
-        {
-            // otherwise create the node n stuff
-            n = createNode({ _val.key, _val.value }, bi);
-            if (prev)
-            {
-                n->prev = prev;
-                prev->next = n;
-            }
-            else
-                b.first = n;
-            ++m_count;
-        }
-
-        Float32 lf = loadFactor();
-        if (lf > m_maxLoadFactor)
-        {
-            rehash(m_bucketCount * 2);
-        }
-
-        return { Iter(*this, bi, n), true };
+        return insertImpl(_val.key, _val.value);
     }
 
     inline InsertResult insert(KeyValuePair && _val)
     {
-        Size bi = bucketIndex(_val.key);
-        Bucket & b = m_buckets[bi];
-
-        // check if the key allready exists
-        Node *n, *prev;
-        findHelper(bi, _val.key, n, prev);
-
-        // the key allready exists, change the value
-        if (n)
-        {
-            STICK_ASSERT(prev == n->prev);
-            n->kv.value = std::move(_val.value);
-            return { Iter(*this, bi, n), false };
-        }
-        else
-        {
-            // otherwise create the node n stuff
-            n = createNode({ _val.key, std::move(_val.value) }, bi);
-            if (prev)
-            {
-                n->prev = prev;
-                prev->next = n;
-            }
-            else
-            {
-                b.first = n;
-            }
-            ++m_count;
-        }
+        return insertImpl(std::move(_val.key), std::move(_val.value));
+    }
 
-        Float32 lf = loadFactor();
-        if (lf > m_maxLoadFactor)
-        {
-            rehash(m_bucketCount * 2);
-        }
+    // Constructs the value in place from _args if _key does not exist yet. Unlike insert, an
+    // existing value is left untouched.
+    template <class... Args>
+    inline InsertResult tryEmplace(const KeyType & _key, Args &&... _args)
+    {
+        return tryEmplaceImpl(_key, std::forward<Args>(_args)...);
+    }
 
-        return { Iter(*this, bi, n), true };
+    template <class... Args>
+    inline InsertResult tryEmplace(KeyType && _key, Args &&... _args)
+    {
+        return tryEmplaceImpl(std::move(_key), std::forward<Args>(_args)...);
     }
 
+    // Makes room for all elements up front, so the map rehashes at most once. The range is
+    // traversed twice, InputIterT has to be multi pass (all stick iterators are).
     template <class InputIterT>
     inline void insert(InputIterT _begin, InputIterT _end)
     {
+        Size n = 0;
+        for (InputIterT it = _begin; it != _end; ++it)
+            ++n;
+        reserve(m_count + n);
+
         while (_begin != _end)
         {
             insert(*_begin);
@@ -404,6 +431,24 @@ class HashMap
         return HashMap::findByKey<ConstIter>(*this, _key);
     }
 
+    // Lookup with a different key type (i.e. a StringView or c string for String keys) without
+    // converting it to KeyType. Only available if Hash is transparent.
+    template <class L,
+              class HT = Hash,
+              class Enable = typename std::enable_if<detail::IsTransparentHash<HT>::value>::type>
+    inline Iter find(const L & _key)
+    {
+        return HashMap::findByKey<Iter>(*this, _key);
+    }
+
+    template <class L,
+              class HT = Hash,
+              class Enable = typename std::enable_if<detail::IsTransparentHash<HT>::value>::type>
+    inline ConstIter find(const L & _key) const
+    {
+        return HashMap::findByKey<ConstIter>(*this, _key);
+    }
+
     // inline Iter find(const Handle & _handle)
     // {
     //     return HashMap::findByHandle<Iter>(*this, _handle);
@@ -424,8 +469,7 @@ class HashMap
         }
         else
         {
-            auto res = insert(_key, ValueType());
-            return res.iterator->value;
+            return tryEmplaceImpl(_key).iterator->value;
         }
     }
 
@@ -488,8 +532,21 @@ class HashMap
         m_count = 0;
     }
 
+    // Sizes the buckets and the node storage so that _count elements fit without rehashing or
+    // allocating.
+    inline void reserve(Size _count)
+    {
+        Size bc = static_cast<Size>(std::ceil(static_cast<Float32>(_count) / m_maxLoadFactor));
+        if (bc > m_bucketCount)
+            rehash(bc);
+        if (_count > m_count)
+            reserveNodes(_count - m_count);
+    }
+
+    // _bucketCount is rounded up to the next power of two
     inline void rehash(Size _bucketCount)
     {
+        _bucketCount = powerOfTwoBucketCount(_bucketCount);
         Size newBucketAllocationSize = 0;
         Bucket * newBuckets = allocateBuckets(_bucketCount, &newBucketAllocationSize);
 
@@ -500,22 +557,16 @@ class HashMap
 
             while (n)
             {
-                Size bucketIndex = m_hasher(n->kv.key) % _bucketCount;
+                Size bucketIndex = m_hasher(n->kv.key) & (_bucketCount - 1);
                 Node * nextn = n->next;
-                if (!newBuckets[bucketIndex].first)
-                {
-                    newBuckets[bucketIndex].first = n;
-                    n->prev = nullptr;
-                }
-                else
-                {
-                    Node * n2 = newBuckets[bucketIndex].first;
-                    while (n2->next)
-                        n2 = n2->next;
-                    n2->next = n;
-                    n->prev = n2;
-                }
-                n->next = nullptr;
+                // the order within a bucket does not matter, so we simply prepend
+                Node * first = newBuckets[bucketIndex].first;
+                n->prev = nullptr;
+                n->next = first;
+                if (first)
+                    first->prev = n;
+                newBuckets[bucketIndex].first = n;
+                n->bucketIndex = bucketIndex;
                 n = nextn;
             }
 
@@ -568,7 +619,7 @@ class HashMap
 
     inline ConstIter begin() const
     {
-        Bucket * b;
+        Bucket * b = nullptr;
         Size i = 0;
         for (; i < m_bucketCount; ++i)
         {
@@ -599,28 +650,174 @@ class HashMap
         return *m_alloc;
     }
 
-    inline Size bucketIndex(const KeyType & _key) const
+    template <class L>
+    inline Size bucketIndex(const L & _key) const
     {
-        return m_hasher(_key) % bucketCount();
+        // the bucket count is a power of two, which relies on the hash mixing its low bits well
+        return m_hasher(_key) & (m_bucketCount - 1);
+    }
+
+    // number of nodes that can be created without allocating
+    inline Size nodeCapacity() const
+    {
+        return m_freeNodeCount + static_cast<Size>(m_slabEnd - m_slabPosition);
     }
 
   private:
-    inline Node * createNode(KeyValuePair && _pair, Size _bucketIndex)
+    // header of a chunk of node storage, the nodes follow it
+    struct NodeSlab
     {
-        auto ret = m_alloc->create<Node>();
-        ret->bucketIndex = _bucketIndex;
-        ret->id = m_nextNodeID++;
-        ret->kv = std::move(_pair);
-        return ret;
+        NodeSlab * next;
+        Size byteCount;
+    };
+
+    // removed nodes are linked through their (destroyed) storage
+    struct FreeNode
+    {
+        FreeNode * next;
+    };
+
+    static constexpr Size slabHeaderSize =
+        (sizeof(NodeSlab) + alignof(Node) - 1) / alignof(Node) * alignof(Node);
+
+    static constexpr Size minSlabNodeCount = 16;
+
+    template <class KT, class... Args>
+    inline Node * createNode(Size _bucketIndex, KT && _key, Args &&... _args)
+    {
+        void * mem;
+        if (m_freeNodes)
+        {
+            mem = m_freeNodes;
+            m_freeNodes = m_freeNodes->next;
+            --m_freeNodeCount;
+        }
+        else
+        {
+            // grow geometrically with the number of elements
+            if (m_slabPosition == m_slabEnd)
+                allocateSlab(m_count > minSlabNodeCount ? m_count : minSlabNodeCount);
+            mem = m_slabPosition++;
+        }
+
+        return new (mem)
+            Node(_bucketIndex, m_nextNodeID++, std::forward<KT>(_key), std::forward<Args>(_args)...);
+    }
+
+    template <class KT, class VT>
+    inline InsertResult insertImpl(KT && _key, VT && _value)
+    {
+        Size bi = bucketIndex(_key);
+        Node *n, *prev;
+        findHelper(bi, _key, n, prev);
+
+        // the key allready exists, change the value
+        if (n)
+        {
+            n->kv.value = std::forward<VT>(_value);
+            return { Iter(*this, bi, n), false };
+        }
+
+        return { linkNode(createNode(bi, std::forward<KT>(_key), std::forward<VT>(_value)), prev),
+                 true };
+    }
+
+    template <class KT, class... Args>
+    inline InsertResult tryEmplaceImpl(KT && _key, Args &&... _args)
+    {
+        Size bi = bucketIndex(_key);
+        Node *n, *prev;
+        findHelper(bi, _key, n, prev);
+        if (n)
+            return { Iter(*this, bi, n), false };
+
+        return {
+            linkNode(createNode(bi, std::forward<KT>(_key), std::forward<Args>(_args)...), prev), true
+        };
+    }
+
+    // appends a new node after _prev (or as the first node of its bucket) and grows the map if
+    // needed
+    inline Iter linkNode(Node * _n, Node * _prev)
+    {
+        if (_prev)
+        {
+            _n->prev = _prev;
+            _prev->next = _n;
+        }
+        else
+            m_buckets[_n->bucketIndex].first = _n;
+        ++m_count;
+
+        if (loadFactor() > m_maxLoadFactor)
+            rehash(m_bucketCount * 2);
+
+        // rehashing might have moved the node to a different bucket
+        return Iter(*this, _n->bucketIndex, _n);
     }
 
     inline void destroyNode(Node * _n)
     {
-        m_alloc->destroy(_n);
+        _n->~Node();
+        recycleNode(_n);
+    }
+
+    inline void recycleNode(void * _mem)
+    {
+        FreeNode * fn = static_cast<FreeNode *>(_mem);
+        fn->next = m_freeNodes;
+        m_freeNodes = fn;
+        ++m_freeNodeCount;
+    }
+
+    inline void reserveNodes(Size _count)
+    {
+        Size available = nodeCapacity();
+        if (_count > available)
+            allocateSlab(_count - available);
+    }
+
+    inline void allocateSlab(Size _nodeCount)
+    {
+        // whatever is left in the current slab is recycled through the free list
+        while (m_slabPosition != m_slabEnd)
+            recycleNode(m_slabPosition++);
+
+        Size byteCount = slabHeaderSize + _nodeCount * sizeof(Node);
+        auto mem = m_alloc->allocate(byteCount, alignof(Node) > alignof(NodeSlab) ? alignof(Node)
+                                                                                  : alignof(NodeSlab));
+        STICK_ASSERT(mem);
+        NodeSlab * slab = new (mem.ptr) NodeSlab{ m_slabs, mem.size };
+        m_slabs = slab;
+        m_slabPosition = reinterpret_cast<Node *>(reinterpret_cast<UPtr>(mem.ptr) + slabHeaderSize);
+        m_slabEnd = m_slabPosition + _nodeCount;
+    }
+
+    // all nodes have to be destroyed already
+    inline void deallocateSlabs()
+    {
+        NodeSlab * slab = m_slabs;
+        while (slab)
+        {
+            NodeSlab * next = slab->next;
+            m_alloc->deallocate({ slab, slab->byteCount });
+            slab = next;
+        }
+        releaseSlabOwnership();
+    }
+
+    inline void releaseSlabOwnership()
+    {
+        m_slabs = nullptr;
+        m_slabPosition = nullptr;
+        m_slabEnd = nullptr;
+        m_freeNodes = nullptr;
+        m_freeNodeCount = 0;
     }
 
+    template <class L>
     inline void findHelper(Size _bucketIdx,
-                           const KeyType & _key,
+                           const L & _key,
                            Node *& _outNode,
                            Node *& _prev) const
     {
@@ -631,7 +828,7 @@ class HashMap
 
         while (n)
         {
-            if (_key == n->kv.key)
+            if (n->kv.key == _key)
             {
                 _outNode = n;
                 STICK_ASSERT(n->prev == _prev);
@@ -678,8 +875,8 @@ class HashMap
     //     return _map.end();
     // }
 
-    template <class IterT, class MapType>
-    inline static IterT findByKey(MapType && _map, const KeyType & _key)
+    template <class IterT, class MapType, class L>
+    inline static IterT findByKey(MapType && _map, const L & _key)
     {
         Size bi = _map.bucketIndex(_key);
         Node *n, *prev;
@@ -690,6 +887,14 @@ class HashMap
             return IterT(std::forward<MapType>(_map), bi, n);
     }
 
+    inline static Size powerOfTwoBucketCount(Size _count)
+    {
+        Size ret = 1;
+        while (ret < _count)
+            ret *= 2;
+        return ret;
+    }
+
     inline Bucket * allocateBuckets(Size _i, Size * _outSize)
     {
         auto mem = m_alloc->allocate(sizeof(Bucket) * _i, alignof(Bucket));
@@ -700,7 +905,7 @@ class HashMap
     inline Node * copyNode(Node * _node)
     {
         STICK_ASSERT(_node);
-        Node * ret = createNode({ _node->kv.key, _node->kv.value }, _node->bucketIndex);
+        Node * ret = createNode(_node->bucketIndex, _node->kv.key, _node->kv.value);
         if (_node->next)
         {
             Node * next = copyNode(_node->next);
@@ -718,6 +923,11 @@ class HashMap
     Hash m_hasher;
     Size m_count;
     Size m_nextNodeID;
+    NodeSlab * m_slabs;
+    Node * m_slabPosition;
+    Node * m_slabEnd;
+    FreeNode * m_freeNodes;
+    Size m_freeNodeCount;
 };
 } // namespace stick
 
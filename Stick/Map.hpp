@@ -4,6 +4,7 @@
 #include <Stick/Iterator.hpp>
 #include <Stick/RBTree.hpp>
 #include <initializer_list>
+#include <utility>
 
 namespace stick
 {
@@ -14,12 +15,24 @@ class Map
     typedef K KeyType;
     typedef V ValueType;
 
+    // selects the KeyValuePair constructor that forwards to the key and value constructors
+    struct EmplaceTag
+    {
+    };
+
     struct KeyValuePair
     {
         KeyValuePair(const KeyType & _key, const ValueType & _value) : key(_key), value(_value)
         {
         }
 
+        template <class KT, class... Args>
+        KeyValuePair(EmplaceTag, KT && _key, Args &&... _args) :
+            key(std::forward<KT>(_key)),
+            value(std::forward<Args>(_args)...)
+        {
+        }
+
         // we only compare keys
         bool operator==(const KeyValuePair & _other) const
         {
@@ -61,6 +74,19 @@ class Map
             return key > _other;
         }
 
+        // for lookups with a different key type
+        template <class L>
+        bool operator==(const L & _other) const
+        {
+            return key == _other;
+        }
+
+        template <class L>
+        bool operator>(const L & _other) const
+        {
+            return key > _other;
+        }
+
         KeyType key;
         ValueType value;
     };
@@ -328,6 +354,12 @@ class Map
         return { Iter(res.node, m_tree.rightMost()), res.inserted };
     }
 
+    inline InsertResult insert(KeyValuePair && _val)
+    {
+        auto res = m_tree.insert(std::move(_val));
+        return { Iter(res.node, m_tree.rightMost()), res.inserted };
+    }
+
     template <class InputIterT>
     inline void insert(InputIterT _begin, InputIterT _end)
     {
@@ -350,21 +382,30 @@ class Map
 
     inline InsertResult insert(const KeyType & _key, ValueType && _val)
     {
-        return insert((KeyValuePair){ _key, std::move(_val) });
+        return insert(KeyValuePair(EmplaceTag(), _key, std::move(_val)));
+    }
+
+    // Constructs the value in place from _args if _key does not exist yet. Unlike insert, an
+    // existing value is left untouched.
+    template <class... Args>
+    inline InsertResult tryEmplace(const KeyType & _key, Args &&... _args)
+    {
+        auto res = m_tree.tryEmplace(_key, EmplaceTag(), _key, std::forward<Args>(_args)...);
+        return { Iter(res.node, m_tree.rightMost()), res.inserted };
+    }
+
+    template <class... Args>
+    inline InsertResult tryEmplace(KeyType && _key, Args &&... _args)
+    {
+        // the key is only moved from once its position in the tree is known
+        auto res =
+            m_tree.tryEmplace(_key, EmplaceTag(), std::move(_key), std::forward<Args>(_args)...);
+        return { Iter(res.node, m_tree.rightMost()), res.inserted };
     }
 
     inline ValueType & operator[](const KeyType & _key)
     {
-        Node * n = m_tree.find(_key);
-        if (n)
-        {
-            return n->value.value;
-        }
-        else
-        {
-            auto res = m_tree.insert({ _key, ValueType() });
-            return res.node->value.value;
-        }
+        return tryEmplace(_key).iterator->value;
     }
 
     inline Iter find(const KeyType & _key)
@@ -377,6 +418,24 @@ class Map
         return ConstIter(m_tree.find(_key), m_tree.rightMost());
     }
 
+    // Lookup with a different key type (i.e. a StringView or c string for String keys) without
+    // converting it to KeyType. Only available if KeyType can be compared with L.
+    template <class L,
+              class Enable = decltype(std::declval<const KeyType &>() == std::declval<const L &>() &&
+                                      std::declval<const KeyType &>() > std::declval<const L &>())>
+    inline Iter find(const L & _key)
+    {
+        return Iter(m_tree.find(_key), m_tree.rightMost());
+    }
+
+    template <class L,
+              class Enable = decltype(std::declval<const KeyType &>() == std::declval<const L &>() &&
+                                      std::declval<const KeyType &>() > std::declval<const L &>())>
+    inline ConstIter find(const L & _key) const
+    {
+        return ConstIter(m_tree.find(_key), m_tree.rightMost());
+    }
+
     inline Iter remove(Iter _it)
     {
         Iter ret = _it + 1;
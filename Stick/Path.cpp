@@ -4,6 +4,21 @@ namespace stick
 {
 namespace path
 {
+namespace
+{
+// the index of the last _c in _path, a match at the very beginning does not count
+Size rfindIndexAfterFirst(StringView _path, char _c)
+{
+    Size idx = _path.rfindIndex(_c);
+    return idx == 0 ? Size(StringView::InvalidIndex) : idx;
+}
+
+SplitResult toSplitResult(const SplitViewResult & _res, Allocator & _alloc)
+{
+    return { String(_res.left, _alloc), String(_res.right, _alloc) };
+}
+} // namespace
+
 String separator()
 {
     return "/";
@@ -16,7 +31,12 @@ String directoryName(const String & _path)
 
 String directoryName(const String & _path, Allocator & _alloc)
 {
-    return split(_path, _alloc).left;
+    return String(directoryNameView(_path), _alloc);
+}
+
+StringView directoryNameView(StringView _path)
+{
+    return splitView(_path).left;
 }
 
 String fileName(const String & _path)
@@ -26,7 +46,12 @@ String fileName(const String & _path)
 
 String fileName(const String & _path, Allocator & _alloc)
 {
-    return split(_path, _alloc).right;
+    return String(fileNameView(_path), _alloc);
+}
+
+StringView fileNameView(StringView _path)
+{
+    return splitView(_path).right;
 }
 
 String extension(const String & _path)
@@ -36,7 +61,12 @@ String extension(const String & _path)
 
 String extension(const String & _path, Allocator & _alloc)
 {
-    return splitExtension(_path, _alloc).right;
+    return String(extensionView(_path), _alloc);
+}
+
+StringView extensionView(StringView _path)
+{
+    return splitExtensionView(_path).right;
 }
 
 StringArray segments(const String & _path, char _separator)
@@ -48,28 +78,18 @@ StringArray segments(const String & _path, Allocator & _alloc, char _separator)
 {
     StringArray ret(_alloc);
     ret.reserve(4);
-    String::ConstIter it = _path.begin();
-    String currentSegment(_alloc);
-    while (it != _path.end())
-    {
-        if (*it == _separator)
-        {
-            if (!currentSegment.isEmpty())
-            {
-                ret.append(currentSegment);
-                currentSegment.clear();
-            }
-        }
-        else
-            currentSegment.append(*it);
-        ++it;
-    }
-    if (!currentSegment.isEmpty())
-        ret.append(currentSegment);
+    for (StringView seg : StringView(_path).split(_separator, true))
+        ret.append(String(seg, _alloc));
 
     return ret;
 }
 
+void segments(StringView _path, StringViewArray & _outSegments, char _separator)
+{
+    for (StringView seg : _path.split(_separator, true))
+        _outSegments.append(seg);
+}
+
 String fromSegments(const StringArray & _segments,
                     bool _bAddLeadingSeparator,
                     bool _bAddTrailingSeparator)
@@ -121,36 +141,46 @@ String normalize(const String & _path, bool _bRemoveLeading, Allocator & _alloca
     bool bHasLeadingSep = _path[0] == '/';
     bool bHasTrailingSep = _path[_path.length() - 1] == '/' && _path.length() > 1;
 
-    StringArray segs = segments(_path, _allocator);
-    // to buffer the parsed segments
-    StringArray tmp(_allocator);
-    tmp.reserve(segs.count());
-    StringArray::Iter it = segs.begin();
-    for (; it != segs.end(); ++it)
+    // the segments that remain, they point into _path so the result is assembled in one go
+    StringViewArray tmp(_allocator);
+    for (StringView seg : StringView(_path).split('/', true))
     {
-        if (*it == "..")
+        if (seg == "..")
         {
             if (!tmp.isEmpty())
             {
                 // check if the last segment needs to be removed
                 if (tmp.last() == "..")
-                    tmp.append(*it);
+                    tmp.append(seg);
                 else
                     tmp.removeLast();
             }
             // check if the leading segment should be removed
             else if (!_bRemoveLeading)
             {
-                tmp.append(*it);
+                tmp.append(seg);
             }
         }
         // ignore dots
-        else if (*it != "." && !(*it).isEmpty())
+        else if (seg != ".")
         {
-            tmp.append(*it);
+            tmp.append(seg);
         }
     }
-    return fromSegments(tmp, bHasLeadingSep, bHasTrailingSep, _allocator);
+
+    String ret(_allocator);
+    ret.reserve(_path.length());
+    if (bHasLeadingSep)
+        ret.append('/');
+    for (Size i = 0; i < tmp.count(); ++i)
+    {
+        if (i > 0)
+            ret.append('/');
+        ret.append(tmp[i]);
+    }
+    if (bHasTrailingSep)
+        ret.append('/');
+    return ret;
 }
 
 SplitResult split(const String & _path)
@@ -160,13 +190,16 @@ SplitResult split(const String & _path)
 
 SplitResult split(const String & _path, Allocator & _alloc)
 {
-    Size index = _path.rfindIndex('/');
-    if (index != String::InvalidIndex)
-    {
-        return { _path.sub(0, index, _alloc), _path.sub(index + 1, String::InvalidIndex, _alloc) };
-    }
+    return toSplitResult(splitView(_path), _alloc);
+}
 
-    return { _path, String(_alloc) };
+SplitViewResult splitView(StringView _path)
+{
+    Size index = rfindIndexAfterFirst(_path, '/');
+    if (index != StringView::InvalidIndex)
+        return { _path.sub(0, index), _path.sub(index + 1) };
+
+    return { _path, _path.sub(_path.length()) };
 }
 
 SplitResult splitExtension(const String & _path)
@@ -176,12 +209,16 @@ SplitResult splitExtension(const String & _path)
 
 SplitResult splitExtension(const String & _path, Allocator & _alloc)
 {
-    Size index = _path.rfindIndex('.');
-    if (index != String::InvalidIndex)
-    {
-        return { _path.sub(0, index, _alloc), _path.sub(index, String::InvalidIndex, _alloc) };
-    }
-    return { _path, String(_alloc) };
+    return toSplitResult(splitExtensionView(_path), _alloc);
+}
+
+SplitViewResult splitExtensionView(StringView _path)
+{
+    Size index = rfindIndexAfterFirst(_path, '.');
+    if (index != StringView::InvalidIndex)
+        return { _path.sub(0, index), _path.sub(index) };
+
+    return { _path, _path.sub(_path.length()) };
 }
 
 String join(const String & _a, const String & _b)
@@ -204,15 +241,15 @@ String join(const String & _a, const String & _b, Allocator & _alloc)
         return String::concatWithAllocator(_alloc, _a, '/', _b);
 }
 
-bool isRelative(const String & _path)
+bool isRelative(StringView _path)
 {
-    if (_path[0] == '/')
+    if (!_path.isEmpty() && _path[0] == '/')
         return false;
     else
         return true;
 }
 
-bool isAbsolute(const String & _path)
+bool isAbsolute(StringView _path)
 {
     return !isRelative(_path);
 }
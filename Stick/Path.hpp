@@ -2,12 +2,15 @@
 #define STICK_PATH_HPP
 
 #include <Stick/DynamicArray.hpp>
+#include <Stick/SmallDynamicArray.hpp>
 #include <Stick/String.hpp>
 
 namespace stick
 {
 // TODO: Should this be somewhere else?
 typedef DynamicArray<String> StringArray;
+// paths rarely have more segments than that, so splitting them doesn't touch the heap
+typedef SmallDynamicArray<StringView, 16> StringViewArray;
 
 namespace path
 {
@@ -20,6 +23,15 @@ struct SplitResult
     String right;
 };
 
+/**
+ * @brief Same as SplitResult, but both parts view the string that was split.
+ */
+struct SplitViewResult
+{
+    StringView left;
+    StringView right;
+};
+
 /**
  * @brief Returns the platform specific path separator.
  */
@@ -32,6 +44,11 @@ String directoryName(const String & _path);
 
 String directoryName(const String & _path, Allocator & _allocator);
 
+/**
+ * @brief Returns the directory portion of a path as a view into it.
+ */
+StringView directoryNameView(StringView _path);
+
 /**
  * @brief Returns the file name portion of a path.
  */
@@ -39,6 +56,11 @@ String fileName(const String & _path);
 
 String fileName(const String & _path, Allocator & _allocator);
 
+/**
+ * @brief Returns the file name portion of a path as a view into it.
+ */
+StringView fileNameView(StringView _path);
+
 /**
  * @brief Returns the file extension of a path.
  */
@@ -46,6 +68,11 @@ String extension(const String & _path);
 
 String extension(const String & _path, Allocator & _allocator);
 
+/**
+ * @brief Returns the file extension of a path as a view into it.
+ */
+StringView extensionView(StringView _path);
+
 /**
  * @brief Returns all the segments/portions of a path as individual strings.
  */
@@ -53,6 +80,14 @@ StringArray segments(const String & _path, char _separator = '/');
 
 StringArray segments(const String & _path, Allocator & _allocator, char _separator = '/');
 
+/**
+ * @brief Appends views of all the segments/portions of a path to _outSegments.
+ *
+ * Nothing is allocated if _outSegments has enough capacity, which makes it cheap to reuse the
+ * same array for many paths.
+ */
+void segments(StringView _path, StringViewArray & _outSegments, char _separator = '/');
+
 /**
  * @brief Creates a path string from individual path segments.
  */
@@ -83,6 +118,12 @@ SplitResult split(const String & _path);
 
 SplitResult split(const String & _path, Allocator & _alloc);
 
+/**
+ * @brief Same as split, but returns views into _path.
+ * @see split
+ */
+SplitViewResult splitView(StringView _path);
+
 /**
  * @brief Splits a path from its file extension.
  * SplitResult.first will be the path.
@@ -93,6 +134,12 @@ SplitResult splitExtension(const String & _path);
 
 SplitResult splitExtension(const String & _path, Allocator & _allocator);
 
+/**
+ * @brief Same as splitExtension, but returns views into _path.
+ * @see splitExtension
+ */
+SplitViewResult splitExtensionView(StringView _path);
+
 /**
  * @brief Joins two paths.
  *
@@ -107,12 +154,12 @@ String join(const String & _a, const String & _b, Allocator & _allocator);
 /**
  * @brief Returns true if a path is relative.
  */
-bool isRelative(const String & _path);
+bool isRelative(StringView _path);
 
 /**
  * @brief Returns true if a path is absolute.
  */
-bool isAbsolute(const String & _path);
+bool isAbsolute(StringView _path);
 } // namespace path
 } // namespace stick
 
@@ -44,6 +44,9 @@
 #define STICK_API __attribute__((visibility("default")))
 #define STICK_LOCAL __attribute__((visibility("hidden")))
 
+// keeps a function from being inlined, i.e. so that __builtin_return_address(0) is its call site
+#define STICK_NOINLINE __attribute__((noinline))
+
 // helper to define enum class and circumvent bug in gcc < version 6.0
 // https://gcc.gnu.org/bugzilla/show_bug.cgi?id=43407#c6
 #if defined(__GNUC__) && __GNUC__ < 6 && !defined(__clang__)
@@ -3,7 +3,8 @@
 
 #include <Stick/CallbackID.hpp>
 #include <Stick/DynamicArray.hpp>
-#include <Stick/HashMap.hpp>
+#include <Stick/FlatHashMap.hpp>
+#include <Stick/SmallDynamicArray.hpp>
 #include <Stick/UniquePtr.hpp>
 
 namespace stick
@@ -21,8 +22,9 @@ struct MappedCallbackStorageT
 
     using CallbackUniquePtr = UniquePtr<CallbackBaseType>;
     using StorageArray = DynamicArray<Storage>;
-    using RawPtrArray = DynamicArray<const CallbackBaseType *>;
-    using CallbackMap = HashMap<TypeID, RawPtrArray>;
+    // most event types only have a handful of callbacks
+    using RawPtrArray = SmallDynamicArray<const CallbackBaseType *, 4>;
+    using CallbackMap = FlatHashMap<TypeID, RawPtrArray>;
 
     MappedCallbackStorageT(Allocator & _alloc) : callbackMap(16, _alloc), storage(_alloc)
     {
@@ -0,0 +1,135 @@
+#ifndef STICK_PRIVATE_STRINGSEARCH_HPP
+#define STICK_PRIVATE_STRINGSEARCH_HPP
+
+#include <Stick/Platform.hpp>
+#include <cstddef>
+#include <cstring>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define STICK_STRING_SEARCH_AVX2
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#define STICK_STRING_SEARCH_SSE2
+#endif
+
+namespace stick
+{
+namespace detail
+{
+// the first _c in the _count characters at _str or nullptr
+inline const char * findChar(const char * _str, Size _count, char _c)
+{
+    return _count ? static_cast<const char *>(std::memchr(_str, _c, _count)) : nullptr;
+}
+
+// the last _c in the _count characters at _str or nullptr
+inline const char * rfindChar(const char * _str, Size _count, char _c)
+{
+#if STICK_PLATFORM == STICK_PLATFORM_LINUX && defined(_GNU_SOURCE)
+    return _count ? static_cast<const char *>(memrchr(_str, _c, _count)) : nullptr;
+#else
+    for (; _count > 0; --_count)
+    {
+        if (_str[_count - 1] == _c)
+            return _str + _count - 1;
+    }
+    return nullptr;
+#endif
+}
+
+// The first occurence of the needle in the _count characters at _str or nullptr.
+// The vectorized loops compare the first and the last character of the needle against a block of
+// possible start positions at once and only compare the characters in between where both match.
+// This skips most positions of real world text with a handful of instructions per block.
+inline const char * findSubstring(const char * _str,
+                                  Size _count,
+                                  const char * _needle,
+                                  Size _needleCount)
+{
+    if (!_needleCount)
+        return _str;
+    if (_needleCount > _count)
+        return nullptr;
+    if (_needleCount == 1)
+        return findChar(_str, _count, _needle[0]);
+
+    // the last position the needle can start at
+    const char * last = _str + _count - _needleCount;
+    const char * it = _str;
+
+#if defined(STICK_STRING_SEARCH_AVX2)
+    const __m256i first = _mm256_set1_epi8(_needle[0]);
+    const __m256i lastChar = _mm256_set1_epi8(_needle[_needleCount - 1]);
+    for (; last - it >= 31; it += 32)
+    {
+        __m256i blockFirst = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(it));
+        __m256i blockLast =
+            _mm256_loadu_si256(reinterpret_cast<const __m256i *>(it + _needleCount - 1));
+        UInt32 mask = static_cast<UInt32>(_mm256_movemask_epi8(_mm256_and_si256(
+            _mm256_cmpeq_epi8(first, blockFirst), _mm256_cmpeq_epi8(lastChar, blockLast))));
+        while (mask)
+        {
+            UInt32 bit = __builtin_ctz(mask);
+            if (std::memcmp(it + bit + 1, _needle + 1, _needleCount - 2) == 0)
+                return it + bit;
+            mask &= mask - 1;
+        }
+    }
+#elif defined(STICK_STRING_SEARCH_SSE2)
+    const __m128i first = _mm_set1_epi8(_needle[0]);
+    const __m128i lastChar = _mm_set1_epi8(_needle[_needleCount - 1]);
+    for (; last - it >= 15; it += 16)
+    {
+        __m128i blockFirst = _mm_loadu_si128(reinterpret_cast<const __m128i *>(it));
+        __m128i blockLast = _mm_loadu_si128(reinterpret_cast<const __m128i *>(it + _needleCount - 1));
+        UInt32 mask = static_cast<UInt32>(_mm_movemask_epi8(
+            _mm_and_si128(_mm_cmpeq_epi8(first, blockFirst), _mm_cmpeq_epi8(lastChar, blockLast))));
+        while (mask)
+        {
+            UInt32 bit = __builtin_ctz(mask);
+            if (std::memcmp(it + bit + 1, _needle + 1, _needleCount - 2) == 0)
+                return it + bit;
+            mask &= mask - 1;
+        }
+    }
+#endif
+
+    // the remaining positions or all of them if there is no vector unit
+    while (it <= last)
+    {
+        it = findChar(it, last - it + 1, _needle[0]);
+        if (!it)
+            return nullptr;
+        if (std::memcmp(it + 1, _needle + 1, _needleCount - 1) == 0)
+            return it;
+        ++it;
+    }
+    return nullptr;
+}
+
+// the last occurence of the needle that starts in the first _startCount characters at _str, which
+// have to be followed by at least _needleCount - 1 more characters
+inline const char * rfindSubstring(const char * _str,
+                                   Size _startCount,
+                                   const char * _needle,
+                                   Size _needleCount)
+{
+    if (!_needleCount)
+        return _startCount ? _str + _startCount - 1 : nullptr;
+
+    while (_startCount)
+    {
+        const char * it = rfindChar(_str, _startCount, _needle[0]);
+        if (!it)
+            return nullptr;
+        if (std::memcmp(it + 1, _needle + 1, _needleCount - 1) == 0)
+            return it;
+        _startCount = it - _str;
+    }
+    return nullptr;
+}
+} // namespace detail
+} // namespace stick
+
+#endif // STICK_PRIVATE_STRINGSEARCH_HPP
@@ -0,0 +1,133 @@
+#ifndef STICK_PRIVATE_WYHASH_HPP
+#define STICK_PRIVATE_WYHASH_HPP
+
+//-----------------------------------------------------------------------------
+// wyhash (final version 4), by Wang Yi. Released into the public domain.
+// https://github.com/wangyi-fudan/wyhash
+
+// Strings of more than 48 bytes are consumed in three independent lanes per iteration, which keeps
+// the multipliers busy. Like the original it is not endian neutral, big and little endian machines
+// produce different hashes.
+
+#include <Stick/Platform.hpp>
+#include <cstring>
+
+namespace stick
+{
+namespace detail
+{
+static constexpr UInt64 wyp0 = 0x2d358dccaa6c78a5ull;
+static constexpr UInt64 wyp1 = 0x8bb84b93962eacc9ull;
+static constexpr UInt64 wyp2 = 0x4b33a62ed433d4a3ull;
+static constexpr UInt64 wyp3 = 0x4d5a2da51de1aa47ull;
+
+// 64x64 -> 128 bit multiply, _a receives the lower and _b the upper half
+inline void wymum(UInt64 * _a, UInt64 * _b)
+{
+#if defined(__SIZEOF_INT128__)
+    __uint128_t r = *_a;
+    r *= *_b;
+    *_a = static_cast<UInt64>(r);
+    *_b = static_cast<UInt64>(r >> 64);
+#else
+    UInt64 ha = *_a >> 32, hb = *_b >> 32, la = static_cast<UInt32>(*_a),
+           lb = static_cast<UInt32>(*_b);
+    UInt64 rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb, t = rl + (rm0 << 32);
+    UInt64 c = t < rl;
+    UInt64 lo = t + (rm1 << 32);
+    c += lo < t;
+    UInt64 hi = rh + (rm0 >> 32) + (rm1 >> 32) + c;
+    *_a = lo;
+    *_b = hi;
+#endif // defined(__SIZEOF_INT128__)
+}
+
+inline UInt64 wymix(UInt64 _a, UInt64 _b)
+{
+    wymum(&_a, &_b);
+    return _a ^ _b;
+}
+
+inline UInt64 wyr8(const UInt8 * _p)
+{
+    UInt64 v;
+    std::memcpy(&v, _p, 8);
+    return v;
+}
+
+inline UInt64 wyr4(const UInt8 * _p)
+{
+    UInt32 v;
+    std::memcpy(&v, _p, 4);
+    return v;
+}
+
+inline UInt64 wyr3(const UInt8 * _p, Size _k)
+{
+    return (static_cast<UInt64>(_p[0]) << 16) | (static_cast<UInt64>(_p[_k >> 1]) << 8) |
+           _p[_k - 1];
+}
+
+inline UInt64 wyhash(const void * _key, Size _len, UInt64 _seed)
+{
+    const UInt8 * p = static_cast<const UInt8 *>(_key);
+    _seed ^= wymix(_seed ^ wyp0, wyp1);
+    UInt64 a, b;
+    if (_len <= 16)
+    {
+        if (_len >= 4)
+        {
+            a = (wyr4(p) << 32) | wyr4(p + ((_len >> 3) << 2));
+            b = (wyr4(p + _len - 4) << 32) | wyr4(p + _len - 4 - ((_len >> 3) << 2));
+        }
+        else if (_len > 0)
+        {
+            a = wyr3(p, _len);
+            b = 0;
+        }
+        else
+            a = b = 0;
+    }
+    else
+    {
+        Size i = _len;
+        if (i >= 48)
+        {
+            UInt64 see1 = _seed, see2 = _seed;
+            do
+            {
+                _seed = wymix(wyr8(p) ^ wyp1, wyr8(p + 8) ^ _seed);
+                see1 = wymix(wyr8(p + 16) ^ wyp2, wyr8(p + 24) ^ see1);
+                see2 = wymix(wyr8(p + 32) ^ wyp3, wyr8(p + 40) ^ see2);
+                p += 48;
+                i -= 48;
+            } while (i >= 48);
+            _seed ^= see1 ^ see2;
+        }
+        while (i > 16)
+        {
+            _seed = wymix(wyr8(p) ^ wyp1, wyr8(p + 8) ^ _seed);
+            i -= 16;
+            p += 16;
+        }
+        a = wyr8(p + i - 16);
+        b = wyr8(p + i - 8);
+    }
+    a ^= wyp1;
+    b ^= _seed;
+    wymum(&a, &b);
+    return wymix(a ^ wyp0 ^ _len, b ^ wyp1);
+}
+
+// finalizer for a single 64 bit value
+inline UInt64 wyhash64(UInt64 _a)
+{
+    UInt64 b = wyp1;
+    _a ^= wyp0;
+    wymum(&_a, &b);
+    return wymix(_a ^ wyp0, b ^ wyp1);
+}
+} // namespace detail
+} // namespace stick
+
+#endif // STICK_PRIVATE_WYHASH_HPP
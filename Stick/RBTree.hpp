@@ -28,9 +28,10 @@ class RBTree
         {
         }
 
-        Node(const T & _value) :
+        template <class... Args>
+        explicit Node(Args &&... _args) :
             color(Color::Red),
-            value(_value),
+            value(std::forward<Args>(_args)...),
             left(nullptr),
             right(nullptr),
             parent(nullptr)
@@ -68,9 +69,9 @@ class RBTree
 
         inline void swapValue(Node & _other)
         {
-            T tmp = _other.value;
-            _other.value = value;
-            value = tmp;
+            T tmp(std::move(_other.value));
+            _other.value = std::move(value);
+            value = std::move(tmp);
         }
 
         Color color;
@@ -171,6 +172,57 @@ class RBTree
         }
     }
 
+    inline InsertResult insert(ValueType && _val)
+    {
+        if (m_count == 0)
+        {
+            m_rootNode = createNode(std::move(_val));
+            m_rootNode->color = Color::Black;
+            m_count++;
+            return { m_rootNode, true };
+        }
+        else
+        {
+            return insertImpl(m_rootNode, std::move(_val));
+        }
+    }
+
+    // Looks for a value that compares equal to _key. If there is none, a new value is constructed
+    // in place from _args, otherwise nothing happens. _key is only used for the comparisons.
+    template <class K, class... Args>
+    inline InsertResult tryEmplace(const K & _key, Args &&... _args)
+    {
+        Node * parent = nullptr;
+        Node * n = m_rootNode;
+        bool bLeft = false;
+        while (n)
+        {
+            if (n->value == _key)
+                return { n, false };
+
+            parent = n;
+            bLeft = n->value > _key;
+            n = bLeft ? n->left : n->right;
+        }
+
+        n = createNode(std::forward<Args>(_args)...);
+        m_count++;
+        if (!parent)
+        {
+            m_rootNode = n;
+            n->color = Color::Black;
+            return { n, true };
+        }
+
+        n->parent = parent;
+        if (bLeft)
+            parent->left = n;
+        else
+            parent->right = n;
+        insertFix(n);
+        return { n, true };
+    }
+
     inline bool remove(const ValueType & _val)
     {
         Node * n = find(_val);
@@ -257,11 +309,12 @@ class RBTree
         return newNode;
     }
 
-    inline Node * createNode(const ValueType & _val)
+    template <class... Args>
+    inline Node * createNode(Args &&... _args)
     {
         auto mem = m_alloc->allocate(sizeof(Node), alignof(Node));
         STICK_ASSERT(mem.ptr);
-        return new (mem.ptr) Node(_val);
+        return new (mem.ptr) Node(std::forward<Args>(_args)...);
     }
 
     inline void destroyNode(Node * _n)
@@ -424,12 +477,13 @@ class RBTree
         }
     }
 
-    inline InsertResult insertImpl(Node * _currentNode, const ValueType & _val)
+    template <class VT>
+    inline InsertResult insertImpl(Node * _currentNode, VT && _val)
     {
         if (_currentNode->value == _val)
         {
             // assign the value, as the comparision does not necessarily mean they are identical
-            _currentNode->value = _val;
+            _currentNode->value = std::forward<VT>(_val);
             return { _currentNode, false };
         }
         else
@@ -446,7 +500,7 @@ class RBTree
 
             if (!node)
             {
-                node = createNode(_val);
+                node = createNode(std::forward<VT>(_val));
                 node->parent = _currentNode;
                 if (bLeft)
                     _currentNode->left = node;
@@ -460,7 +514,7 @@ class RBTree
             }
             else
             {
-                return insertImpl(node, _val);
+                return insertImpl(node, std::forward<VT>(_val));
             }
         }
     }
@@ -214,6 +214,12 @@ class STICK_API SharedPtr
     T * m_ptr;
 };
 
+// the control block does not point back to the SharedPtr
+template <class T, class C>
+struct IsTriviallyRelocatable<SharedPtr<T, C>> : std::true_type
+{
+};
+
 //@TODO make extra hidden constructor for SharedPtr that only performs one allocation
 template <class T, class... Args>
 SharedPtr<T> makeShared(Args &&... _args)
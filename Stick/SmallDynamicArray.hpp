@@ -0,0 +1,514 @@
+#ifndef STICK_SMALLDYNAMICARRAY_HPP
+#define STICK_SMALLDYNAMICARRAY_HPP
+
+#include <Stick/Allocator.hpp>
+#include <Stick/Iterator.hpp>
+#include <Stick/Utility.hpp>
+#include <cstring>
+#include <initializer_list>
+#include <new>
+#include <type_traits>
+
+namespace stick
+{
+// Dynamic array that stores up to N elements inline and only allocates memory through its
+// Allocator once it grows past them. Has the same interface as DynamicArray. Unlike
+// DynamicArray, moving an array that did not spill to the allocator moves its elements one by
+// one.
+template <class T, Size N>
+class SmallDynamicArray
+{
+    static_assert(N > 0, "SmallDynamicArray needs an inline capacity of at least one element");
+
+  public:
+    using ValueType = T;
+    using Iter = T *;
+    using ConstIter = const T *;
+    using ReverseIter = ReverseIterator<Iter>;
+    using ReverseConstIter = ReverseIterator<ConstIter>;
+
+    using iterator = Iter;
+    using const_iterator = ConstIter;
+    using value_type = ValueType;
+    using difference_type = std::ptrdiff_t;
+    using reference = value_type &;
+    using const_reference = const value_type &;
+    using pointer = value_type *;
+    using const_pointer = const value_type *;
+    using size_type = Size;
+
+    static constexpr Size inlineCapacity = N;
+
+    SmallDynamicArray(Allocator & _alloc = defaultAllocator()) :
+        m_ptr(inlinePtr()),
+        m_count(0),
+        m_capacity(N),
+        m_allocator(&_alloc)
+    {
+    }
+
+    SmallDynamicArray(std::initializer_list<T> _il, Allocator & _alloc = defaultAllocator()) :
+        SmallDynamicArray(_alloc)
+    {
+        insert(end(), _il.begin(), _il.end());
+    }
+
+    SmallDynamicArray(Size _size, Allocator & _alloc = defaultAllocator()) :
+        SmallDynamicArray(_alloc)
+    {
+        resize(_size);
+    }
+
+    SmallDynamicArray(const SmallDynamicArray & _other) : SmallDynamicArray(*_other.m_allocator)
+    {
+        insert(end(), _other.begin(), _other.end());
+    }
+
+    SmallDynamicArray(SmallDynamicArray && _other) : SmallDynamicArray(*_other.m_allocator)
+    {
+        moveFrom(std::move(_other));
+    }
+
+    ~SmallDynamicArray()
+    {
+        deallocate();
+    }
+
+    inline SmallDynamicArray & operator=(const SmallDynamicArray & _other)
+    {
+        if (this != &_other)
+        {
+            deallocate();
+            m_allocator = _other.m_allocator;
+            insert(end(), _other.begin(), _other.end());
+        }
+        return *this;
+    }
+
+    inline SmallDynamicArray & operator=(std::initializer_list<T> _il)
+    {
+        clear();
+        insert(end(), _il.begin(), _il.end());
+        return *this;
+    }
+
+    inline SmallDynamicArray & operator=(SmallDynamicArray && _other)
+    {
+        if (this != &_other)
+        {
+            deallocate();
+            m_allocator = _other.m_allocator;
+            moveFrom(std::move(_other));
+        }
+        return *this;
+    }
+
+    inline void resize(Size _s)
+    {
+        reserve(_s);
+        for (Size i = m_count; i < _s; ++i)
+            new (m_ptr + i) T();
+        for (Size i = _s; i < m_count; ++i)
+            m_ptr[i].~T();
+        m_count = _s;
+    }
+
+    inline void resize(Size _s, const T & _initial)
+    {
+        reserve(_s);
+        for (Size i = m_count; i < _s; ++i)
+            new (m_ptr + i) T(_initial);
+        for (Size i = _s; i < m_count; ++i)
+            m_ptr[i].~T();
+        m_count = _s;
+    }
+
+    inline void reserve(Size _s)
+    {
+        if (_s <= m_capacity)
+            return;
+
+        STICK_ASSERT(m_allocator);
+
+        if (!isInline())
+        {
+            mem::Block blk = heapBlock();
+            // growing in place does not move the elements, so this works for any T
+            if (m_allocator->expand(blk, _s * sizeof(T) - blk.size))
+            {
+                m_capacity = _s;
+                return;
+            }
+        }
+
+        auto blk = m_allocator->allocate(_s * sizeof(T), alignof(T));
+        STICK_ASSERT(blk);
+        T * arrayPtr = reinterpret_cast<T *>(blk.ptr);
+        relocate(arrayPtr, m_ptr, m_count);
+
+        if (!isInline())
+            m_allocator->deallocate(heapBlock());
+
+        m_ptr = arrayPtr;
+        m_capacity = _s;
+    }
+
+    inline void append(std::initializer_list<T> _l)
+    {
+        insert(end(), _l.begin(), _l.end());
+    }
+
+    inline void append(const T & _element)
+    {
+        if (m_capacity <= m_count)
+        {
+            // _element might live in this array
+            T tmp(_element);
+            grow(m_count + 1);
+            new (m_ptr + m_count++) T(std::move(tmp));
+        }
+        else
+            new (m_ptr + m_count++) T(_element);
+    }
+
+    inline void append(T && _element)
+    {
+        if (m_capacity <= m_count)
+        {
+            T tmp(std::move(_element));
+            grow(m_count + 1);
+            new (m_ptr + m_count++) T(std::move(tmp));
+        }
+        else
+            new (m_ptr + m_count++) T(std::move(_element));
+    }
+
+    template <class... Args>
+    inline T & emplaceBack(Args &&... _args)
+    {
+        if (m_capacity <= m_count)
+        {
+            T tmp(std::forward<Args>(_args)...);
+            grow(m_count + 1);
+            return *new (m_ptr + m_count++) T(std::move(tmp));
+        }
+        return *new (m_ptr + m_count++) T(std::forward<Args>(_args)...);
+    }
+
+    template <class InputIter>
+    inline void append(InputIter _first, InputIter _last)
+    {
+        insert(end(), _first, _last);
+    }
+
+    template <class InputIter>
+    inline Iter insert(ConstIter _it, InputIter _first, InputIter _last)
+    {
+        Size idiff = _last - _first;
+        Size index = _it - begin();
+        if (m_capacity < m_count + idiff)
+            grow(m_count + idiff);
+
+        openGap(index, idiff);
+        for (Size i = 0; _first != _last; ++_first, ++i)
+            new (m_ptr + index + i) T(*_first);
+        m_count += idiff;
+        return begin() + index;
+    }
+
+    inline Iter insert(ConstIter _it, const T & _val)
+    {
+        T tmp(_val);
+        return insert(_it, std::move(tmp));
+    }
+
+    inline Iter insert(ConstIter _it, T && _val)
+    {
+        Size index = _it - begin();
+        if (m_capacity <= m_count)
+            grow(m_count + 1);
+
+        openGap(index, 1);
+        new (m_ptr + index) T(std::move(_val));
+        ++m_count;
+        return begin() + index;
+    }
+
+    // Constructs the new element at _it in place from _args. If one of _args is a T, it might be
+    // an element of this array that opening the gap moves, so a temporary is constructed first.
+    template <class... Args>
+    inline Iter emplace(ConstIter _it, Args &&... _args)
+    {
+        if (_it == end())
+        {
+            emplaceBack(std::forward<Args>(_args)...);
+            return end() - 1;
+        }
+        if (IsSameAsAny<T, Args...>::value)
+            return insert(_it, T(std::forward<Args>(_args)...));
+
+        Size index = _it - begin();
+        if (m_capacity <= m_count)
+            grow(m_count + 1);
+
+        openGap(index, 1);
+        new (m_ptr + index) T(std::forward<Args>(_args)...);
+        ++m_count;
+        return begin() + index;
+    }
+
+    inline Iter remove(ConstIter _first, ConstIter _last)
+    {
+        Size index = _first - begin();
+        Size idiff = _last - _first;
+
+        if (IsTriviallyRelocatable<T>::value)
+        {
+            for (Size i = index; i < index + idiff; ++i)
+                m_ptr[i].~T();
+            if (index + idiff < m_count)
+                std::memmove(static_cast<void *>(m_ptr + index),
+                             m_ptr + index + idiff,
+                             (m_count - index - idiff) * sizeof(T));
+            m_count -= idiff;
+            return begin() + index;
+        }
+
+        for (Size i = index + idiff; i < m_count; ++i)
+            m_ptr[i - idiff] = std::move(m_ptr[i]);
+        for (Size i = m_count - idiff; i < m_count; ++i)
+            m_ptr[i].~T();
+
+        m_count -= idiff;
+        return begin() + index;
+    }
+
+    inline Iter remove(Iter _it)
+    {
+        return remove(_it, _it + 1);
+    }
+
+    inline void removeLast()
+    {
+        m_ptr[--m_count].~T();
+    }
+
+    inline void clear()
+    {
+        for (Size i = 0; i < m_count; ++i)
+            m_ptr[i].~T();
+        m_count = 0;
+    }
+
+    // destroys all elements and gives the allocated memory back, if any
+    inline void deallocate()
+    {
+        clear();
+        if (!isInline())
+        {
+            m_allocator->deallocate(heapBlock());
+            m_ptr = inlinePtr();
+            m_capacity = N;
+        }
+    }
+
+    // true as long as the elements are stored inline
+    inline bool isInline() const
+    {
+        return m_ptr == inlinePtr();
+    }
+
+    inline Allocator & allocator() const
+    {
+        STICK_ASSERT(m_allocator);
+        return *m_allocator;
+    }
+
+    inline bool isEmpty() const
+    {
+        return m_count == 0;
+    }
+
+    inline const T & operator[](Size _index) const
+    {
+        return m_ptr[_index];
+    }
+
+    inline T & operator[](Size _index)
+    {
+        return m_ptr[_index];
+    }
+
+    inline Iter begin()
+    {
+        return m_ptr;
+    }
+
+    inline ConstIter begin() const
+    {
+        return m_ptr;
+    }
+
+    inline Iter end()
+    {
+        return m_ptr + m_count;
+    }
+
+    inline ConstIter end() const
+    {
+        return m_ptr + m_count;
+    }
+
+    inline ReverseIter rbegin()
+    {
+        return ReverseIter(end());
+    }
+
+    inline ReverseConstIter rbegin() const
+    {
+        return ReverseConstIter(end());
+    }
+
+    inline ReverseIter rend()
+    {
+        return ReverseIter(begin());
+    }
+
+    inline ReverseConstIter rend() const
+    {
+        return ReverseConstIter(begin());
+    }
+
+    inline Size count() const
+    {
+        return m_count;
+    }
+
+    inline Size byteCount() const
+    {
+        return m_count * sizeof(T);
+    }
+
+    inline const T * ptr() const
+    {
+        return m_ptr;
+    }
+
+    inline T * ptr()
+    {
+        return m_ptr;
+    }
+
+    inline Size capacity() const
+    {
+        return m_capacity;
+    }
+
+    inline T & first()
+    {
+        return (*this)[0];
+    }
+
+    inline const T & first() const
+    {
+        return (*this)[0];
+    }
+
+    inline T & last()
+    {
+        return (*this)[m_count - 1];
+    }
+
+    inline const T & last() const
+    {
+        return (*this)[m_count - 1];
+    }
+
+  private:
+    inline T * inlinePtr()
+    {
+        return reinterpret_cast<T *>(m_inline);
+    }
+
+    inline const T * inlinePtr() const
+    {
+        return reinterpret_cast<const T *>(m_inline);
+    }
+
+    inline mem::Block heapBlock() const
+    {
+        return { m_ptr, m_capacity * sizeof(T) };
+    }
+
+    inline void grow(Size _min)
+    {
+        reserve(max(_min, m_count * 2));
+    }
+
+    // moves the elements starting at _index _gap slots to the right, the capacity has to be
+    // large enough
+    inline void openGap(Size _index, Size _gap)
+    {
+        if (IsTriviallyRelocatable<T>::value)
+        {
+            if (_index < m_count)
+                std::memmove(static_cast<void *>(m_ptr + _index + _gap),
+                             m_ptr + _index,
+                             (m_count - _index) * sizeof(T));
+            return;
+        }
+
+        for (Size i = m_count; i > _index; --i)
+        {
+            new (m_ptr + i - 1 + _gap) T(std::move(m_ptr[i - 1]));
+            m_ptr[i - 1].~T();
+        }
+    }
+
+    // moves _count elements to the uninitialized memory at _dst and destroys the originals
+    inline static void relocate(T * _dst, T * _src, Size _count)
+    {
+        if (IsTriviallyRelocatable<T>::value)
+        {
+            if (_count)
+                std::memcpy(static_cast<void *>(_dst), _src, _count * sizeof(T));
+            return;
+        }
+
+        for (Size i = 0; i < _count; ++i)
+        {
+            new (_dst + i) T(std::move(_src[i]));
+            _src[i].~T();
+        }
+    }
+
+    // expects this array to be empty and inline
+    inline void moveFrom(SmallDynamicArray && _other)
+    {
+        if (_other.isInline())
+        {
+            relocate(m_ptr, _other.m_ptr, _other.m_count);
+            m_count = _other.m_count;
+            _other.m_count = 0;
+        }
+        else
+        {
+            // steal the allocated memory
+            m_ptr = _other.m_ptr;
+            m_count = _other.m_count;
+            m_capacity = _other.m_capacity;
+            _other.m_ptr = _other.inlinePtr();
+            _other.m_count = 0;
+            _other.m_capacity = N;
+        }
+    }
+
+    T * m_ptr;
+    Size m_count;
+    Size m_capacity;
+    Allocator * m_allocator;
+    typename std::aligned_storage<sizeof(T), alignof(T)>::type m_inline[N];
+};
+} // namespace stick
+
+#endif // STICK_SMALLDYNAMICARRAY_HPP
@@ -7,7 +7,7 @@
 
 // for string hashing
 #include <Stick/Hash.hpp>
-#include <Stick/Private/MurmurHash2.hpp>
+#include <Stick/StringView.hpp>
 
 #include <algorithm> //for transform
 #include <cctype>    //for toupper
@@ -20,13 +20,6 @@ namespace stick
 namespace detail
 {
 struct _StringCopier;
-
-template <class... Args>
-inline int variadicStringLength(const char * format, Args... _args)
-{
-    int result = std::snprintf(NULL, 0, format, _args...);
-    return result; // ignore extra byte for \0
-}
 } // namespace detail
 
 struct AppendVariadicFlag
@@ -45,12 +38,12 @@ class String
     typedef char ValueType;
     static constexpr Size InvalidIndex = -1;
 
-    inline explicit String(Allocator & _alloc = defaultAllocator()) :
-        m_cStr(nullptr),
-        m_length(0),
-        m_capacity(0),
-        m_allocator(&_alloc)
+    // strings of up to this many characters are stored inside the String without allocating
+    static constexpr Size inlineCapacity = 22;
+
+    inline explicit String(Allocator & _alloc = defaultAllocator())
     {
+        initInline(_alloc);
     }
 
     template <class... Strings>
@@ -75,58 +68,41 @@ class String
         return ret;
     }
 
-    inline String(Size _size, Allocator & _alloc = defaultAllocator()) :
-        m_cStr(nullptr),
-        m_length(0),
-        m_capacity(0),
-        m_allocator(&_alloc)
+    inline String(Size _size, Allocator & _alloc = defaultAllocator())
     {
+        initInline(_alloc);
         reserve(_size);
     }
 
-    inline String(const char * _c, Allocator & _alloc = defaultAllocator()) :
-        m_cStr(nullptr),
-        m_length(0),
-        m_capacity(0),
-        m_allocator(&_alloc)
+    inline String(const char * _c, Allocator & _alloc = defaultAllocator())
     {
-        Size l = strlen(_c);
-        if (l)
-        {
-            resize(l);
-            strcpy(m_cStr, _c);
-        }
+        initInline(_alloc);
+        assign(_c, strlen(_c));
     }
 
-    inline String(const String & _other) :
-        m_cStr(nullptr),
-        m_length(_other.m_length),
-        m_capacity(0),
-        m_allocator(_other.m_allocator)
+    inline explicit String(StringView _str, Allocator & _alloc = defaultAllocator())
     {
-        if (_other.m_cStr)
-        {
-            reserve(_other.m_length);
-            strcpy(m_cStr, _other.m_cStr);
-        }
+        initInline(_alloc);
+        assign(_str.data(), _str.length());
     }
 
-    inline String(String && _other) :
-        m_cStr(std::move(_other.m_cStr)),
-        m_length(std::move(_other.m_length)),
-        m_capacity(std::move(_other.m_capacity)),
-        m_allocator(std::move(_other.m_allocator))
+    inline String(const String & _other)
     {
-        _other.m_cStr = nullptr;
+        initInline(_other.allocator());
+        assign(_other.buffer(), _other.length());
+    }
+
+    inline String(String && _other)
+    {
+        // the inline characters are part of the bits that get copied
+        std::memcpy(static_cast<void *>(this), &_other, sizeof(String));
+        _other.initInline(_other.allocator());
     }
 
     template <class InputIter>
-    inline String(InputIter _begin, InputIter _end, Allocator & _alloc = defaultAllocator()) :
-        m_cStr(nullptr),
-        m_length(0),
-        m_capacity(0),
-        m_allocator(&_alloc)
+    inline String(InputIter _begin, InputIter _end, Allocator & _alloc = defaultAllocator())
     {
+        initInline(_alloc);
         resize(_end - _begin);
         Size index = 0;
         for (; _begin != _end; ++_begin, ++index)
@@ -142,45 +118,33 @@ class String
 
     inline String & operator=(const String & _other)
     {
-        deallocate();
+        if (this == &_other)
+            return *this;
+
         //@TODO: By default we should keep the allocator we were using maybe?
-        m_allocator = _other.m_allocator;
-        if (_other.m_cStr)
+        if (&_other.allocator() != &allocator())
         {
-            resize(_other.m_length);
-            strcpy(m_cStr, _other.m_cStr);
+            deallocate();
+            initInline(_other.allocator());
         }
-
+        assign(_other.buffer(), _other.length());
         return *this;
     }
 
     inline String & operator=(String && _other)
     {
+        if (this == &_other)
+            return *this;
+
         deallocate();
-        m_cStr = std::move(_other.m_cStr);
-        m_allocator = std::move(_other.m_allocator);
-        m_length = std::move(_other.m_length);
-        m_capacity = std::move(_other.m_capacity);
-        _other.m_cStr = nullptr;
+        std::memcpy(static_cast<void *>(this), &_other, sizeof(String));
+        _other.initInline(_other.allocator());
         return *this;
     }
 
     inline String & operator=(const char * _other)
     {
-        if (m_cStr)
-            deallocate();
-
-        if (!m_allocator)
-            m_allocator = &defaultAllocator();
-
-        Size len = strlen(_other);
-        m_length = 0;
-        if (len)
-        {
-            resize(strlen(_other));
-            strcpy(m_cStr, _other);
-        }
-
+        assign(_other, strlen(_other));
         return *this;
     }
 
@@ -190,41 +154,55 @@ class String
     template <class... Args>
     inline void appendFormatted(const char * _fmt, Args... _args)
     {
-        int len = detail::variadicStringLength(_fmt, _args...);
-        if (!len)
+        // format into the spare capacity (which always has room for the terminator) right away,
+        // only measure and format again if the result does not fit
+        Size off = length();
+        Size space = capacity() - off + 1;
+        int len = std::snprintf(buffer() + off, space, _fmt, _args...);
+        if (len <= 0)
+        {
+            setLength(off);
             return;
-        Size off = m_length;
-        preAppend(m_length + len);
-        int result = std::snprintf(m_cStr + off, len + 1, _fmt, _args...);
+        }
+        if (Size(len) < space)
+        {
+            setLength(off + len);
+            return;
+        }
+        preAppend(off + len);
+        int result = std::snprintf(buffer() + off, len + 1, _fmt, _args...);
         STICK_ASSERT(len == result);
+        STICK_UNUSED(result);
     }
 
     inline void append(const String & _str)
     {
-        if (!_str.m_length)
+        // _str might be this string, so its length has to be read before growing
+        Size len = _str.length();
+        if (!len)
             return;
-        Size off = m_length;
-        preAppend(m_length + _str.length());
-        strcpy(m_cStr + off, _str.m_cStr);
+        Size off = length();
+        preAppend(off + len);
+        std::memcpy(buffer() + off, _str.buffer(), len);
     }
 
     inline void append(const char * _cStr)
     {
-        Size len = strlen(_cStr);
-        if (!len)
-            return;
-        Size off = m_length;
-        preAppend(m_length + len);
-        strcpy(m_cStr + off, _cStr);
+        append(_cStr, strlen(_cStr));
     }
 
     inline void append(const char * _cStr, Size _count)
     {
         if (!_count)
             return;
-        Size off = m_length;
-        preAppend(m_length + _count);
-        memcpy(m_cStr + off, _cStr, _count);
+        Size off = length();
+        preAppend(length() + _count);
+        memcpy(buffer() + off, _cStr, _count);
+    }
+
+    inline void append(StringView _str)
+    {
+        append(_str.data(), _str.length());
     }
 
     inline void append(ConstIter _begin, ConstIter _end)
@@ -232,49 +210,50 @@ class String
         Size dist = std::distance(_begin, _end);
         if (!dist)
             return;
-        Size off = m_length;
-        preAppend(m_length + dist);
-        memcpy(m_cStr + off, _begin, dist);
+        Size off = length();
+        preAppend(length() + dist);
+        memcpy(buffer() + off, _begin, dist);
     }
 
     inline void append(char _c)
     {
-        Size off = m_length;
-        preAppend(m_length + 1);
+        Size off = length();
+        preAppend(length() + 1);
         (*this)[off] = _c;
     }
 
     inline void removeLast()
     {
-        if (m_length)
-            m_cStr[--m_length] = '\0';
+        Size len = length();
+        if (len)
+            setLength(len - 1);
     }
 
     inline String & remove(Size _index, Size _count = InvalidIndex)
     {
-        Size c = std::min(_count, m_length - _index);
+        Size c = std::min(_count, length() - _index);
         Size e = _index + c;
-        Size delta = m_length - e;
-        std::memmove(m_cStr + _index, m_cStr + e, delta);
+        Size delta = length() - e;
+        std::memmove(buffer() + _index, buffer() + e, delta);
 
-        resize(m_length - c);
+        resize(length() - c);
 
         return *this;
     }
 
     inline Iter remove(ConstIter _it)
     {
-        Size idx = _it - m_cStr;
+        Size idx = _it - buffer();
         remove(idx, 1);
-        return idx < m_length ? begin() + idx : end();
+        return idx < length() ? begin() + idx : end();
     }
 
     inline Iter remove(ConstIter _first, ConstIter _last)
     {
-        Size idx = _first - m_cStr;
+        Size idx = _first - buffer();
         Size c = (_last - _first);
         remove(idx, c);
-        return idx < m_length ? begin() + idx : end();
+        return idx < length() ? begin() + idx : end();
     }
 
     inline char operator[](Size _index) const
@@ -289,14 +268,9 @@ class String
 
     inline bool operator==(const String & _b) const
     {
-        // TODO: Make this nicer!!!1111
-        if (isEmpty() && _b.isEmpty())
-        {
-            return true;
-        }
-        else if (isEmpty() || _b.isEmpty())
-            return false;
-        return strcmp(m_cStr, _b.m_cStr) == 0;
+        // strings of different length can't be equal, no need to look at the characters
+        Size len = length();
+        return len == _b.length() && std::memcmp(buffer(), _b.buffer(), len) == 0;
     }
 
     inline bool operator!=(const String & _b) const
@@ -306,11 +280,8 @@ class String
 
     inline bool operator==(const char * _str) const
     {
-        if (isEmpty() && (!_str || (_str && strlen(_str) == 0)))
-            return true;
-        else if (isEmpty() || !_str)
-            return false;
-        return strcmp(m_cStr, _str) == 0;
+        // compare the lengths too, this string might contain a zero character
+        return StringView(*this) == StringView(_str);
     }
 
     inline bool operator!=(const char * _str) const
@@ -318,172 +289,132 @@ class String
         return !(*this == _str);
     }
 
+    inline bool operator==(StringView _str) const
+    {
+        return StringView(*this) == _str;
+    }
+
+    inline bool operator!=(StringView _str) const
+    {
+        return !(*this == _str);
+    }
+
+    inline bool operator<(StringView _str) const
+    {
+        return StringView(*this) < _str;
+    }
+
+    inline bool operator>(StringView _str) const
+    {
+        return StringView(*this) > _str;
+    }
+
+    inline operator StringView() const
+    {
+        return StringView(buffer(), length());
+    }
+
     inline bool operator<(const String & _str) const
     {
-        if (!m_cStr)
-            return true;
-        if (!_str.m_cStr)
-            return false;
-        return strcmp(m_cStr, _str.m_cStr) < 0;
+        return StringView(*this).compare(_str) < 0;
     }
 
     inline bool operator>(const String & _str) const
     {
-        if (!m_cStr)
-            return false;
-        if (!_str.m_cStr)
-            return true;
-        return strcmp(m_cStr, _str.m_cStr) > 0;
+        return StringView(*this).compare(_str) > 0;
     }
 
     inline bool operator<(const char * _str) const
     {
-        if (!m_cStr)
-            return true;
-        return strcmp(m_cStr, _str) < 0;
+        return StringView(*this).compare(_str) < 0;
     }
 
     inline bool operator>(const char * _str) const
     {
-        if (!m_cStr)
-            return false;
-        return strcmp(m_cStr, _str) > 0;
+        return StringView(*this).compare(_str) > 0;
     }
 
     inline bool operator<=(const String & _str) const
     {
-        if (!m_cStr && !_str.m_cStr)
-            return true;
-        if (!_str.m_cStr || !m_cStr)
-            return false;
-        return strcmp(m_cStr, _str.m_cStr) < 0;
+        return StringView(*this).compare(_str) <= 0;
     }
 
     inline bool operator>=(const String & _str) const
     {
-        if (!m_cStr && !_str.m_cStr)
-            return true;
-        if (!_str.m_cStr || m_cStr)
-            return false;
-        return strcmp(m_cStr, _str.m_cStr) >= 0;
+        return StringView(*this).compare(_str) >= 0;
     }
 
     inline bool operator<=(const char * _str) const
     {
-        if (!m_cStr)
-            return true;
-        return strcmp(m_cStr, _str) <= 0;
+        return StringView(*this).compare(_str) <= 0;
     }
 
     inline bool operator>=(const char * _str) const
     {
-        if (!m_cStr)
-            return false;
-        return strcmp(m_cStr, _str) >= 0;
+        return StringView(*this).compare(_str) >= 0;
     }
 
     inline void resize(Size _count)
     {
-        if (_count < m_length)
-            m_cStr[_count] = '\0';
-        reserve(_count);
-        m_length = _count;
+        resize(_count, '\0');
     }
 
     inline void resize(Size _count, char _c)
     {
-        if (_count < m_length)
-            m_cStr[_count] = '\0';
+        Size len = length();
         reserve(_count);
-        for (Size i = m_length; i < _count; ++i)
-        {
-            (*this)[i] = _c;
-        }
-        m_length = _count;
+        if (_count > len)
+            std::memset(buffer() + len, _c, _count - len);
+        setLength(_count);
     }
 
     inline void reserve(Size _count)
     {
-        if (_count <= m_capacity)
+        if (_count <= capacity())
             return;
 
-        char * old = m_cStr;
         Size s = _count + 1;
-        m_cStr = static_cast<char *>(m_allocator->allocate(s, alignof(char)).ptr);
-        // needed as allocator cannot guarantee that the memory is zeroed out
-        // TODO: Add a allocateZeroed function to allocator? Would allow us to use calloc
-        memset(m_cStr, 0, s);
-        STICK_ASSERT(m_cStr != nullptr);
-        if (old)
+        Size len = length();
+        if (!isInline())
+        {
+            // grows in place if the allocator supports it and copies at most once otherwise
+            mem::Block blk(m_heap.ptr, m_heap.capacity + 1);
+            bool bSuccess = allocator().reallocate(blk, s, alignof(char));
+            STICK_ASSERT(bSuccess);
+            STICK_UNUSED(bSuccess);
+            m_heap.ptr = static_cast<char *>(blk.ptr);
+        }
+        else
         {
-            strcpy(m_cStr, old);
-            m_allocator->deallocate({ old, m_capacity + 1 });
+            char * ptr = static_cast<char *>(allocator().allocate(s, alignof(char)).ptr);
+            STICK_ASSERT(ptr != nullptr);
+            // including the terminator
+            std::memcpy(ptr, m_inline.data, len + 1);
+            m_heap.ptr = ptr;
+            m_heap.length = len;
+            m_allocatorBits |= heapFlag;
         }
-        m_capacity = _count;
+        m_heap.capacity = _count;
     }
 
     inline Size findIndex(char _c, Size _startIndex = 0) const
     {
-        // STICK_ASSERT(_startIndex < m_length);
-        for (; _startIndex < m_length; ++_startIndex)
-        {
-            if ((*this)[_startIndex] == _c)
-                return _startIndex;
-        }
-        return InvalidIndex;
+        return StringView(*this).findIndex(_c, _startIndex);
     }
 
     inline Size rfindIndex(char _c, Size _startIndex = InvalidIndex) const
     {
-        _startIndex = _startIndex == InvalidIndex ? m_length - 1 : _startIndex;
-        // STICK_ASSERT(_startIndex < m_length);
-        for (; _startIndex > 0; --_startIndex)
-        {
-            if ((*this)[_startIndex] == _c)
-                return _startIndex;
-        }
-        return InvalidIndex;
+        return StringView(*this).rfindIndex(_c, _startIndex);
     }
 
-    inline Size findIndex(const String & _str, Size _startIndex = 0) const
+    inline Size findIndex(StringView _str, Size _startIndex = 0) const
     {
-        // STICK_ASSERT(_startIndex < m_length);
-        for (; _startIndex < m_length - _str.m_length; ++_startIndex)
-        {
-            bool bBreak = false;
-            for (Size i = 0; i < _str.m_length; ++i)
-            {
-                if (_str[i] != (*this)[_startIndex + i])
-                {
-                    bBreak = true;
-                    break;
-                }
-            }
-            if (!bBreak)
-                return _startIndex;
-        }
-        return InvalidIndex;
+        return StringView(*this).findIndex(_str, _startIndex);
     }
 
-    inline Size rfindIndex(const String & _str, Size _startIndex = InvalidIndex) const
+    inline Size rfindIndex(StringView _str, Size _startIndex = InvalidIndex) const
     {
-        _startIndex = _startIndex == InvalidIndex ? m_length - _str.m_length : _startIndex;
-        // STICK_ASSERT(_startIndex < m_length);
-        for (; _startIndex > 0; --_startIndex)
-        {
-            bool bBreak = false;
-            for (Size i = 0; i < _str.m_length; ++i)
-            {
-                if (_str[i] != (*this)[_startIndex + i])
-                {
-                    bBreak = true;
-                    break;
-                }
-            }
-            if (!bBreak)
-                return _startIndex;
-        }
-        return InvalidIndex;
+        return StringView(*this).rfindIndex(_str, _startIndex);
     }
 
     inline String sub(Size _pos, Size _length = InvalidIndex) const
@@ -494,68 +425,73 @@ class String
     inline String sub(Size _pos, Size _length, Allocator & _alloc) const
     {
         return String(begin() + _pos,
-                      _length == InvalidIndex ? begin() + m_length : begin() + _pos + _length,
+                      _length == InvalidIndex ? begin() + length() : begin() + _pos + _length,
                       _alloc);
     }
 
+    // like sub, but returns a view into this string instead of a copy
+    inline StringView view(Size _pos = 0, Size _length = InvalidIndex) const
+    {
+        return StringView(*this).sub(_pos, _length);
+    }
+
     inline Size length() const
     {
-        return m_length;
+        return isInline() ? m_inline.length : m_heap.length;
     }
 
     inline Size capacity() const
     {
-        return m_capacity;
+        return isInline() ? Size(inlineCapacity) : m_heap.capacity;
     }
 
     inline void clear()
     {
-        if (m_length)
-        {
-            memset(m_cStr, 0, m_capacity);
-            m_length = 0;
-        }
+        setLength(0);
     }
 
+    // releases the allocated memory, if any, leaving an empty string
     inline void deallocate()
     {
-        if (m_cStr)
-        {
-            m_allocator->deallocate({ m_cStr, m_capacity + 1 });
-            m_capacity = 0;
-            m_length = 0;
-            m_cStr = nullptr;
-        }
+        if (!isInline())
+            allocator().deallocate({ m_heap.ptr, m_heap.capacity + 1 });
+        initInline(allocator());
+    }
+
+    // true as long as the characters are stored inline
+    inline bool isInline() const
+    {
+        return !(m_allocatorBits & heapFlag);
     }
 
     inline Iter begin()
     {
-        return m_cStr;
+        return buffer();
     }
 
     inline ConstIter cbegin() const
     {
-        return m_cStr;
+        return buffer();
     }
 
     inline ConstIter begin() const
     {
-        return m_cStr;
+        return buffer();
     }
 
     inline Iter end()
     {
-        return m_cStr + m_length;
+        return buffer() + length();
     }
 
     inline ConstIter cend() const
     {
-        return m_cStr + m_length;
+        return buffer() + length();
     }
 
     inline ConstIter end() const
     {
-        return m_cStr + m_length;
+        return buffer() + length();
     }
 
     inline ReverseIter rbegin()
@@ -590,11 +526,11 @@ class String
 
     inline String & insert(Size _idx, Size _count, char _c)
     {
-        resize(m_length + _count);
-        Size diff = m_length - _idx - _count;
-        std::memmove(m_cStr + _idx + _count, m_cStr + _idx, diff);
+        resize(length() + _count);
+        Size diff = length() - _idx - _count;
+        std::memmove(buffer() + _idx + _count, buffer() + _idx, diff);
         for (Size i = _idx; i < _idx + _count; ++i)
-            m_cStr[i] = _c;
+            buffer()[i] = _c;
         return *this;
     }
 
@@ -605,16 +541,16 @@ class String
 
     inline String & insert(Size _idx, const char * _cStr, Size _count)
     {
-        Size diff = m_length - _idx;
-        resize(m_length + _count);
-        std::memmove(m_cStr + _idx + _count, m_cStr + _idx, diff);
-        std::memcpy(m_cStr + _idx, _cStr, _count);
+        Size diff = length() - _idx;
+        resize(length() + _count);
+        std::memmove(buffer() + _idx + _count, buffer() + _idx, diff);
+        std::memcpy(buffer() + _idx, _cStr, _count);
         return *this;
     }
 
     inline String & insert(Size _idx, const String & _other)
     {
-        return insert(_idx, _other.cString());
+        return insert(_idx, _other, 0);
     }
 
     inline String & insert(Size _idx,
@@ -623,7 +559,14 @@ class String
                            Size _otherLen = InvalidIndex)
     {
         Size len = std::min(_otherLen, _other.length() - _otherIndex);
-        return insert(_idx, _other.cString() + _otherIndex, len);
+        // growing would invalidate the characters to insert
+        if (this == &_other)
+        {
+            String tmp(
+                _other.buffer() + _otherIndex, _other.buffer() + _otherIndex + len, allocator());
+            return insert(_idx, tmp.buffer(), len);
+        }
+        return insert(_idx, _other.buffer() + _otherIndex, len);
     }
 
     inline Iter insert(ConstIter _it, char _c)
@@ -645,10 +588,10 @@ class String
     inline Iter insert(ConstIter _it, InputIter _first, InputIter _last)
     {
         Size count = std::distance(_first, _last);
-        Size off = (_it - m_cStr);
-        Size diff = m_length - off;
+        Size off = (_it - buffer());
+        Size diff = length() - off;
 
-        resize(m_length + count);
+        resize(length() + count);
 
         Iter it = begin() + off;
         std::memmove(it + count, it, diff);
@@ -663,28 +606,27 @@ class String
 
     inline const char * cString() const
     {
-        return m_cStr;
+        return buffer();
     }
 
     inline void * ptr()
     {
-        return m_cStr;
+        return buffer();
     }
 
     inline const void * ptr() const
     {
-        return m_cStr;
+        return buffer();
     }
 
     inline bool isEmpty() const
     {
-        return m_length == 0;
+        return length() == 0;
     }
 
     inline Allocator & allocator() const
     {
-        STICK_ASSERT(m_allocator);
-        return *m_allocator;
+        return *reinterpret_cast<Allocator *>(m_allocatorBits & ~heapFlag);
     }
 
     inline String toUpper() const
@@ -708,7 +650,7 @@ class String
         String ret(_alloc);
         Size len = std::snprintf(NULL, 0, "%i", _i);
         ret.resize(len);
-        std::snprintf(ret.m_cStr, len + 1, "%i", _i);
+        std::snprintf(ret.buffer(), len + 1, "%i", _i);
         return ret;
     }
 
@@ -717,7 +659,7 @@ class String
         String ret(_alloc);
         Size len = std::snprintf(NULL, 0, "%" PRId64, _i);
         ret.resize(len);
-        std::snprintf(ret.m_cStr, len + 1, "%" PRId64, _i);
+        std::snprintf(ret.buffer(), len + 1, "%" PRId64, _i);
         return ret;
     }
 
@@ -726,7 +668,7 @@ class String
         String ret(_alloc);
         Size len = std::snprintf(NULL, 0, "%u", _i);
         ret.resize(len);
-        std::snprintf(ret.m_cStr, len + 1, "%u", _i);
+        std::snprintf(ret.buffer(), len + 1, "%u", _i);
         return ret;
     }
 
@@ -735,7 +677,7 @@ class String
         String ret(_alloc);
         Size len = std::snprintf(NULL, 0, "%" PRIu64, _i);
         ret.resize(len);
-        std::snprintf(ret.m_cStr, len + 1, "%" PRIu64, _i);
+        std::snprintf(ret.buffer(), len + 1, "%" PRIu64, _i);
         return ret;
     }
 
@@ -744,7 +686,7 @@ class String
         String ret(_alloc);
         Size len = std::snprintf(NULL, 0, "%f", _i);
         ret.resize(len);
-        std::snprintf(ret.m_cStr, len + 1, "%f", _i);
+        std::snprintf(ret.buffer(), len + 1, "%f", _i);
         return ret;
     }
 
@@ -773,7 +715,7 @@ class String
 
         Size len = std::snprintf(NULL, 0, fmtString.cString(), _i);
         ret.resize(len);
-        std::snprintf(ret.m_cStr, len + 1, fmtString.cString(), _i);
+        std::snprintf(ret.buffer(), len + 1, fmtString.cString(), _i);
         return ret;
     }
 
@@ -819,17 +761,88 @@ class String
     }
 
   private:
+    // set in m_allocatorBits while the characters live in allocated memory
+    static constexpr UPtr heapFlag = 1;
+
+    struct HeapStorage
+    {
+        char * ptr;
+        Size length;
+        Size capacity;
+    };
+
+    struct InlineStorage
+    {
+        char data[inlineCapacity + 1];
+        UInt8 length;
+    };
+
+    inline void initInline(Allocator & _alloc)
+    {
+        std::memset(&m_inline, 0, sizeof(m_inline));
+        m_allocatorBits = reinterpret_cast<UPtr>(&_alloc);
+        STICK_ASSERT(!(m_allocatorBits & heapFlag));
+    }
+
+    inline char * buffer()
+    {
+        return isInline() ? m_inline.data : m_heap.ptr;
+    }
+
+    inline const char * buffer() const
+    {
+        return isInline() ? m_inline.data : m_heap.ptr;
+    }
+
+    // The length is authoritative, the characters may contain zeros. The terminator is only
+    // maintained so that cString() can be handed to C functions.
+    inline void setLength(Size _length)
+    {
+        if (isInline())
+        {
+            STICK_ASSERT(_length <= inlineCapacity);
+            m_inline.length = static_cast<UInt8>(_length);
+            // the min never changes the index, it only keeps gcc from warning about writes past
+            // the inline characters on paths it can't rule out
+            m_inline.data[min(_length, Size(inlineCapacity))] = '\0';
+        }
+        else
+        {
+            m_heap.length = _length;
+            m_heap.ptr[_length] = '\0';
+        }
+    }
+
+    // replaces the content with _count characters at _str, which must not point into this string
+    inline void assign(const char * _str, Size _count)
+    {
+        clear();
+        reserve(_count);
+        std::memcpy(buffer(), _str, _count);
+        setLength(_count);
+    }
+
     inline void preAppend(Size _newLen)
     {
-        if (m_capacity < _newLen)
+        if (capacity() < _newLen)
             reserve(_newLen * 2);
-        m_length = _newLen;
+        setLength(_newLen);
     }
 
-    char * m_cStr;
-    Size m_length;
-    Size m_capacity;
-    Allocator * m_allocator;
+    // a short string lives in the same bytes that hold the pointer, length and capacity of an
+    // allocated one
+    union
+    {
+        HeapStorage m_heap;
+        InlineStorage m_inline;
+    };
+    // the allocator pointer, its lowest bit marks heap storage
+    UPtr m_allocatorBits;
+};
+
+template <>
+struct IsTriviallyRelocatable<String> : std::true_type
+{
 };
 
 namespace detail
@@ -851,21 +864,19 @@ struct _StringCopier
         return 1;
     }
 
+    inline static Size strLen(StringView _str)
+    {
+        return _str.length();
+    }
+
     inline static int performCopy(String & _dest, Size & _off, const String & _src)
     {
-        if (_src.m_cStr)
-        {
-            strcpy(_dest.m_cStr + _off, _src.m_cStr);
-            _off += _src.length();
-        }
-        return 0;
+        return performCopy(_dest, _off, StringView(_src));
     }
 
     inline static int performCopy(String & _dest, Size & _off, const char * _src)
     {
-        strcpy(_dest.m_cStr + _off, _src);
-        _off += strlen(_src);
-        return 0;
+        return performCopy(_dest, _off, StringView(_src));
     }
 
     inline static int performCopy(String & _dest, Size & _off, char _src)
@@ -874,6 +885,16 @@ struct _StringCopier
         ++_off;
         return 0;
     }
+
+    inline static int performCopy(String & _dest, Size & _off, StringView _src)
+    {
+        if (_src.length())
+        {
+            memcpy(_dest.buffer() + _off, _src.data(), _src.length());
+            _off += _src.length();
+        }
+        return 0;
+    }
 };
 } // namespace detail
 
@@ -885,8 +906,8 @@ inline void String::append(AppendVariadicFlag _flag, Strings... _args)
     STICK_UNUSED(unpack);
     if (!len)
         return;
-    Size off = m_length;
-    preAppend(m_length + len);
+    Size off = length();
+    preAppend(length() + len);
     int unpack2[]{ 0, (detail::_StringCopier::performCopy(*this, off, _args))... };
     STICK_UNUSED(unpack2);
 }
@@ -898,7 +919,8 @@ inline String String::concatWithAllocator(Allocator & _alloc, Strings... _args)
     int unpack[]{ 0, (len += detail::_StringCopier::strLen(_args), 0)... };
     STICK_UNUSED(unpack);
     String ret(_alloc);
-    ret.resize(len);
+    ret.reserve(len);
+    ret.setLength(len);
     Size off = 0;
     int unpack2[]{ 0, (detail::_StringCopier::performCopy(ret, off, _args))... };
     STICK_UNUSED(unpack2);
@@ -912,19 +934,33 @@ inline String String::concat(Strings... _args)
     int unpack[]{ 0, (len += detail::_StringCopier::strLen(_args), 0)... };
     STICK_UNUSED(unpack);
     String ret;
-    ret.resize(len);
+    ret.reserve(len);
+    ret.setLength(len);
     Size off = 0;
     int unpack2[]{ 0, (detail::_StringCopier::performCopy(ret, off, _args))... };
     STICK_UNUSED(unpack2);
     return ret;
 }
 
+// hashes Strings, StringViews and c strings with the same content to the same value
 template <>
 struct DefaultHash<String>
 {
+    typedef void IsTransparent;
+
     Size operator()(const String & _str) const
     {
-        return detail::murmur2(_str.cString(), _str.length(), 0);
+        return hashBytes(_str.cString(), _str.length());
+    }
+
+    Size operator()(StringView _str) const
+    {
+        return DefaultHash<StringView>()(_str);
+    }
+
+    Size operator()(const char * _str) const
+    {
+        return DefaultHash<StringView>()(_str);
     }
 };
 } // namespace stick
@@ -0,0 +1,293 @@
+#ifndef STICK_STRINGBUILDER_HPP
+#define STICK_STRINGBUILDER_HPP
+
+#include <Stick/Error.hpp>
+#include <Stick/String.hpp>
+#include <new>
+
+#ifdef STICK_PLATFORM_POSIX
+#include <errno.h>
+#include <unistd.h>
+#endif // STICK_PLATFORM_POSIX
+
+namespace stick
+{
+// Assembles large texts in a chain of chunks that are allocated from its Allocator (i.e. an Arena).
+// Appending never moves what was written before, a full chunk is simply followed by a new one (or
+// grows in place if the allocator supports it). The result can be turned into a String with a
+// single allocation or written to a file descriptor without ever joining the chunks.
+class StringBuilder
+{
+  public:
+    // the size of the first chunk, every following chunk doubles it up to maxChunkSize
+    static constexpr Size defaultChunkSize = 1024;
+    static constexpr Size maxChunkSize = 1 << 16;
+
+    inline StringBuilder(Allocator & _alloc = defaultAllocator(),
+                         Size _chunkSize = defaultChunkSize) :
+        m_allocator(&_alloc),
+        m_first(nullptr),
+        m_current(nullptr),
+        m_chunkSize(_chunkSize),
+        m_length(0)
+    {
+    }
+
+    inline StringBuilder(StringBuilder && _other) :
+        m_allocator(_other.m_allocator),
+        m_first(_other.m_first),
+        m_current(_other.m_current),
+        m_chunkSize(_other.m_chunkSize),
+        m_length(_other.m_length)
+    {
+        _other.m_first = nullptr;
+        _other.m_current = nullptr;
+        _other.m_length = 0;
+    }
+
+    StringBuilder(const StringBuilder &) = delete;
+    StringBuilder & operator=(const StringBuilder &) = delete;
+
+    inline ~StringBuilder()
+    {
+        deallocate();
+    }
+
+    inline StringBuilder & operator=(StringBuilder && _other)
+    {
+        if (this != &_other)
+        {
+            deallocate();
+            m_allocator = _other.m_allocator;
+            m_first = _other.m_first;
+            m_current = _other.m_current;
+            m_chunkSize = _other.m_chunkSize;
+            m_length = _other.m_length;
+            _other.m_first = nullptr;
+            _other.m_current = nullptr;
+            _other.m_length = 0;
+        }
+        return *this;
+    }
+
+    inline void append(StringView _str)
+    {
+        const char * ptr = _str.data();
+        Size len = _str.length();
+        while (true)
+        {
+            // fill up the current chunk
+            Size n = m_current ? min(len, freeSpace(m_current)) : 0;
+            if (n)
+                write(ptr, n);
+            ptr += n;
+            len -= n;
+            if (!len)
+                return;
+
+            // the rest spills into a chunk kept by clear or a new one that fits all of it
+            if (m_current && m_current->next)
+                m_current = m_current->next;
+            else
+                makeSpace(len);
+        }
+    }
+
+    inline void append(char _c)
+    {
+        if (!m_current || !freeSpace(m_current))
+            makeSpace(1);
+        write(&_c, 1);
+    }
+
+    // Formats straight into the current chunk. Only if the result does not fit, it is formatted a
+    // second time into a chunk that is large enough.
+    template <class... Args>
+    inline void appendFormatted(const char * _fmt, Args... _args)
+    {
+        Size space = m_current ? freeSpace(m_current) : 0;
+        char * dst = m_current ? m_current->data() + m_current->length : nullptr;
+        int len = std::snprintf(dst, space, _fmt, _args...);
+        if (len <= 0)
+            return;
+
+        // snprintf needs room for the terminator, too
+        if (Size(len) >= space)
+        {
+            makeSpace(len + 1);
+            int result = std::snprintf(
+                m_current->data() + m_current->length, len + 1, _fmt, _args...);
+            STICK_ASSERT(len == result);
+            STICK_UNUSED(result);
+        }
+        m_current->length += len;
+        m_length += len;
+    }
+
+    // joins all chunks into one String
+    inline String toString(Allocator & _alloc = defaultAllocator()) const
+    {
+        String ret(_alloc);
+        ret.reserve(m_length);
+        for (const Chunk * c = m_first; c; c = c->next)
+            ret.append(c->data(), c->length);
+        return ret;
+    }
+
+#ifdef STICK_PLATFORM_POSIX
+    // writes the text chunk by chunk, without joining it first
+    inline Error writeTo(int _fd) const
+    {
+        for (const Chunk * c = m_first; c; c = c->next)
+        {
+            const char * ptr = c->data();
+            Size left = c->length;
+            while (left)
+            {
+                ssize_t written = ::write(_fd, ptr, left);
+                if (written < 0)
+                {
+                    if (errno == EINTR)
+                        continue;
+                    return Error(
+                        ec::SystemErrorCode(errno), "write failed", STICK_FILE, STICK_LINE);
+                }
+                ptr += written;
+                left -= written;
+            }
+        }
+        return Error();
+    }
+#endif // STICK_PLATFORM_POSIX
+
+    // removes the text but keeps the chunks around for reuse
+    inline void clear()
+    {
+        for (Chunk * c = m_first; c; c = c->next)
+            c->length = 0;
+        m_current = m_first;
+        m_length = 0;
+    }
+
+    // removes the text and gives all chunks back to the allocator
+    inline void deallocate()
+    {
+        Chunk * c = m_first;
+        while (c)
+        {
+            Chunk * next = c->next;
+            m_allocator->deallocate(chunkBlock(c));
+            c = next;
+        }
+        m_first = nullptr;
+        m_current = nullptr;
+        m_length = 0;
+    }
+
+    inline Size length() const
+    {
+        return m_length;
+    }
+
+    inline bool isEmpty() const
+    {
+        return m_length == 0;
+    }
+
+    inline Size chunkCount() const
+    {
+        Size ret = 0;
+        for (const Chunk * c = m_first; c; c = c->next)
+            ++ret;
+        return ret;
+    }
+
+    inline Allocator & allocator() const
+    {
+        return *m_allocator;
+    }
+
+  private:
+    // the characters directly follow the header in the same allocation
+    struct Chunk
+    {
+        Chunk * next;
+        Size capacity;
+        Size length;
+
+        inline char * data()
+        {
+            return reinterpret_cast<char *>(this + 1);
+        }
+
+        inline const char * data() const
+        {
+            return reinterpret_cast<const char *>(this + 1);
+        }
+    };
+
+    inline static Size freeSpace(const Chunk * _chunk)
+    {
+        return _chunk->capacity - _chunk->length;
+    }
+
+    inline static mem::Block chunkBlock(Chunk * _chunk)
+    {
+        return { _chunk, sizeof(Chunk) + _chunk->capacity };
+    }
+
+    // copies _count characters to the current chunk, which must have room for them
+    inline void write(const char * _str, Size _count)
+    {
+        std::memcpy(m_current->data() + m_current->length, _str, _count);
+        m_current->length += _count;
+        m_length += _count;
+    }
+
+    // makes sure that the current chunk has room for at least _count characters
+    inline void makeSpace(Size _count)
+    {
+        if (m_current && freeSpace(m_current) >= _count)
+            return;
+
+        // the last chunk can grow in place if it was the last allocation of an arena
+        if (m_current && !m_current->next)
+        {
+            mem::Block blk = chunkBlock(m_current);
+            Size delta = max(_count - freeSpace(m_current), m_chunkSize);
+            if (m_allocator->expand(blk, delta))
+            {
+                m_current->capacity += delta;
+                return;
+            }
+        }
+
+        // move on to a chunk that was kept by clear, or insert a new one if it is too small
+        Chunk * next = m_current ? m_current->next : m_first;
+        if (next && next->capacity >= _count)
+        {
+            m_current = next;
+            return;
+        }
+
+        Size capacity = max(_count, m_chunkSize);
+        m_chunkSize = min(m_chunkSize * 2, Size(maxChunkSize));
+        mem::Block blk = m_allocator->allocate(sizeof(Chunk) + capacity, alignof(Chunk));
+        STICK_ASSERT(blk);
+        Chunk * chunk = new (blk.ptr) Chunk{ next, capacity, 0 };
+        if (m_current)
+            m_current->next = chunk;
+        else
+            m_first = chunk;
+        m_current = chunk;
+    }
+
+    Allocator * m_allocator;
+    Chunk * m_first;
+    Chunk * m_current;
+    Size m_chunkSize;
+    Size m_length;
+};
+} // namespace stick
+
+#endif // STICK_STRINGBUILDER_HPP
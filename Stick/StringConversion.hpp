@@ -3,65 +3,85 @@
 
 #include <Stick/String.hpp>
 #include <stdio.h>
+#include <stdlib.h>
 
 namespace stick
 {
+namespace detail
+{
+// The C conversion functions need zero terminated strings, so short views are copied to the
+// stack. Only unreasonably long numbers have to be copied to the heap.
+template <class F>
+inline auto withCString(StringView _str, F _fn) -> decltype(_fn(""))
+{
+    char buf[64];
+    if (_str.length() < sizeof(buf))
+    {
+        std::memcpy(buf, _str.data(), _str.length());
+        buf[_str.length()] = '\0';
+        return _fn(buf);
+    }
+    String tmp(_str);
+    return _fn(tmp.cString());
+}
+} // namespace detail
+
 /**
- * @brief Converts a numeric String to an Int16.
+ * @brief Converts a numeric string to an Int16.
  */
-inline Int16 toInt16(const String & _str)
+inline Int16 toInt16(StringView _str)
 {
-    return atoi(_str.cString());
+    return detail::withCString(_str, [](const char * _s) { return atoi(_s); });
 }
 
 /**
- * @brief Converts a numeric String to an UInt16.
+ * @brief Converts a numeric string to an UInt16.
  */
-inline UInt16 toUInt16(const String & _str)
+inline UInt16 toUInt16(StringView _str)
 {
-    return atoi(_str.cString());
+    return detail::withCString(_str, [](const char * _s) { return atoi(_s); });
 }
 
 /**
- * @brief Converts a numeric String to an Int32.
+ * @brief Converts a numeric string to an Int32.
  */
-inline Int32 toInt32(const String & _str)
+inline Int32 toInt32(StringView _str)
 {
-    return atoi(_str.cString());
+    return detail::withCString(_str, [](const char * _s) { return atoi(_s); });
 }
 
 /**
- * @brief Converts a numeric String to an UInt32.
+ * @brief Converts a numeric string to an UInt32.
  */
-inline UInt32 toUInt32(const String & _str)
+inline UInt32 toUInt32(StringView _str)
 {
-    return atoi(_str.cString());
+    return detail::withCString(_str, [](const char * _s) { return atoi(_s); });
 }
 
 /**
- * @brief Converts a numeric String to an Int64.
+ * @brief Converts a numeric string to an Int64.
  */
-inline Int64 toInt64(const String & _str)
+inline Int64 toInt64(StringView _str)
 {
-    return atoll(_str.cString());
+    return detail::withCString(_str, [](const char * _s) { return atoll(_s); });
 }
 
 /**
- * @brief Converts a numeric String to an UInt64.
+ * @brief Converts a numeric string to an UInt64.
  */
-inline UInt64 toUInt64(const String & _str)
+inline UInt64 toUInt64(StringView _str)
 {
-    return atoll(_str.cString());
+    return detail::withCString(_str, [](const char * _s) { return atoll(_s); });
 }
 
-inline Float32 toFloat32(const String & _str)
+inline Float32 toFloat32(StringView _str)
 {
-    return atof(_str.cString());
+    return detail::withCString(_str, [](const char * _s) { return atof(_s); });
 }
 
-inline Float64 toFloat64(const String & _str)
+inline Float64 toFloat64(StringView _str)
 {
-    return atof(_str.cString());
+    return detail::withCString(_str, [](const char * _s) { return atof(_s); });
 }
 
 template <class T>
@@ -0,0 +1,351 @@
+#ifndef STICK_STRINGVIEW_HPP
+#define STICK_STRINGVIEW_HPP
+
+#include <Stick/Platform.hpp>
+#include <Stick/Private/StringSearch.hpp>
+
+// for string hashing
+#include <Stick/Hash.hpp>
+
+#include <cstddef>
+#include <cstring>
+#include <iterator>
+
+namespace stick
+{
+/**
+ * @brief A non owning view of a range of characters.
+ *
+ * The characters are not necessarily zero terminated. The viewed memory has to outlive the view.
+ */
+class StringView
+{
+  public:
+    typedef const char * Iter;
+    typedef const char * ConstIter;
+    typedef char ValueType;
+
+    class SplitIter;
+    class SplitRange;
+
+    static constexpr Size InvalidIndex = -1;
+
+    inline StringView() : m_data(nullptr), m_length(0)
+    {
+    }
+
+    inline StringView(const char * _str) : m_data(_str), m_length(_str ? std::strlen(_str) : 0)
+    {
+    }
+
+    inline StringView(const char * _str, Size _length) : m_data(_str), m_length(_length)
+    {
+    }
+
+    inline char operator[](Size _index) const
+    {
+        STICK_ASSERT(_index < m_length);
+        return m_data[_index];
+    }
+
+    inline bool operator==(StringView _other) const
+    {
+        return m_length == _other.m_length && compare(_other) == 0;
+    }
+
+    inline bool operator!=(StringView _other) const
+    {
+        return !(*this == _other);
+    }
+
+    inline bool operator<(StringView _other) const
+    {
+        return compare(_other) < 0;
+    }
+
+    inline bool operator>(StringView _other) const
+    {
+        return compare(_other) > 0;
+    }
+
+    inline bool operator<=(StringView _other) const
+    {
+        return compare(_other) <= 0;
+    }
+
+    inline bool operator>=(StringView _other) const
+    {
+        return compare(_other) >= 0;
+    }
+
+    // lexicographical comparison, returns a value less than, equal to or greater than zero
+    inline int compare(StringView _other) const
+    {
+        Size len = m_length < _other.m_length ? m_length : _other.m_length;
+        int ret = len ? std::memcmp(m_data, _other.m_data, len) : 0;
+        if (ret != 0)
+            return ret;
+        return m_length < _other.m_length ? -1 : (m_length > _other.m_length ? 1 : 0);
+    }
+
+    inline Size findIndex(char _c, Size _startIndex = 0) const
+    {
+        if (_startIndex >= m_length)
+            return InvalidIndex;
+        return toIndex(detail::findChar(m_data + _startIndex, m_length - _startIndex, _c));
+    }
+
+    inline Size rfindIndex(char _c, Size _startIndex = InvalidIndex) const
+    {
+        Size count = _startIndex < m_length ? _startIndex + 1 : m_length;
+        return toIndex(detail::rfindChar(m_data, count, _c));
+    }
+
+    inline Size findIndex(StringView _str, Size _startIndex = 0) const
+    {
+        if (_startIndex > m_length)
+            return InvalidIndex;
+        if (_str.isEmpty())
+            return _startIndex;
+        return toIndex(detail::findSubstring(
+            m_data + _startIndex, m_length - _startIndex, _str.m_data, _str.m_length));
+    }
+
+    // the last occurence of _str that starts at or before _startIndex
+    inline Size rfindIndex(StringView _str, Size _startIndex = InvalidIndex) const
+    {
+        if (_str.m_length > m_length)
+            return InvalidIndex;
+        Size lastStart = m_length - _str.m_length;
+        if (_str.isEmpty())
+            return _startIndex < lastStart ? _startIndex : lastStart;
+        Size count = _startIndex < lastStart ? _startIndex + 1 : lastStart + 1;
+        return toIndex(detail::rfindSubstring(m_data, count, _str.m_data, _str.m_length));
+    }
+
+    inline bool contains(StringView _str) const
+    {
+        return findIndex(_str) != InvalidIndex;
+    }
+
+    inline bool startsWith(StringView _str) const
+    {
+        return _str.m_length <= m_length && StringView(m_data, _str.m_length) == _str;
+    }
+
+    inline bool endsWith(StringView _str) const
+    {
+        return _str.m_length <= m_length &&
+               StringView(m_data + m_length - _str.m_length, _str.m_length) == _str;
+    }
+
+    // the part of the view starting at _pos, clamped to the end of the view
+    inline StringView sub(Size _pos, Size _length = InvalidIndex) const
+    {
+        if (_pos >= m_length)
+            return StringView(m_data + m_length, 0);
+        Size rest = m_length - _pos;
+        return StringView(m_data + _pos, _length < rest ? _length : rest);
+    }
+
+    // removes leading and trailing whitespace
+    inline StringView trim() const
+    {
+        return trimLeft().trimRight();
+    }
+
+    inline StringView trimLeft() const
+    {
+        Size i = 0;
+        while (i < m_length && isSpace(m_data[i]))
+            ++i;
+        return StringView(m_data + i, m_length - i);
+    }
+
+    inline StringView trimRight() const
+    {
+        Size len = m_length;
+        while (len > 0 && isSpace(m_data[len - 1]))
+            --len;
+        return StringView(m_data, len);
+    }
+
+    // Iterates over the parts between the separators without copying them, i.e.
+    // for (StringView seg : view.split('/')). Empty parts are skipped if _bSkipEmpty is true.
+    inline SplitRange split(char _separator, bool _bSkipEmpty = false) const;
+
+    inline const char * data() const
+    {
+        return m_data;
+    }
+
+    inline Size length() const
+    {
+        return m_length;
+    }
+
+    inline bool isEmpty() const
+    {
+        return m_length == 0;
+    }
+
+    inline ConstIter begin() const
+    {
+        return m_data;
+    }
+
+    inline ConstIter end() const
+    {
+        return m_data + m_length;
+    }
+
+  private:
+    inline Size toIndex(const char * _ptr) const
+    {
+        return _ptr ? Size(_ptr - m_data) : Size(InvalidIndex);
+    }
+
+    inline static bool isSpace(char _c)
+    {
+        return _c == ' ' || _c == '\t' || _c == '\n' || _c == '\r' || _c == '\f' || _c == '\v';
+    }
+
+    const char * m_data;
+    Size m_length;
+};
+
+class StringView::SplitIter
+{
+  public:
+    typedef std::forward_iterator_tag iterator_category;
+    typedef StringView value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef const StringView * pointer;
+    typedef const StringView & reference;
+
+    // the end iterator
+    inline SplitIter() : m_next(nullptr), m_end(nullptr), m_separator(0), m_bSkipEmpty(false)
+    {
+    }
+
+    inline SplitIter(StringView _str, char _separator, bool _bSkipEmpty) :
+        m_next(_str.begin()),
+        m_end(_str.end()),
+        m_separator(_separator),
+        m_bSkipEmpty(_bSkipEmpty)
+    {
+        advance();
+    }
+
+    inline const StringView & operator*() const
+    {
+        return m_current;
+    }
+
+    inline const StringView * operator->() const
+    {
+        return &m_current;
+    }
+
+    inline SplitIter & operator++()
+    {
+        advance();
+        return *this;
+    }
+
+    inline SplitIter operator++(int)
+    {
+        SplitIter ret = *this;
+        advance();
+        return ret;
+    }
+
+    inline bool operator==(const SplitIter & _other) const
+    {
+        return m_next == _other.m_next && m_current.data() == _other.m_current.data();
+    }
+
+    inline bool operator!=(const SplitIter & _other) const
+    {
+        return !(*this == _other);
+    }
+
+  private:
+    inline void advance()
+    {
+        do
+        {
+            // the last part was consumed
+            if (!m_next)
+            {
+                m_current = StringView();
+                return;
+            }
+
+            const void * sep = m_next != m_end ? std::memchr(m_next, m_separator, m_end - m_next)
+                                               : nullptr;
+            if (sep)
+            {
+                m_current = StringView(m_next, static_cast<const char *>(sep) - m_next);
+                m_next = static_cast<const char *>(sep) + 1;
+            }
+            else
+            {
+                m_current = StringView(m_next, m_end - m_next);
+                m_next = nullptr;
+            }
+        } while (m_bSkipEmpty && m_current.isEmpty());
+    }
+
+    const char * m_next;
+    const char * m_end;
+    StringView m_current;
+    char m_separator;
+    bool m_bSkipEmpty;
+};
+
+class StringView::SplitRange
+{
+  public:
+    typedef SplitIter Iter;
+    typedef SplitIter ConstIter;
+
+    inline SplitRange(StringView _str, char _separator, bool _bSkipEmpty) :
+        m_str(_str),
+        m_separator(_separator),
+        m_bSkipEmpty(_bSkipEmpty)
+    {
+    }
+
+    inline SplitIter begin() const
+    {
+        return SplitIter(m_str, m_separator, m_bSkipEmpty);
+    }
+
+    inline SplitIter end() const
+    {
+        return SplitIter();
+    }
+
+  private:
+    StringView m_str;
+    char m_separator;
+    bool m_bSkipEmpty;
+};
+
+inline StringView::SplitRange StringView::split(char _separator, bool _bSkipEmpty) const
+{
+    return SplitRange(*this, _separator, _bSkipEmpty);
+}
+
+template <>
+struct DefaultHash<StringView>
+{
+    Size operator()(StringView _str) const
+    {
+        return hashBytes(_str.data(), _str.length());
+    }
+};
+} // namespace stick
+
+#endif // STICK_STRINGVIEW_HPP
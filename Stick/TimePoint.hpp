@@ -20,7 +20,7 @@ class TimePointT
     {
     }
 
-    inline Duration operator-(const TimePointT & _b)
+    inline Duration operator-(const TimePointT & _b) const
     {
         return Duration::fromNanoseconds(m_value - _b.m_value);
     }
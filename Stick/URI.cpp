@@ -28,7 +28,7 @@ URI::~URI()
 {
 }
 
-Error URI::parse(const String & _str)
+Error URI::parse(StringView _str)
 {
     Error ret;
     parse(_str, ret);
@@ -113,15 +113,15 @@ void URI::normalize()
     m_path = path::normalize(m_path, !isRelative());
 }
 
-void URI::parse(const String & _uri, Error & _error)
+void URI::parse(StringView _uri, Error & _error)
 {
     if (_uri.isEmpty())
         return;
 
-    String::ConstIter URIEnd = _uri.end();
+    StringView::ConstIter URIEnd = _uri.end();
 
-    String::ConstIter schemeBegin = _uri.begin();
-    String::ConstIter schemeEnd = schemeBegin;
+    StringView::ConstIter schemeBegin = _uri.begin();
+    StringView::ConstIter schemeEnd = schemeBegin;
 
     // scheme must begin with an alphabetic char
     if (isalpha(*schemeBegin))
@@ -137,15 +137,13 @@ void URI::parse(const String & _uri, Error & _error)
     }
 
     // authority
-    String::ConstIter authorityBegin = schemeEnd;
-    String::ConstIter authorityEnd = schemeEnd;
+    StringView::ConstIter authorityBegin = schemeEnd;
+    StringView::ConstIter authorityEnd = schemeEnd;
     if (!m_scheme.isEmpty())
         authorityBegin += 1; // skip colon
 
-    String slashSlash(authorityBegin, authorityBegin + 2);
-
     // check if there is an authority (indicate by a double slash
-    if (slashSlash == "//")
+    if (StringView(authorityBegin, URIEnd - authorityBegin).startsWith("//"))
     {
         authorityBegin += 2; // skip authority begin ("//")
 
@@ -159,28 +157,28 @@ void URI::parse(const String & _uri, Error & _error)
         authorityEnd = authorityBegin;
 
     // path
-    String::ConstIter pathBegin = authorityEnd;
-    String::ConstIter pathEnd = findIf(authorityEnd, URIEnd, isPathEnd);
-    m_path = decode(String(pathBegin, pathEnd), _error);
+    StringView::ConstIter pathBegin = authorityEnd;
+    StringView::ConstIter pathEnd = findIf(authorityEnd, URIEnd, isPathEnd);
+    m_path = decode(StringView(pathBegin, pathEnd - pathBegin), _error);
 
     if (_error)
         return;
 
     // query
-    String::ConstIter queryEnd = pathEnd;
-    if (*pathEnd == '?')
+    StringView::ConstIter queryEnd = pathEnd;
+    if (pathEnd != URIEnd && *pathEnd == '?')
     {
         queryEnd = find(pathEnd, URIEnd, '#');
-        m_query = decode(String(pathEnd + 1, queryEnd), _error);
+        m_query = decode(StringView(pathEnd + 1, queryEnd - pathEnd - 1), _error);
 
         if (_error)
             return;
     }
 
     // fragment
-    if (*queryEnd == '#')
+    if (queryEnd != URIEnd && *queryEnd == '#')
     {
-        m_fragment = decode(String(queryEnd + 1, URIEnd), _error);
+        m_fragment = decode(StringView(queryEnd + 1, URIEnd - queryEnd - 1), _error);
 
         if (_error)
             return;
@@ -189,10 +187,10 @@ void URI::parse(const String & _uri, Error & _error)
     normalize();
 }
 
-void URI::parseAuthority(String::ConstIter _begin, String::ConstIter _end, Error & _error)
+void URI::parseAuthority(StringView::ConstIter _begin, StringView::ConstIter _end, Error & _error)
 {
     // find user info
-    String::ConstIter userInfoEnd = find(_begin, _end, '@');
+    StringView::ConstIter userInfoEnd = find(_begin, _end, '@');
     if (userInfoEnd != _end)
     {
         m_userInfo = String(_begin, userInfoEnd);
@@ -202,15 +200,15 @@ void URI::parseAuthority(String::ConstIter _begin, String::ConstIter _end, Error
         userInfoEnd = _begin;
 
     // find host
-    String::ConstIter hostBegin = userInfoEnd;
-    String::ConstIter hostEnd = _end;
-    String::ConstIter portStart;
+    StringView::ConstIter hostBegin = userInfoEnd;
+    StringView::ConstIter hostEnd = _end;
+    StringView::ConstIter portStart;
 
     // IP6
-    if (*hostBegin == '[')
+    if (hostBegin != _end && *hostBegin == '[')
     {
         hostBegin++;
-        String::ConstIter IP6end = find(hostBegin, _end, ']');
+        StringView::ConstIter IP6end = find(hostBegin, _end, ']');
 
         if (IP6end == _end)
         {
@@ -232,8 +230,7 @@ void URI::parseAuthority(String::ConstIter _begin, String::ConstIter _end, Error
     // we have a port
     if (portStart != _end)
     {
-        String port(portStart + 1, _end);
-        m_port = toUInt16(port);
+        m_port = toUInt16(StringView(portStart + 1, _end - portStart - 1));
     }
     else
     {
@@ -266,11 +263,11 @@ bool URI::isRelative() const
     return m_scheme.isEmpty();
 }
 
-String URI::encode(const String & _str, const String & _reserved) const
+String URI::encode(StringView _str, StringView _reserved) const
 {
     String ret;
     ret.reserve(64);
-    String::ConstIter it = _str.begin();
+    StringView::ConstIter it = _str.begin();
     for (; it != _str.end(); ++it)
     {
         char c = *it;
@@ -278,7 +275,7 @@ String URI::encode(const String & _str, const String & _reserved) const
         {
             ret.append(c);
         }
-        else if (_reserved.findIndex(c) != String::InvalidIndex || c <= 0x20 || c >= 0x7F)
+        else if (_reserved.findIndex(c) != StringView::InvalidIndex || c <= 0x20 || c >= 0x7F)
         {
             ret.append('%');
             ret.append(AppendVariadicFlag(), toHexString((unsigned)(UInt8)c, 2));
@@ -291,11 +288,11 @@ String URI::encode(const String & _str, const String & _reserved) const
     return ret;
 }
 
-String URI::decode(const String & _str, Error & _error) const
+String URI::decode(StringView _str, Error & _error) const
 {
     String ret;
     ret.reserve(128);
-    String::ConstIter it = _str.begin();
+    StringView::ConstIter it = _str.begin();
     for (; it != _str.end(); ++it)
     {
         char c = *it;
@@ -336,9 +333,9 @@ String URI::decode(const String & _str, Error & _error) const
                 return ret;
             }
 
-            String tmp2 = String::concat(hi, lo);
+            char hex[3] = { hi, lo, '\0' };
             errno = 0;
-            tmp = strtol(tmp2.cString(), NULL, 16);
+            tmp = strtol(hex, NULL, 16);
             if (errno != 0)
             {
                 _error = Error(
@@ -32,7 +32,7 @@ class URI
     /**
      * @brief Parse the URI from a percent encoded UTF-8 string.
      */
-    Error parse(const String & _str);
+    Error parse(StringView _str);
 
     /**
      * @brief Returns true if both URIs are equal.
@@ -141,9 +141,9 @@ class URI
     String encodedResource() const;
 
   protected:
-    void parse(const String & _uri, Error & _error);
+    void parse(StringView _uri, Error & _error);
 
-    void parseAuthority(String::ConstIter _begin, String::ConstIter _end, Error & _error);
+    void parseAuthority(StringView::ConstIter _begin, StringView::ConstIter _end, Error & _error);
 
     static bool isAuthorityEnd(char _c);
 
@@ -153,9 +153,9 @@ class URI
 
     static bool isUnreservedChar(char _c);
 
-    String encode(const String & _str, const String & _reserved) const;
+    String encode(StringView _str, StringView _reserved) const;
 
-    String decode(const String & _str, Error & _error) const;
+    String decode(StringView _str, Error & _error) const;
 
   private:
     String m_scheme;
@@ -179,7 +179,7 @@ struct DefaultHash<URI>
         //@TODO: this is slow
         //@TODO: Take allocator into account
         String str = toString(_uri);
-        return detail::murmur2(str.cString(), str.length(), 0);
+        return hashBytes(str.cString(), str.length());
     }
 };
 } // namespace stick
@@ -112,6 +112,12 @@ inline UniquePtr<T, DefaultCleanup<T>> makeUnique(Allocator & _alloc, Args &&...
     return UniquePtr<T, C>(_alloc.create<T>(std::forward<Args>(_args)...), C(_alloc));
 }
 
+// relocating only moves the pointer and the cleanup
+template <class T, class C>
+struct IsTriviallyRelocatable<UniquePtr<T, C>> : IsTriviallyRelocatable<C>
+{
+};
+
 template <class T, class... Args>
 inline UniquePtr<T, DefaultCleanup<T>> makeUnique(Args &&... _args)
 {
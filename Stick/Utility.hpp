@@ -53,6 +53,29 @@ bool hasFields(T _mask, T _fields)
     return (_mask & _fields) == _fields;
 }
 
+// True for types whose objects can be moved to a different address by copying their bytes,
+// without calling the move constructor and the destructor of the source. Trivially copyable types
+// always are, other types that do not point into themselves can opt in by specializing this.
+template <class T>
+struct IsTriviallyRelocatable : std::integral_constant<bool, std::is_trivially_copyable<T>::value>
+{
+};
+
+// True if any of Args is T itself (ignoring references and cv qualifiers), i.e. to find out if the
+// arguments passed to a container's emplace function could be one of its elements.
+template <class T, class... Args>
+struct IsSameAsAny : std::false_type
+{
+};
+
+template <class T, class A, class... Args>
+struct IsSameAsAny<T, A, Args...>
+    : std::integral_constant<bool,
+                             std::is_same<T, typename std::decay<A>::type>::value ||
+                                 IsSameAsAny<T, Args...>::value>
+{
+};
+
 template <class T>
 inline T min(const T & _a, const T & _b)
 {
@@ -1,14 +1,22 @@
 #include <Stick/ArgumentParser.hpp>
 #include <Stick/String.hpp>
+#include <Stick/StringView.hpp>
+#include <Stick/StringBuilder.hpp>
 #include <Stick/DynamicArray.hpp>
+#include <Stick/SmallDynamicArray.hpp>
 #include <Stick/RBTree.hpp>
 #include <Stick/Map.hpp>
+#include <Stick/BTreeMap.hpp>
 #include <Stick/FixedArray.hpp>
+#include <Stick/FlatHashMap.hpp>
+#include <Stick/FlatMap.hpp>
 #include <Stick/HashMap.hpp>
 #include <Stick/Error.hpp>
 #include <Stick/EventForwarder.hpp>
 #include <Stick/Thread.hpp>
 #include <Stick/ConditionVariable.hpp>
+#include <Stick/ConcurrentAllocator.hpp>
+#include <Stick/ConcurrentHashMap.hpp>
 #include <Stick/HighResolutionClock.hpp>
 #include <Stick/SystemClock.hpp>
 #include <Stick/Test.hpp>
@@ -28,11 +36,17 @@
 #include <Stick/Allocators/LinearAllocator.hpp>
 #include <Stick/Allocators/GlobalAllocator.hpp>
 #include <Stick/Allocators/Mallocator.hpp>
+#include <Stick/Allocators/MmapAllocator.hpp>
 #include <Stick/Allocators/PoolAllocator.hpp>
 #include <Stick/Allocators/FallbackAllocator.hpp>
 #include <Stick/Allocators/FreeListAllocator.hpp>
 #include <Stick/Allocators/Bucketizer.hpp>
+#include <Stick/Allocators/ChunkRegistry.hpp>
+#include <Stick/Allocators/ConcurrentPoolAllocator.hpp>
 #include <Stick/Allocators/Segregator.hpp>
+#include <Stick/Allocators/SegregatedFreeListAllocator.hpp>
+#include <Stick/Allocators/StatsAllocator.hpp>
+#include <Stick/Allocators/ThreadCachingAllocator.hpp>
 
 #include <limits>
 #include <atomic>
@@ -145,6 +159,85 @@ struct DestructorTester
 
 int DestructorTester::destructionCount = 0;
 
+struct CopyCounter
+{
+    static int copyCount;
+    static int moveCount;
+
+    CopyCounter(Int32 _a = 0, Int32 _b = 0) : value(_a + _b)
+    {
+    }
+
+    CopyCounter(const CopyCounter & _other) : value(_other.value)
+    {
+        ++copyCount;
+    }
+
+    CopyCounter(CopyCounter && _other) : value(_other.value)
+    {
+        ++moveCount;
+    }
+
+    CopyCounter & operator=(const CopyCounter & _other)
+    {
+        value = _other.value;
+        ++copyCount;
+        return *this;
+    }
+
+    CopyCounter & operator=(CopyCounter && _other)
+    {
+        value = _other.value;
+        ++moveCount;
+        return *this;
+    }
+
+    static void reset()
+    {
+        copyCount = 0;
+        moveCount = 0;
+    }
+
+    Int32 value;
+};
+
+int CopyCounter::copyCount = 0;
+int CopyCounter::moveCount = 0;
+
+// allocates from its destructor, which runs after the thread cache of concurrentAllocator() is
+// gone if it was constructed before the cache
+struct LateAllocator
+{
+    ~LateAllocator()
+    {
+        mem::Block blk = concurrentAllocator().allocate(8, 8);
+        bWorked = blk && blk.size == 8;
+        concurrentAllocator().deallocate(blk);
+        mem::Block blk2 = concurrentAllocator().allocate(8, 8);
+        bWorked = bWorked && blk2.ptr == blk.ptr;
+        concurrentAllocator().deallocate(blk2);
+    }
+
+    static std::atomic<bool> bWorked;
+};
+
+std::atomic<bool> LateAllocator::bWorked(false);
+
+// parent allocator that is always out of memory
+struct FailingAllocator
+{
+    static constexpr Size alignment = 8;
+
+    mem::Block allocate(Size, Size)
+    {
+        return { nullptr, 0 };
+    }
+
+    void deallocate(const mem::Block &)
+    {
+    }
+};
+
 
 struct ResultTestClass
 {
@@ -226,6 +319,19 @@ struct NoMove
     NoMove & operator = (NoMove && _other) = delete;
 };
 
+// can neither be copied nor moved, only constructed in place
+struct Pinned
+{
+    Pinned(Int32 _value = 0) : value(_value)
+    {
+    }
+
+    Pinned(const Pinned &) = delete;
+    Pinned & operator = (const Pinned &) = delete;
+
+    Int32 value;
+};
+
 class A
 {
 public:
@@ -305,8 +411,8 @@ const Suite spec[] =
         EXPECT(e != d);
 
         String f;
-        f.reserve(20);
-        EXPECT(f.capacity() == 20);
+        f.reserve(40);
+        EXPECT(f.capacity() == 40);
         EXPECT(f.length() == 0);
 
         String ff("bla");
@@ -390,8 +496,8 @@ const Suite spec[] =
             EXPECT(m[6] == 't');
             EXPECT(m[7] == 'c');
 
-            String n(12);
-            EXPECT(n.capacity() == 12);
+            String n(32);
+            EXPECT(n.capacity() == 32);
         }
         {
             //find tests
@@ -421,6 +527,57 @@ const Suite spec[] =
             i = a.rfindIndex("World!");
             EXPECT(i == 6);
         }
+        {
+            // long strings go through the vectorized search, compare it to a naive one
+            String hay;
+            for (Size i = 0; i < 700; ++i)
+                hay.append(static_cast<char>('a' + (i * 7 + i / 13) % 5));
+            hay.append("needle");
+            auto naiveFind = [&](const char * _needle, Size _start) {
+                Size len = strlen(_needle);
+                for (Size i = _start; i + len <= hay.length(); ++i)
+                {
+                    if (std::memcmp(hay.cString() + i, _needle, len) == 0)
+                        return i;
+                }
+                return Size(String::InvalidIndex);
+            };
+            auto naiveRFind = [&](const char * _needle) {
+                Size len = strlen(_needle);
+                for (Size i = hay.length() - len + 1; i > 0; --i)
+                {
+                    if (std::memcmp(hay.cString() + i - 1, _needle, len) == 0)
+                        return i - 1;
+                }
+                return Size(String::InvalidIndex);
+            };
+            const char * needles[] = { "ab",   "cde", "eab",  "needle", "edle",
+                                       "e",    "aaaa", "x",   "dle",
+                                       "abcdeabcdeabcdeabcdeabcdeabcdeabcde" };
+            bool bAllMatch = true;
+            for (const char * needle : needles)
+            {
+                for (Size start = 0; start < hay.length(); start += 37)
+                    bAllMatch = bAllMatch && hay.findIndex(needle, start) == naiveFind(needle, start);
+                bAllMatch = bAllMatch && hay.rfindIndex(needle) == naiveRFind(needle);
+            }
+            EXPECT(bAllMatch);
+            EXPECT(hay.findIndex("needle") == 700);
+            EXPECT(hay.findIndex('n') == 700);
+            EXPECT(hay.rfindIndex('e') == 705);
+            EXPECT(hay.findIndex("needle!") == String::InvalidIndex);
+
+            // equality looks at the length first and doesn't stop at the first terminator
+            String other = hay;
+            EXPECT(other == hay);
+            other[350] = 'z';
+            EXPECT(other != hay);
+            other[350] = hay[350];
+            other.append('x');
+            EXPECT(other != hay);
+            EXPECT(String() == nullptr);
+            EXPECT(String("a") != nullptr);
+        }
         {
             //substring tests
             String a("What's Up!");
@@ -455,6 +612,19 @@ const Suite spec[] =
             w.appendFormatted(" Wow, does this work? %i %.3f", 2567, 3.564f);
             EXPECT(w.length() == 45);
             EXPECT(w == "Hello World!! Wow, does this work? 2567 3.564");
+
+            // fits into the spare capacity
+            String f;
+            f.reserve(64);
+            f.appendFormatted("%i-%s", 12, "ab");
+            EXPECT(f == "12-ab");
+            EXPECT(f.capacity() == 64);
+            f.appendFormatted("%s", "");
+            EXPECT(f.length() == 5);
+            // has to grow
+            String g("abc");
+            g.appendFormatted("%s %s", "0123456789012345678901234567890", "end");
+            EXPECT(g == "abc0123456789012345678901234567890 end");
         }
 
         //insertion tests
@@ -544,6 +714,316 @@ const Suite spec[] =
             EXPECT(s3 == "loWo");
             EXPECT(it == s3.end());
         }
+        {
+            // short strings are stored inline
+            if (sizeof(void *) == 8)
+                EXPECT(sizeof(String) == 32);
+
+            TrackingAllocator alloc;
+            String a("0123456789012345678901", alloc);
+            EXPECT(a.length() == String::inlineCapacity);
+            EXPECT(a.isInline());
+            EXPECT(a.capacity() == String::inlineCapacity);
+            String b(a);
+            String c(std::move(b));
+            EXPECT(c == a);
+            EXPECT(b.isEmpty());
+            EXPECT(b.cString()[0] == 0);
+            EXPECT(&c.allocator() == &alloc);
+            c = "x";
+            c.append('y');
+            EXPECT(c == "xy");
+            EXPECT(alloc.snapshot().allocationCount == 0);
+
+            // and move to the allocator once they grow past inlineCapacity
+            a.append('2');
+            EXPECT(!a.isInline());
+            EXPECT(a == "01234567890123456789012");
+            EXPECT(alloc.snapshot().allocationCount == 1);
+            EXPECT(&a.allocator() == &alloc);
+            String d(std::move(a));
+            EXPECT(!d.isInline());
+            EXPECT(a.isInline());
+            EXPECT(a.isEmpty());
+            EXPECT(d.length() == 23);
+            a = d;
+            EXPECT(a == d);
+            EXPECT(a.cString() != d.cString());
+            d.deallocate();
+            EXPECT(d.isInline());
+            EXPECT(d.isEmpty());
+            a.clear();
+            EXPECT(a.isEmpty());
+            EXPECT(a.capacity() >= 23);
+            a = "short";
+            EXPECT(a == "short");
+            String e("abc");
+            e = e;
+            EXPECT(e == "abc");
+        }
+        {
+            // the length is authoritative, zero characters are just characters
+            const char bytes[] = { 'a', '\0', 'b', '\0', 'c' };
+            String bin(StringView(bytes, 5));
+            EXPECT(bin.length() == 5);
+            EXPECT(bin != "a");
+            EXPECT(bin > "a");
+            EXPECT(bin == StringView(bytes, 5));
+            String copy(bin);
+            EXPECT(copy.length() == 5);
+            EXPECT(copy == bin);
+            copy[4] = 'd';
+            EXPECT(copy != bin);
+            EXPECT(bin < copy);
+
+            String big(StringView("0123456789012345678901234567890123456789"));
+            big.append(bin);
+            EXPECT(big.length() == 45);
+            EXPECT(big.view(40) == bin);
+            big.append(big);
+            EXPECT(big.length() == 90);
+            EXPECT(big.view(85) == bin);
+            EXPECT(big.cString()[90] == '\0');
+
+            String cat = String::concat(bin, "x", bin);
+            EXPECT(cat.length() == 11);
+            EXPECT(cat.view(0, 5) == bin);
+            EXPECT(cat[5] == 'x');
+            EXPECT(cat.view(6) == bin);
+
+            cat.insert(1, bin);
+            EXPECT(cat.length() == 16);
+            EXPECT(cat.view(1, 5) == bin);
+            EXPECT(cat.findIndex('x') == 10);
+            cat.insert(0, cat, 6, 5);
+            EXPECT(cat.length() == 21);
+            EXPECT(cat.view(0, 5) == StringView("\0b\0cx", 5));
+
+            String r;
+            r.resize(3);
+            EXPECT(r.length() == 3 && r[0] == 0 && r[2] == 0);
+            r.resize(40, 'z');
+            EXPECT(r.length() == 40 && r[3] == 'z' && r[39] == 'z');
+            r.resize(4);
+            EXPECT(r.length() == 4 && r.cString()[4] == '\0');
+            r.clear();
+            EXPECT(r.isEmpty() && r.cString()[0] == '\0');
+        }
+    },
+    SUITE("StringView Tests")
+    {
+        StringView empty;
+        EXPECT(empty.isEmpty());
+        EXPECT(empty.length() == 0);
+        EXPECT(empty == "");
+        EXPECT(empty == String());
+
+        const char * str = "Hello World";
+        StringView a(str);
+        EXPECT(a.length() == 11);
+        EXPECT(a[4] == 'o');
+        StringView b(str, 5);
+        EXPECT(b.length() == 5);
+        EXPECT(b == "Hello");
+        EXPECT(b != a);
+        EXPECT(b < a);
+        EXPECT(a > b);
+        EXPECT(StringView("abc") < StringView("abd"));
+        EXPECT(StringView(str + 6, 5) == "World");
+
+        String s("Hello");
+        EXPECT(s == b);
+        EXPECT(b == s);
+        EXPECT(s != a);
+        EXPECT(s < a);
+        StringView fromString = s;
+        EXPECT(fromString.data() == s.cString());
+        EXPECT(fromString.length() == 5);
+
+        Size count = 0;
+        for (char c : b)
+        {
+            STICK_UNUSED(c);
+            count++;
+        }
+        EXPECT(count == 5);
+
+        // Strings, views and c strings with the same content hash the same
+        DefaultHash<String> hasher;
+        EXPECT(hasher(s) == hasher(b));
+        EXPECT(hasher(s) == hasher("Hello"));
+        EXPECT(hasher(s) == DefaultHash<StringView>()(b));
+        EXPECT(hasher(String()) == hasher(StringView()));
+
+        // heterogeneous lookups
+        HashMap<String, Int32> hm;
+        hm["Hello"] = 1;
+        hm["World"] = 2;
+        EXPECT(hm.find(b)->value == 1);
+        EXPECT(hm.find(StringView(str + 6, 5))->value == 2);
+        EXPECT(hm.find("World")->value == 2);
+        EXPECT(hm.find(StringView(str, 4)) == hm.end());
+        const HashMap<String, Int32> & chm = hm;
+        EXPECT(chm.find(b)->value == 1);
+
+        FlatHashMap<String, Int32> fhm;
+        fhm["Hello"] = 1;
+        fhm["World"] = 2;
+        EXPECT(fhm.find(b)->value == 1);
+        EXPECT(fhm.find("World")->value == 2);
+        EXPECT(fhm.find(StringView(str, 4)) == fhm.end());
+
+        Map<String, Int32> m;
+        m["Hello"] = 1;
+        m["World"] = 2;
+        m["Abc"] = 3;
+        EXPECT(m.find(b)->value == 1);
+        EXPECT(m.find("World")->value == 2);
+        EXPECT(m.find(StringView("Abc"))->value == 3);
+        EXPECT(m.find(StringView(str, 4)) == m.end());
+
+        // searching
+        EXPECT(a.findIndex('o') == 4);
+        EXPECT(a.findIndex('o', 5) == 7);
+        EXPECT(a.findIndex('x') == StringView::InvalidIndex);
+        EXPECT(a.rfindIndex('o') == 7);
+        EXPECT(a.rfindIndex('o', 6) == 4);
+        EXPECT(a.rfindIndex('H') == 0);
+        EXPECT(a.findIndex("World") == 6);
+        EXPECT(a.findIndex("lo") == 3);
+        EXPECT(a.findIndex("ld") == 9);
+        EXPECT(a.findIndex("lo", 4) == StringView::InvalidIndex);
+        EXPECT(a.findIndex("World!") == StringView::InvalidIndex);
+        EXPECT(a.rfindIndex("l") == 9);
+        EXPECT(a.rfindIndex("He") == 0);
+        EXPECT(a.contains("o W"));
+        EXPECT(!empty.contains("a"));
+        EXPECT(a.startsWith("Hell"));
+        EXPECT(!a.startsWith("World"));
+        EXPECT(a.endsWith("World"));
+        EXPECT(!b.endsWith("Hello World"));
+        EXPECT(a.sub(6) == "World");
+        EXPECT(a.sub(2, 3) == "llo");
+        EXPECT(a.sub(8, 100) == "rld");
+        EXPECT(a.sub(20).isEmpty());
+        EXPECT(s.view(1, 3) == "ell");
+        EXPECT(s.view(1, 3).data() == s.cString() + 1);
+
+        // trimming
+        StringView padded(" \t foo bar \n");
+        EXPECT(padded.trim() == "foo bar");
+        EXPECT(padded.trimLeft() == "foo bar \n");
+        EXPECT(padded.trimRight() == " \t foo bar");
+        EXPECT(StringView("   ").trim().isEmpty());
+
+        // splitting
+        StringView csv("a,bc,,d");
+        const char * expected[] = { "a", "bc", "", "d" };
+        Size idx = 0;
+        for (StringView tok : csv.split(','))
+        {
+            EXPECT(idx < 4 && tok == expected[idx]);
+            EXPECT(tok.isEmpty() || (tok.data() >= csv.begin() && tok.end() <= csv.end()));
+            ++idx;
+        }
+        EXPECT(idx == 4);
+        idx = 0;
+        for (StringView tok : csv.split(',', true))
+        {
+            EXPECT(!tok.isEmpty());
+            ++idx;
+        }
+        EXPECT(idx == 3);
+        idx = 0;
+        for (StringView tok : StringView(",,").split(',', true))
+        {
+            STICK_UNUSED(tok);
+            ++idx;
+        }
+        EXPECT(idx == 0);
+        idx = 0;
+        for (StringView tok : StringView("abc").split(','))
+        {
+            EXPECT(tok == "abc");
+            ++idx;
+        }
+        EXPECT(idx == 1);
+
+        String joined = String::concat(StringView("abc", 2), '-', s.view(3));
+        EXPECT(joined == "ab-lo");
+        String fromView(StringView("abcdef", 3));
+        EXPECT(fromView == "abc");
+        fromView.append(StringView("defg", 2));
+        EXPECT(fromView == "abcde");
+    },
+    SUITE("StringBuilder Tests")
+    {
+        StringBuilder empty;
+        EXPECT(empty.isEmpty());
+        EXPECT(empty.chunkCount() == 0);
+        EXPECT(empty.toString() == "");
+
+        TrackingAllocator alloc;
+        {
+            StringBuilder sb(alloc, 16);
+            String expected;
+            for (Int32 i = 0; i < 100; ++i)
+            {
+                sb.append("line ");
+                sb.appendFormatted("%i: %s", i, "some text that is longer than a chunk");
+                sb.append('\n');
+                expected.appendFormatted(
+                    "line %i: %s\n", i, "some text that is longer than a chunk");
+            }
+            EXPECT(sb.length() == expected.length());
+            EXPECT(sb.toString() == expected);
+            EXPECT(sb.chunkCount() > 1);
+            EXPECT(sb.chunkCount() == alloc.snapshot().allocationCount);
+
+            // chunks are reused after clearing
+            Size chunks = sb.chunkCount();
+            sb.clear();
+            EXPECT(sb.isEmpty());
+            EXPECT(sb.toString() == "");
+            sb.append(StringView(expected));
+            EXPECT(sb.toString() == expected);
+            EXPECT(sb.chunkCount() == chunks);
+
+            StringBuilder moved(std::move(sb));
+            EXPECT(sb.isEmpty());
+            EXPECT(moved.length() == expected.length());
+            moved.deallocate();
+            EXPECT(moved.chunkCount() == 0);
+        }
+        EXPECT(alloc.snapshot().allocationCount == alloc.snapshot().deallocationCount);
+
+        {
+            // the last chunk grows in place if the allocator can expand it
+            Arena arena;
+            StringBuilder sb(arena, 64);
+            for (Int32 i = 0; i < 100; ++i)
+                sb.appendFormatted("%08i", i);
+            EXPECT(sb.length() == 800);
+            EXPECT(sb.chunkCount() == 1);
+            String str = sb.toString();
+            EXPECT(str.view(0, 16) == "0000000000000001");
+            EXPECT(str.view(792) == "00000099");
+        }
+
+        {
+            int fds[2];
+            EXPECT(pipe(fds) == 0);
+            StringBuilder sb(defaultAllocator(), 8);
+            sb.append("written ");
+            sb.append("in chunks");
+            EXPECT(!sb.writeTo(fds[1]));
+            close(fds[1]);
+            char buf[64];
+            ssize_t n = read(fds[0], buf, sizeof(buf));
+            close(fds[0]);
+            EXPECT(n == 17);
+            EXPECT(StringView(buf, n) == "written in chunks");
+        }
     },
     SUITE("String Conversion Tests")
     {
@@ -568,6 +1048,13 @@ const Suite spec[] =
         EXPECT(toInt64("1234") == 1234);
         EXPECT(toInt64("-1234") == -1234);
         EXPECT(toInt16("-255") == -255);
+
+        // views don't have to be zero terminated
+        StringView numbers("12,-7,3.5");
+        EXPECT(toInt32(numbers.sub(0, 2)) == 12);
+        EXPECT(toInt64(numbers.sub(3, 2)) == -7);
+        EXPECT(toFloat64(numbers.sub(6)) == 3.5);
+        EXPECT(toUInt16(String("8080")) == 8080);
     },
     SUITE("Maybe Tests")
     {
@@ -925,6 +1412,186 @@ const Suite spec[] =
         EXPECT(sb[0] == 1);
         EXPECT(sb[1] == 2);
         EXPECT(sb[2] == 3);
+
+        // our own types are moved bitwise when the array grows or shifts its elements
+        EXPECT(IsTriviallyRelocatable<Int32>::value);
+        EXPECT(IsTriviallyRelocatable<String>::value);
+        EXPECT(IsTriviallyRelocatable<UniquePtr<Int32>>::value);
+        EXPECT(IsTriviallyRelocatable<SharedPtr<Int32>>::value);
+        EXPECT(IsTriviallyRelocatable<DynamicArray<String>>::value);
+        using SmallArray = SmallDynamicArray<Int32, 2>;
+        EXPECT(!IsTriviallyRelocatable<SmallArray>::value);
+
+        DynamicArray<String> strings;
+        for (Int32 i = 0; i < 100; ++i)
+            strings.append(toString(i));
+        strings.insert(strings.begin() + 10, "a");
+        String bc[] = { "b", "c" };
+        strings.insert(strings.begin(), bc, bc + 2);
+        strings.remove(strings.begin() + 50, strings.begin() + 60);
+        strings.remove(strings.begin());
+        EXPECT(strings.count() == 92);
+        EXPECT(strings[0] == "c");
+        EXPECT(strings[1] == "0");
+        EXPECT(strings[11] == "a");
+        EXPECT(strings[12] == "10");
+        EXPECT(strings.last() == "99");
+
+        DestructorTester::reset();
+        {
+            DynamicArray<UniquePtr<DestructorTester>> ptrs;
+            for (Int32 i = 0; i < 10; ++i)
+                ptrs.append(makeUnique<DestructorTester>());
+            ptrs.insert(ptrs.begin(), makeUnique<DestructorTester>());
+            EXPECT(DestructorTester::destructionCount == 0);
+            ptrs.remove(ptrs.begin() + 2, ptrs.begin() + 5);
+            EXPECT(DestructorTester::destructionCount == 3);
+        }
+        EXPECT(DestructorTester::destructionCount == 11);
+
+        // emplacing constructs the elements in place
+        {
+            CopyCounter::reset();
+            DynamicArray<CopyCounter> counters;
+            counters.reserve(4);
+            CopyCounter & c = counters.emplaceBack(1, 2);
+            EXPECT(c.value == 3);
+            counters.emplaceBack();
+            EXPECT(CopyCounter::copyCount == 0);
+            EXPECT(CopyCounter::moveCount == 0);
+            auto eit = counters.emplace(counters.begin() + 1, 5);
+            EXPECT(eit->value == 5);
+            EXPECT(counters.count() == 3);
+            EXPECT(counters[2].value == 0);
+            EXPECT(CopyCounter::copyCount == 0);
+            // only the element behind the new one was moved
+            EXPECT(CopyCounter::moveCount == 1);
+
+            // an element of the array itself is copied before the gap is opened
+            counters.emplace(counters.begin(), counters[1]);
+            EXPECT(counters[0].value == 5);
+            EXPECT(counters[2].value == 5);
+            EXPECT(counters.count() == 4);
+            CopyCounter::reset();
+
+            // growing past the capacity
+            for (Int32 i = 0; i < 10; ++i)
+                counters.emplaceBack(i);
+            EXPECT(counters.last().value == 9);
+            EXPECT(CopyCounter::copyCount == 0);
+
+            const char * abc = "abc";
+            DynamicArray<String> strings;
+            strings.emplaceBack(abc, abc + 2);
+            EXPECT(strings[0] == "ab");
+        }
+    },
+    SUITE("SmallDynamicArray Tests")
+    {
+        TrackingAllocator alloc;
+        SmallDynamicArray<Int32, 4> a(alloc);
+        EXPECT(a.count() == 0);
+        EXPECT(a.capacity() == 4);
+        EXPECT(a.isInline());
+
+        // the first elements never touch the allocator
+        a.append(1);
+        a.append(2);
+        a.append({ 3, 4 });
+        EXPECT(a.count() == 4);
+        EXPECT(a.isInline());
+        EXPECT(alloc.snapshot().allocationCount == 0);
+
+        a.append(5);
+        EXPECT(!a.isInline());
+        EXPECT(a.capacity() >= 5);
+        EXPECT(alloc.snapshot().allocationCount == 1);
+        for (Int32 i = 0; i < 5; ++i)
+            EXPECT(a[i] == i + 1);
+
+        a.insert(a.begin() + 1, 10);
+        EXPECT(a.count() == 6);
+        EXPECT(a[0] == 1);
+        EXPECT(a[1] == 10);
+        EXPECT(a[2] == 2);
+        EXPECT(a.last() == 5);
+
+        auto it = a.remove(a.begin() + 1);
+        EXPECT(*it == 2);
+        a.remove(a.begin(), a.begin() + 2);
+        EXPECT(a.count() == 3);
+        EXPECT(a.first() == 3);
+
+        // moving steals the allocated memory
+        SmallDynamicArray<Int32, 4> b(std::move(a));
+        EXPECT(b.count() == 3);
+        EXPECT(!b.isInline());
+        EXPECT(a.count() == 0);
+        EXPECT(a.isInline());
+        EXPECT(alloc.snapshot().allocationCount == 1);
+
+        b.deallocate();
+        EXPECT(b.isInline());
+        EXPECT(b.capacity() == 4);
+
+        SmallDynamicArray<Int32, 4> c = { 1, 2, 3 };
+        SmallDynamicArray<Int32, 4> d = c;
+        EXPECT(d.count() == 3);
+        EXPECT(d.isInline());
+        EXPECT(d[2] == 3);
+        d = std::move(c);
+        EXPECT(d.count() == 3);
+        EXPECT(c.count() == 0);
+
+        Int32 sum = 0;
+        for (auto v : d)
+            sum += v;
+        EXPECT(sum == 6);
+
+        d.resize(8, 1);
+        EXPECT(d.count() == 8);
+        EXPECT(d[7] == 1);
+        d.resize(2);
+        EXPECT(d.count() == 2);
+
+        // non trivial elements
+        {
+            SmallDynamicArray<String, 2> strings;
+            strings.append("a");
+            strings.append("b");
+            strings.append(strings[0]);
+            strings.insert(strings.begin(), "c");
+            EXPECT(strings.count() == 4);
+            EXPECT(strings[0] == "c");
+            EXPECT(strings[3] == "a");
+            SmallDynamicArray<String, 2> moved(std::move(strings));
+            EXPECT(moved[1] == "a");
+
+            CopyCounter::reset();
+            SmallDynamicArray<CopyCounter, 4> counters;
+            counters.emplaceBack(1);
+            counters.emplaceBack(2);
+            counters.emplace(counters.begin() + 1, 3, 4);
+            EXPECT(counters[1].value == 7);
+            EXPECT(counters[2].value == 2);
+            EXPECT(CopyCounter::copyCount == 0);
+            EXPECT(CopyCounter::moveCount == 1);
+            counters.emplace(counters.begin(), counters[2]);
+            EXPECT(counters[0].value == 2);
+            EXPECT(counters[3].value == 2);
+
+            DestructorTester::reset();
+            {
+                SmallDynamicArray<UniquePtr<DestructorTester>, 2> ptrs;
+                ptrs.append(makeUnique<DestructorTester>());
+                SmallDynamicArray<UniquePtr<DestructorTester>, 2> ptrs2(std::move(ptrs));
+                ptrs2.append(makeUnique<DestructorTester>());
+                ptrs2.append(makeUnique<DestructorTester>());
+                ptrs2.removeLast();
+                EXPECT(DestructorTester::destructionCount == 1);
+            }
+            EXPECT(DestructorTester::destructionCount == 3);
+        }
     },
     SUITE("Path tests")
     {
@@ -985,6 +1652,39 @@ const Suite spec[] =
         EXPECT(dirdir == "/foo/bar");
         String dir = path::directoryName(dirdir);
         EXPECT(dir == "/foo");
+
+        // views into the path
+        StringView viewPath("../bar/foo.tar.gz");
+        EXPECT(path::directoryNameView(viewPath) == "../bar");
+        EXPECT(path::fileNameView(viewPath) == "foo.tar.gz");
+        EXPECT(path::fileNameView(viewPath).data() == viewPath.data() + 7);
+        EXPECT(path::extensionView(viewPath) == ".gz");
+        path::SplitViewResult svr = path::splitView("foo");
+        EXPECT(svr.left == "foo");
+        EXPECT(svr.right.isEmpty());
+        svr = path::splitExtensionView("../bar/foo.tar.gz");
+        EXPECT(svr.left == "../bar/foo.tar");
+        EXPECT(svr.right == ".gz");
+        EXPECT(path::extensionView(".bashrc").isEmpty());
+
+        TrackingAllocator segAlloc;
+        StringViewArray viewSegs(segAlloc);
+        path::segments("//foo/bar//baz/", viewSegs);
+        EXPECT(viewSegs.count() == 3);
+        EXPECT(viewSegs[0] == "foo");
+        EXPECT(viewSegs[1] == "bar");
+        EXPECT(viewSegs[2] == "baz");
+        EXPECT(segAlloc.snapshot().allocationCount == 0);
+
+        //only the result of normalize is allocated
+        String longPath("/usr/local/share/../lib/./stick/tests/data/images/../fonts/regular.ttf");
+        String normalized = path::normalize(longPath, true, segAlloc);
+        EXPECT(normalized == "/usr/local/lib/stick/tests/data/fonts/regular.ttf");
+        EXPECT(segAlloc.snapshot().allocationCount == 1);
+
+        EXPECT(path::isRelative(""));
+        EXPECT(path::isAbsolute(StringView("/foo")));
+        EXPECT(path::normalize("/foo/../bar/./baz/") == "/bar/baz/");
     },
     SUITE("URITests")
     {
@@ -1329,6 +2029,309 @@ const Suite spec[] =
         EXPECT(copy2.count() == 2);
         EXPECT(copy2["arr"] == 5);
         EXPECT(copy2["gh"] == 6);
+
+        // tryEmplace constructs the value in place and leaves existing ones alone
+        {
+            CopyCounter::reset();
+            Map<String, CopyCounter> cmap;
+            auto eres = cmap.tryEmplace("a", 1, 2);
+            EXPECT(eres.inserted);
+            EXPECT(eres.iterator->value.value == 3);
+            eres = cmap.tryEmplace("a", 5);
+            EXPECT(!eres.inserted);
+            EXPECT(eres.iterator->value.value == 3);
+            EXPECT(cmap["b"].value == 0);
+            EXPECT(CopyCounter::copyCount == 0);
+            EXPECT(CopyCounter::moveCount == 0);
+
+            cmap.insert("c", CopyCounter(4));
+            EXPECT(CopyCounter::copyCount == 0);
+            EXPECT(cmap.count() == 3);
+
+            Map<Int32, UniquePtr<Int32>> umap;
+            umap.insert(1, makeUnique<Int32>(2));
+            umap.tryEmplace(2, makeUnique<Int32>(3));
+            EXPECT(*umap.find(1)->value == 2);
+            EXPECT(*umap[2] == 3);
+        }
+    },
+    SUITE("Hash Tests")
+    {
+        // aligned pointers and strided integers spread over the low bits
+        {
+            Size buckets[64] = {};
+            DefaultHash<const void *> ptrHash;
+            for (Size i = 0; i < 6400; ++i)
+                buckets[ptrHash(reinterpret_cast<const void *>(i * 64)) & 63]++;
+            Size minCount = 6400, maxCount = 0;
+            for (Size c : buckets)
+            {
+                minCount = c < minCount ? c : minCount;
+                maxCount = c > maxCount ? c : maxCount;
+            }
+            EXPECT(minCount > 50);
+            EXPECT(maxCount < 150);
+
+            Size buckets2[64] = {};
+            DefaultHash<Int32> intHash;
+            for (Int32 i = 0; i < 6400; ++i)
+                buckets2[intHash(i * 1024) & 63]++;
+            minCount = 6400;
+            maxCount = 0;
+            for (Size c : buckets2)
+            {
+                minCount = c < minCount ? c : minCount;
+                maxCount = c > maxCount ? c : maxCount;
+            }
+            EXPECT(minCount > 50);
+            EXPECT(maxCount < 150);
+        }
+
+        // all lengths hash differently, including the ones around the block boundaries
+        {
+            char buf[128];
+            for (Size i = 0; i < sizeof(buf); ++i)
+                buf[i] = 'a' + i % 26;
+
+            HashMap<Size, Size> seen;
+            for (Size len = 0; len <= sizeof(buf); ++len)
+                seen[hashBytes(buf, len)] = len;
+            EXPECT(seen.count() == sizeof(buf) + 1);
+
+            EXPECT(hashBytes(buf, 50) == hashBytes(buf, 50));
+            EXPECT(hashBytes(buf, 50) != hashBytes(buf, 50, 1));
+            EXPECT(DefaultHash<String>()(String(buf, buf + 50)) == hashBytes(buf, 50));
+
+            // flipping a single bit changes the hash
+            Size h = hashBytes(buf, sizeof(buf));
+            bool bAllDifferent = true;
+            for (Size i = 0; i < sizeof(buf); ++i)
+            {
+                buf[i] ^= 1;
+                bAllDifferent = bAllDifferent && hashBytes(buf, sizeof(buf)) != h;
+                buf[i] ^= 1;
+            }
+            EXPECT(bAllDifferent);
+        }
+
+        // HashMap uses power of two bucket counts
+        {
+            HashMap<Int32, Int32> map(100);
+            EXPECT(map.bucketCount() == 128);
+            map.rehash(300);
+            EXPECT(map.bucketCount() == 512);
+            for (Int32 i = 0; i < 1000; ++i)
+                map[i * 4096] = i;
+            EXPECT(map.bucketCount() == 1024);
+            EXPECT(map.find(999 * 4096)->value == 999);
+        }
+    },
+    SUITE("BTreeMap Tests")
+    {
+        typedef BTreeMap<String, Int32> TestMapType;
+        TestMapType map;
+        auto res = map.insert("b", 1);
+        EXPECT(res.inserted == true);
+        EXPECT(res.iterator->key == "b");
+        EXPECT(res.iterator->value == 1);
+
+        auto res2 = map.insert("b", 2);
+        EXPECT(res2.inserted == false);
+        EXPECT(res2.iterator->value == 2);
+        EXPECT(map.count() == 1);
+
+        map.insert("c", 3);
+        map.insert("a", 4);
+        map["d"] = 5;
+        EXPECT(map["a"] == 4);
+        EXPECT(map.count() == 4);
+
+        // iteration is sorted by key
+        const char * keys[] = { "a", "b", "c", "d" };
+        Size i = 0;
+        for (auto & kv : map)
+            EXPECT(kv.key == keys[i++]);
+        EXPECT(i == 4);
+        EXPECT((map.end() - 1)->key == "d");
+        EXPECT(map.rbegin()->key == "d");
+
+        EXPECT(map.find("c")->value == 3);
+        EXPECT(map.find(StringView("c"))->value == 3);
+        EXPECT(map.find("x") == map.end());
+
+        auto it = map.remove("b");
+        EXPECT(it->key == "c");
+        EXPECT(map.count() == 3);
+        it = map.remove(map.find("d"));
+        EXPECT(it == map.end());
+        EXPECT(map.remove("x") == map.end());
+
+        TestMapType copy = map;
+        EXPECT(copy.count() == 2);
+        EXPECT(copy.find("a")->value == 4);
+        TestMapType moved = std::move(copy);
+        EXPECT(moved.count() == 2);
+        EXPECT(copy.count() == 0);
+        EXPECT(copy.begin() == copy.end());
+
+        map.clear();
+        EXPECT(map.count() == 0);
+        EXPECT(map.begin() == map.end());
+
+        // small nodes to get a deep tree
+        typedef BTreeMap<Int32, Int32, 32> SmallMap;
+        {
+            const Int32 n = 2000;
+            bool present[n] = {};
+            SmallMap smap;
+            UInt32 seed = 1;
+            for (Int32 j = 0; j < 4 * n; ++j)
+            {
+                seed = seed * 1664525u + 1013904223u;
+                Int32 key = (seed >> 8) % n;
+                if (seed & 1)
+                {
+                    auto r = smap.insert(key, key * 2);
+                    EXPECT(r.inserted != present[key]);
+                    EXPECT(r.iterator->key == key);
+                    present[key] = true;
+                }
+                else
+                {
+                    auto r = smap.remove(key);
+                    if (present[key])
+                    {
+                        EXPECT(r == smap.upperBound(key));
+                        present[key] = false;
+                    }
+                    else
+                        EXPECT(r == smap.end());
+                }
+            }
+
+            Size expectedCount = 0;
+            for (Int32 j = 0; j < n; ++j)
+            {
+                if (present[j])
+                {
+                    ++expectedCount;
+                    EXPECT(smap.find(j)->value == j * 2);
+                }
+                else
+                    EXPECT(smap.find(j) == smap.end());
+            }
+            EXPECT(smap.count() == expectedCount);
+
+            Size iterCount = 0;
+            Int32 last = -1;
+            bool bSorted = true;
+            for (auto & kv : smap)
+            {
+                bSorted = bSorted && kv.key > last;
+                last = kv.key;
+                ++iterCount;
+            }
+            EXPECT(bSorted);
+            EXPECT(iterCount == expectedCount);
+
+            iterCount = 0;
+            for (auto rit = smap.rbegin(); rit != smap.rend(); ++rit)
+                ++iterCount;
+            EXPECT(iterCount == expectedCount);
+
+            // removing while iterating
+            auto sit = smap.begin();
+            while (sit != smap.end())
+                sit = smap.remove(sit);
+            EXPECT(smap.count() == 0);
+        }
+
+        // range queries and bulk loading
+        {
+            DynamicArray<SmallMap::KeyValuePair> sorted;
+            for (Int32 j = 0; j < 1000; ++j)
+                sorted.append({ j * 2, j });
+            SmallMap smap;
+            smap.insert(1, 1);
+            smap.assignSorted(sorted.begin(), sorted.end());
+            EXPECT(smap.count() == 1000);
+            EXPECT(smap.find(1) == smap.end());
+            EXPECT(smap.find(998)->value == 499);
+
+            EXPECT(smap.lowerBound(10)->key == 10);
+            EXPECT(smap.upperBound(10)->key == 12);
+            EXPECT(smap.lowerBound(11)->key == 12);
+            EXPECT(smap.lowerBound(-5)->key == 0);
+            EXPECT(smap.lowerBound(1998)->key == 1998);
+            EXPECT(smap.upperBound(1998) == smap.end());
+
+            Int32 sum = 0;
+            for (auto rit = smap.lowerBound(100); rit != smap.lowerBound(200); ++rit)
+                sum += rit->value;
+            EXPECT(sum == 3725);
+
+            for (Int32 j = 0; j < 1000; j += 2)
+                smap.remove(j * 2);
+            EXPECT(smap.count() == 500);
+            EXPECT(smap.begin()->key == 2);
+            smap.insert(0, 0);
+            EXPECT(smap.begin()->key == 0);
+        }
+
+        // destructors of all remaining values are called
+        {
+            DestructorTester::reset();
+            {
+                BTreeMap<Int32, DestructorTester, 64> dmap;
+                for (Int32 j = 0; j < 100; ++j)
+                    dmap.insert(j, DestructorTester());
+                Int32 afterInsert = DestructorTester::destructionCount;
+                for (Int32 j = 0; j < 50; ++j)
+                    dmap.remove(j);
+                EXPECT(DestructorTester::destructionCount >= afterInsert + 50);
+                DestructorTester::reset();
+            }
+            EXPECT(DestructorTester::destructionCount == 50);
+        }
+
+        {
+            BTreeMap<Int32, UniquePtr<Int32>> umap;
+            umap.insert(1, makeUnique<Int32>(2));
+            EXPECT(*umap.find(1)->value == 2);
+            umap.tryEmplace(2, makeUnique<Int32>(3));
+            EXPECT(*umap[2] == 3);
+        }
+
+        // tryEmplace constructs the value in place and leaves existing ones alone
+        {
+            CopyCounter::reset();
+            BTreeMap<String, CopyCounter> cmap;
+            auto eres = cmap.tryEmplace("a", 1, 2);
+            EXPECT(eres.inserted);
+            EXPECT(eres.iterator->value.value == 3);
+            eres = cmap.tryEmplace(String("a"), 5);
+            EXPECT(!eres.inserted);
+            EXPECT(eres.iterator->value.value == 3);
+            EXPECT(cmap["b"].value == 0);
+            EXPECT(CopyCounter::copyCount == 0);
+            EXPECT(CopyCounter::moveCount == 0);
+
+            cmap.insert("c", CopyCounter(4));
+            EXPECT(CopyCounter::copyCount == 0);
+            EXPECT(cmap.count() == 3);
+
+            // splitting leaves keeps the values inserted so far
+            BTreeMap<Int32, Int32, 32> smap;
+            for (Int32 i = 0; i < 200; ++i)
+                smap.tryEmplace(i, i * 2);
+            for (Int32 i = 0; i < 200; ++i)
+                smap.tryEmplace(i, 0);
+            bool bAllFound = true;
+            for (Int32 i = 0; i < 200; ++i)
+                bAllFound = bAllFound && smap[i] == i * 2;
+            EXPECT(bAllFound);
+            EXPECT(smap.count() == 200);
+        }
     },
     SUITE("HashMap Tests")
     {
@@ -1475,82 +2478,565 @@ const Suite spec[] =
             map3.remove(99);
             EXPECT(DestructorTester::destructionCount == 1);
         }
-    },
-    SUITE("Thread Tests")
-    {
-        Thread thread;
-        std::atomic<bool> bJoinable(false);
-        std::atomic<bool> bValidThreadID(false);
-        Error err = thread.run([&]() { bValidThreadID = thread.threadID() != 0; bJoinable = thread.isJoinable(); Thread::sleepFor(Duration::fromSeconds(0.1f));});
-        EXPECT(err.code() == 0);
-        err = thread.join();
-        EXPECT(bJoinable);
-        EXPECT(bValidThreadID);
-        EXPECT(err.code() == 0);
-        EXPECT(!thread.isJoinable());
 
-        //move test
-        Thread t2;
-        t2.run([&]() { Thread::sleepFor(Duration::fromSeconds(0.1f)); });
-        Thread t3 = std::move(t2);
-        EXPECT(t2.isJoinable() == false);
-        t3.join();
+        // nodes come from slabs and get recycled
+        {
+            TrackingAllocator alloc;
+            HashMap<Int32, Int32> map(16, alloc);
+            map.reserve(1000);
+            EXPECT(map.bucketCount() >= 1000);
+            EXPECT(map.nodeCapacity() >= 1000);
+            UInt64 allocCount = alloc.snapshot().allocationCount;
+            for (Int32 i = 0; i < 1000; ++i)
+                map.insert(i, i);
+            EXPECT(alloc.snapshot().allocationCount == allocCount);
+            EXPECT(map.count() == 1000);
 
-        Thread t4;
-        t4.run([&]() { Thread::sleepFor(Duration::fromSeconds(0.1f)); });
-        t3 = std::move(t4);
+            map.clear();
+            EXPECT(map.nodeCapacity() >= 1000);
+            for (Int32 i = 0; i < 1000; ++i)
+                map[i * 3] = i;
+            map.remove(3);
+            map.insert(3, 99);
+            EXPECT(alloc.snapshot().allocationCount == allocCount);
+            EXPECT(map.find(3)->value == 99);
+            EXPECT(map.find(999 * 3)->value == 999);
+
+            // a copy allocates all its nodes at once
+            allocCount = alloc.snapshot().allocationCount;
+            HashMap<Int32, Int32> cpy(map);
+            EXPECT(alloc.snapshot().allocationCount - allocCount == 2);
+            EXPECT(cpy.count() == 1000);
+            EXPECT(cpy.find(999 * 3)->value == 999);
+        }
 
-        EXPECT(t4.isJoinable() == false);
-        t3.join();
-    },
-    SUITE("ConditionVariable Tests")
-    {
-        Thread thread;
-        ConditionVariable cond;
-        Mutex m;
-        bool bRun = true;
-        Error err = thread.run([&]() { printf("START THREAD\n"); ScopedLock<Mutex> lock(m); while (bRun) {cond.wait(lock);} printf("END FUNC\n");});
-        // auto ss = SystemClock::now();
-        // auto start = HighResolutionClock::now();
-        // Thread::sleepFor(Duration::fromSeconds(1.0));
-        // std::cout << (HighResolutionClock::now() - start).seconds() << std::endl;
-        // std::cout << (SystemClock::now() - ss).seconds() << std::endl;
-        // EXPECT(err.code() == 0);
-        Thread::sleepFor(Duration::fromSeconds(0.25));
-        EXPECT(thread.isJoinable() == true); //the thread should still run as its blocking on the condition var
+        // bulk insertion rehashes at most once
         {
-            ScopedLock<Mutex> lock(m);
-            bRun = false;
-            err = cond.notifyOne();
+            TrackingAllocator alloc;
+            DynamicArray<HashMap<Int32, Int32>::KeyValuePair> pairs;
+            for (Int32 i = 0; i < 5000; ++i)
+                pairs.append({ i, i * 2 });
+
+            HashMap<Int32, Int32> map(16, alloc);
+            map.insert(pairs.begin(), pairs.end());
+            // the initial buckets, the resized buckets and one node slab
+            EXPECT(alloc.snapshot().allocationCount == 3);
+            EXPECT(map.count() == 5000);
+            EXPECT(map.loadFactor() <= map.maxLoadFactor());
+
+            bool bAllFound = true;
+            for (Int32 i = 0; i < 5000; ++i)
+            {
+                auto it = map.find(i);
+                bAllFound = bAllFound && it != map.end() && it->value == i * 2;
+            }
+            EXPECT(bAllFound);
+
+            Size counter = 0;
+            for (auto & kv : map)
+            {
+                STICK_UNUSED(kv);
+                counter++;
+            }
+            EXPECT(counter == 5000);
+        }
+
+        // tryEmplace constructs the value in place and leaves existing ones alone
+        {
+            CopyCounter::reset();
+            HashMap<String, CopyCounter> cmap;
+            auto eres = cmap.tryEmplace("a", 1, 2);
+            EXPECT(eres.inserted);
+            EXPECT(eres.iterator->value.value == 3);
+            eres = cmap.tryEmplace(String("a"), 5);
+            EXPECT(!eres.inserted);
+            EXPECT(eres.iterator->value.value == 3);
+            EXPECT(cmap["b"].value == 0);
+            cmap.insert("c", CopyCounter(4));
+            cmap.insert({ "d", CopyCounter(5) });
+            EXPECT(cmap.count() == 4);
+            EXPECT(cmap.find("d")->value.value == 5);
+            EXPECT(CopyCounter::copyCount == 0);
+        }
+
+        // values that can neither be copied nor moved are constructed in the node
+        {
+            HashMap<Int32, Pinned> pmap(1);
+            for (Int32 i = 0; i < 64; ++i)
+                pmap.tryEmplace(i, i * 2);
+            EXPECT(pmap[3].value == 6);
+            EXPECT(pmap[100].value == 0);
+            EXPECT(!pmap.tryEmplace(5, 1).inserted);
+            EXPECT(pmap.find(5)->value.value == 10);
+            pmap.remove(7);
+            EXPECT(pmap.count() == 64);
         }
-        EXPECT(err.code() == 0);
-        printf("pre join\n");
-        thread.join();
-        printf("test end\n");
     },
-    SUITE("FileUtilities Tests")
+    SUITE("FlatHashMap Tests")
     {
-        String uri("../../Tests/TestFiles/SomeTextFile.txt");
-        auto err = saveTextFile("This is some text", uri);
-        EXPECT(!err);
-        auto result = loadTextFile(uri);
-        EXPECT(result);
-        EXPECT(result.get() == "This is some text");
-        String str = result.ensure();
-        EXPECT(str == "This is some text");
-        auto result2 = loadTextFile("I/do/not/exist");
-        EXPECT(!result2);
+        FlatHashMap<String, Int32> hm(1);
 
-        String uri2("../../Tests/TestFiles/SomeBinaryData.dat");
-        ByteArray data = {1, 2, 127, 3, 4};
-        err = saveBinaryFile(data, uri2);
-        EXPECT(!err);
-        auto result3 = loadBinaryFile(uri2);
-        EXPECT(result3);
-        EXPECT(result3.get().count() == 5);
-        EXPECT(result3.get()[0] == 1);
-        EXPECT(result3.get()[1] == 2);
-        EXPECT(result3.get()[2] == 127);
+        hm.insert("test", 1);
+        hm.insert("test", 2);
+        EXPECT(hm.count() == 1);
+        hm.insert("anotherKey", 3);
+        auto res = hm.insert("blubb", 4);
+        EXPECT(hm.count() == 3);
+        EXPECT(res.iterator->key == "blubb");
+        EXPECT(res.iterator->value == 4);
+        EXPECT(res.inserted == true);
+
+        res = hm.insert("blubb", 5);
+        EXPECT(res.iterator->value == 5);
+        EXPECT(res.inserted == false);
+        hm.remove("anotherKey");
+        EXPECT(hm.count() == 2);
+        EXPECT(hm.find("anotherKey") == hm.end());
+
+        auto it2 = hm.find("blubb");
+        EXPECT(it2->key == "blubb");
+        EXPECT(it2->value == 5);
+
+        //copy tests
+        auto cpy = hm;
+        EXPECT(cpy.count() == 2);
+        EXPECT(cpy["blubb"] == 5);
+        EXPECT(cpy["test"] == 2);
+
+        FlatHashMap<String, Int32> copyMe;
+        copyMe["a"] = 1;
+        copyMe["b"] = 2;
+        copyMe["c"] = 3;
+        auto cpied = std::move(copyMe);
+        EXPECT(cpied.count() == 3);
+        EXPECT(cpied["a"] == 1);
+        EXPECT(cpied["b"] == 2);
+        EXPECT(cpied["c"] == 3);
+
+        // a moved from map is empty but still usable
+        EXPECT(copyMe.count() == 0);
+        EXPECT(copyMe.find("a") == copyMe.end());
+        EXPECT(copyMe.begin() == copyMe.end());
+        copyMe["d"] = 4;
+        EXPECT(copyMe.count() == 1);
+        EXPECT(copyMe["d"] == 4);
+
+        Int32 counter = 0;
+        Int32 sum = 0;
+        for (auto & pair : cpied)
+        {
+            sum += pair.value;
+            counter++;
+        }
+        EXPECT(counter == 3);
+        EXPECT(sum == 6);
+
+        cpied = cpy;
+        EXPECT(cpied.count() == 2);
+        EXPECT(cpied["blubb"] == 5);
+        EXPECT(cpied["test"] == 2);
+
+        //initializer list tests
+        FlatHashMap<String, String> foo = {{"apple", "green"}, {"banana", "yellow"}};
+        EXPECT(foo.count() == 2);
+        EXPECT(foo["apple"] == "green");
+        foo.insert({{"strawberry", "red"}, {"spaceberry", "rainbow"}});
+        EXPECT(foo.count() == 4);
+        EXPECT(foo["spaceberry"] == "rainbow");
+        foo = {{"we", "are"}, {"done", "now"}};
+        EXPECT(foo.count() == 2);
+        EXPECT(foo["we"] == "are");
+        EXPECT(foo["done"] == "now");
+
+        FlatHashMap<const void *, String> blaMap;
+        blaMap[0] = "test";
+        blaMap[(const void *)1] = "test2";
+        EXPECT(blaMap[0] == "test");
+        EXPECT(blaMap[(const void *)1] == "test2");
+
+        // growing, tombstones and reinsertion
+        {
+            FlatHashMap<Int32, Int32> map;
+            for (Int32 i = 0; i < 10000; ++i)
+                map.insert(i, i * 2);
+            EXPECT(map.count() == 10000);
+            EXPECT(map.loadFactor() <= map.maxLoadFactor());
+
+            bool bAllFound = true;
+            for (Int32 i = 0; i < 10000; ++i)
+            {
+                auto it = map.find(i);
+                bAllFound = bAllFound && it != map.end() && it->value == i * 2;
+            }
+            EXPECT(bAllFound);
+
+            for (Int32 i = 0; i < 10000; i += 2)
+                map.remove(i);
+            EXPECT(map.count() == 5000);
+            EXPECT(map.find(2) == map.end());
+            EXPECT(map.find(3)->value == 6);
+
+            // churn on a map full of tombstones does not grow it forever
+            Size buckets = map.bucketCount();
+            for (Int32 j = 0; j < 20; ++j)
+            {
+                for (Int32 i = 0; i < 10000; i += 2)
+                    map.insert(i + 20000 * (j + 1), i);
+                for (Int32 i = 0; i < 10000; i += 2)
+                    map.remove(i + 20000 * (j + 1));
+            }
+            EXPECT(map.count() == 5000);
+            EXPECT(map.bucketCount() == buckets);
+
+            Size iterCount = 0;
+            for (auto & kv : map)
+            {
+                STICK_UNUSED(kv);
+                iterCount++;
+            }
+            EXPECT(iterCount == 5000);
+
+            map.rehash(100000);
+            EXPECT(map.bucketCount() >= 100000);
+            EXPECT(map.count() == 5000);
+            EXPECT(map.find(9999)->value == 19998);
+        }
+
+        //testing if remove returns the expected iterator to the next item
+        {
+            FlatHashMap<String, Int32> map;
+            map.insert("test", 1);
+            map.insert("test2", 2);
+            map.insert("test3", 3);
+
+            auto it = map.begin();
+            Size removed = 0;
+            while (it != map.end())
+            {
+                it = map.remove(it);
+                removed++;
+            }
+            EXPECT(removed == 3);
+            EXPECT(map.count() == 0);
+        }
+
+        //check if destructors are called as expected
+        {
+            DestructorTester::reset();
+            FlatHashMap<Int32, UniquePtr<DestructorTester>> map;
+            map.insert(1, makeUnique<DestructorTester>());
+            map.insert(99, makeUnique<DestructorTester>());
+            map.insert(123, makeUnique<DestructorTester>());
+            map.clear();
+            EXPECT(DestructorTester::destructionCount == 3);
+
+            DestructorTester::reset();
+            {
+                FlatHashMap<Int32, UniquePtr<DestructorTester>> map2;
+                for (Int32 i = 0; i < 100; ++i)
+                    map2.insert(i, makeUnique<DestructorTester>());
+            }
+            EXPECT(DestructorTester::destructionCount == 100);
+
+            DestructorTester::reset();
+            FlatHashMap<Int32, UniquePtr<DestructorTester>> map3;
+            map3.insert(1, makeUnique<DestructorTester>());
+            map3.insert(99, makeUnique<DestructorTester>());
+            map3.insert(123, makeUnique<DestructorTester>());
+            map3.remove(99);
+            EXPECT(DestructorTester::destructionCount == 1);
+        }
+
+        // tryEmplace constructs the value in place and leaves existing ones alone
+        {
+            CopyCounter::reset();
+            FlatHashMap<String, CopyCounter> cmap;
+            auto eres = cmap.tryEmplace("a", 1, 2);
+            EXPECT(eres.inserted);
+            EXPECT(eres.iterator->value.value == 3);
+            EXPECT(CopyCounter::moveCount == 0);
+            eres = cmap.tryEmplace(String("a"), 5);
+            EXPECT(!eres.inserted);
+            EXPECT(eres.iterator->value.value == 3);
+            EXPECT(cmap["b"].value == 0);
+            cmap.insert("c", CopyCounter(4));
+            cmap.insert({ "d", CopyCounter(5) });
+            EXPECT(cmap.count() == 4);
+            EXPECT(cmap.find("d")->value.value == 5);
+            EXPECT(CopyCounter::copyCount == 0);
+        }
+    },
+    SUITE("FlatMap Tests")
+    {
+        typedef FlatMap<String, Int32> TestMapType;
+        TestMapType map;
+        auto res = map.insert("c", 1);
+        EXPECT(res.inserted == true);
+        EXPECT(res.iterator->key == "c");
+
+        auto res2 = map.insert("c", 2);
+        EXPECT(res2.inserted == false);
+        EXPECT(res2.iterator->value == 2);
+        EXPECT(map.count() == 1);
+
+        map.insert("a", 3);
+        map["b"] = 4;
+        map["d"] = 5;
+        EXPECT(map["a"] == 3);
+        EXPECT(map.count() == 4);
+
+        const char * keys[] = { "a", "b", "c", "d" };
+        Size i = 0;
+        for (auto & kv : map)
+            EXPECT(kv.key == keys[i++]);
+        EXPECT(i == 4);
+        EXPECT((*map.rbegin()).key == "d");
+
+        EXPECT(map.find("b")->value == 4);
+        EXPECT(map.find(StringView("d"))->value == 5);
+        EXPECT(map.find("x") == map.end());
+        EXPECT(map.lowerBound("bb")->key == "c");
+        EXPECT(map.upperBound("c")->key == "d");
+        EXPECT(map.lowerBound("c")->key == "c");
+        EXPECT(map.upperBound("d") == map.end());
+        EXPECT(map.lowerBound("0")->key == "a");
+
+        auto it = map.remove("b");
+        EXPECT(it->key == "c");
+        EXPECT(map.remove("x") == map.end());
+        EXPECT(map.count() == 3);
+
+        // batch insert merges with the existing pairs, new values win
+        map.insert({ { "e", 6 }, { "a", 7 }, { "bb", 8 } });
+        EXPECT(map.count() == 5);
+        const char * keys2[] = { "a", "bb", "c", "d", "e" };
+        i = 0;
+        for (auto & kv : map)
+            EXPECT(kv.key == keys2[i++]);
+        EXPECT(map.find("a")->value == 7);
+
+        TestMapType copy = map;
+        EXPECT(copy.count() == 5);
+        EXPECT(copy.find("bb")->value == 8);
+        map.clear();
+        EXPECT(map.count() == 0);
+        EXPECT(map.begin() == map.end());
+        EXPECT(copy.count() == 5);
+
+        // bulk construction and lookups against a large range
+        {
+            DynamicArray<FlatMap<Int32, Int32>::KeyValuePair> pairs;
+            for (Int32 j = 0; j < 500; ++j)
+                pairs.append({ (j * 7919) % 500, j });
+            FlatMap<Int32, Int32> imap;
+            imap.insert(pairs.begin(), pairs.end());
+            EXPECT(imap.count() == 500);
+            bool bAllFound = true;
+            for (Int32 j = 0; j < 500; ++j)
+                bAllFound = bAllFound && imap.find((j * 7919) % 500)->value == j;
+            EXPECT(bAllFound);
+            EXPECT(imap.find(500) == imap.end());
+            EXPECT(imap.find(-1) == imap.end());
+            for (Int32 j = 0; j < 500; ++j)
+                bAllFound = bAllFound && imap.begin()[j].key == j;
+            EXPECT(bAllFound);
+
+            // appending keys past the end does not need a merge
+            imap.insert({ { 600, 1 }, { 550, 2 } });
+            EXPECT(imap.count() == 502);
+            EXPECT((imap.end() - 1)->key == 600);
+            EXPECT((imap.end() - 2)->key == 550);
+        }
+
+        // only the array itself is allocated
+        {
+            TrackingAllocator alloc;
+            FlatMap<Int32, Int32> imap(alloc);
+            imap.reserve(64);
+            EXPECT(imap.capacity() >= 64);
+            UInt64 allocCount = alloc.snapshot().allocationCount;
+            for (Int32 j = 64; j > 0; --j)
+                imap.insert(j, j);
+            EXPECT(alloc.snapshot().allocationCount == allocCount);
+            EXPECT(imap.begin()->key == 1);
+            EXPECT(&imap.allocator() == &alloc);
+        }
+
+        {
+            DestructorTester::reset();
+            {
+                FlatMap<Int32, UniquePtr<DestructorTester>> umap;
+                umap.insert(1, makeUnique<DestructorTester>());
+                umap.insert(2, makeUnique<DestructorTester>());
+                umap.remove(1);
+                EXPECT(DestructorTester::destructionCount == 1);
+            }
+            EXPECT(DestructorTester::destructionCount == 2);
+        }
+
+        // tryEmplace leaves existing values alone
+        {
+            CopyCounter::reset();
+            FlatMap<String, CopyCounter> cmap;
+            auto eres = cmap.tryEmplace("b", 1, 2);
+            EXPECT(eres.inserted);
+            EXPECT(eres.iterator->value.value == 3);
+            eres = cmap.tryEmplace(String("b"), 5);
+            EXPECT(!eres.inserted);
+            EXPECT(eres.iterator->value.value == 3);
+            eres = cmap.tryEmplace("a", 4);
+            EXPECT(eres.inserted);
+            EXPECT(eres.iterator == cmap.begin());
+            EXPECT(cmap["c"].value == 0);
+            EXPECT(cmap.count() == 3);
+            EXPECT(CopyCounter::copyCount == 0);
+
+            FlatMap<Int32, UniquePtr<Int32>> umap;
+            umap.tryEmplace(2, makeUnique<Int32>(3));
+            umap.tryEmplace(1, makeUnique<Int32>(2));
+            EXPECT(*umap.begin()->value == 2);
+            EXPECT(*umap[2] == 3);
+        }
+    },
+    SUITE("ConcurrentHashMap Tests")
+    {
+        ConcurrentHashMap<Int32, Int32> map(5);
+        EXPECT(map.shardCount() == 8);
+        EXPECT(map.insertOrAssign(1, 2));
+        EXPECT(!map.insertOrAssign(1, 3));
+        EXPECT(map.count() == 1);
+        EXPECT(map.contains(1));
+        EXPECT(!map.contains(2));
+
+        Int32 val = 0;
+        EXPECT(map.findAndApply(1, [&](Int32 & _v) { val = _v; _v = 10; }));
+        EXPECT(val == 3);
+        const ConcurrentHashMap<Int32, Int32> & cmap = map;
+        EXPECT(cmap.findAndApply(1, [&](const Int32 & _v) { val = _v; }));
+        EXPECT(val == 10);
+        EXPECT(!map.findAndApply(2, [&](Int32 & _v) { val = -1; }));
+        EXPECT(val == 10);
+
+        EXPECT(map.erase(1));
+        EXPECT(!map.erase(1));
+        EXPECT(map.count() == 0);
+
+        ConcurrentHashMap<String, String> strMap;
+        strMap.insertOrAssign("a", "b");
+        String str;
+        strMap.findAndApply("a", [&](const String & _v) { str = _v; });
+        EXPECT(str == "b");
+
+        // concurrent access
+        ConcurrentHashMap<Int32, Int32> shared;
+        shared.insertOrAssign(-1, 0);
+        const Int32 threadCount = 4;
+        const Int32 perThread = 5000;
+        Thread threads[threadCount];
+        for (Int32 t = 0; t < threadCount; ++t)
+        {
+            threads[t].run([&shared, t, perThread]() {
+                for (Int32 i = 0; i < perThread; ++i)
+                {
+                    shared.insertOrAssign(t * perThread + i, i);
+                    shared.findAndApply(-1, [](Int32 & _v) { _v++; });
+                    // every other key gets removed again
+                    if (i % 2)
+                        shared.erase(t * perThread + i);
+                }
+            });
+        }
+        for (Int32 t = 0; t < threadCount; ++t)
+            threads[t].join();
+
+        EXPECT(shared.count() == threadCount * perThread / 2 + 1);
+        Int32 counter = 0;
+        shared.findAndApply(-1, [&](Int32 _v) { counter = _v; });
+        EXPECT(counter == threadCount * perThread);
+
+        bool bAllThere = true;
+        for (Int32 i = 0; i < threadCount * perThread; ++i)
+            bAllThere = bAllThere && shared.contains(i) == (i % perThread % 2 == 0);
+        EXPECT(bAllThere);
+
+        shared.clear();
+        EXPECT(shared.count() == 0);
+    },
+    SUITE("Thread Tests")
+    {
+        Thread thread;
+        std::atomic<bool> bJoinable(false);
+        std::atomic<bool> bValidThreadID(false);
+        Error err = thread.run([&]() { bValidThreadID = thread.threadID() != 0; bJoinable = thread.isJoinable(); Thread::sleepFor(Duration::fromSeconds(0.1f));});
+        EXPECT(err.code() == 0);
+        err = thread.join();
+        EXPECT(bJoinable);
+        EXPECT(bValidThreadID);
+        EXPECT(err.code() == 0);
+        EXPECT(!thread.isJoinable());
+
+        //move test
+        Thread t2;
+        t2.run([&]() { Thread::sleepFor(Duration::fromSeconds(0.1f)); });
+        Thread t3 = std::move(t2);
+        EXPECT(t2.isJoinable() == false);
+        t3.join();
+
+        Thread t4;
+        t4.run([&]() { Thread::sleepFor(Duration::fromSeconds(0.1f)); });
+        t3 = std::move(t4);
+
+        EXPECT(t4.isJoinable() == false);
+        t3.join();
+    },
+    SUITE("ConditionVariable Tests")
+    {
+        Thread thread;
+        ConditionVariable cond;
+        Mutex m;
+        bool bRun = true;
+        Error err = thread.run([&]() { printf("START THREAD\n"); ScopedLock<Mutex> lock(m); while (bRun) {cond.wait(lock);} printf("END FUNC\n");});
+        // auto ss = SystemClock::now();
+        // auto start = HighResolutionClock::now();
+        // Thread::sleepFor(Duration::fromSeconds(1.0));
+        // std::cout << (HighResolutionClock::now() - start).seconds() << std::endl;
+        // std::cout << (SystemClock::now() - ss).seconds() << std::endl;
+        // EXPECT(err.code() == 0);
+        Thread::sleepFor(Duration::fromSeconds(0.25));
+        EXPECT(thread.isJoinable() == true); //the thread should still run as its blocking on the condition var
+        {
+            ScopedLock<Mutex> lock(m);
+            bRun = false;
+            err = cond.notifyOne();
+        }
+        EXPECT(err.code() == 0);
+        printf("pre join\n");
+        thread.join();
+        printf("test end\n");
+    },
+    SUITE("FileUtilities Tests")
+    {
+        String uri("../../Tests/TestFiles/SomeTextFile.txt");
+        auto err = saveTextFile("This is some text", uri);
+        EXPECT(!err);
+        auto result = loadTextFile(uri);
+        EXPECT(result);
+        EXPECT(result.get() == "This is some text");
+        String str = result.ensure();
+        EXPECT(str == "This is some text");
+        auto result2 = loadTextFile("I/do/not/exist");
+        EXPECT(!result2);
+
+        String uri2("../../Tests/TestFiles/SomeBinaryData.dat");
+        ByteArray data = {1, 2, 127, 3, 4};
+        err = saveBinaryFile(data, uri2);
+        EXPECT(!err);
+        auto result3 = loadBinaryFile(uri2);
+        EXPECT(result3);
+        EXPECT(result3.get().count() == 5);
+        EXPECT(result3.get()[0] == 1);
+        EXPECT(result3.get()[1] == 2);
+        EXPECT(result3.get()[2] == 127);
         EXPECT(result3.get()[3] == 3);
         EXPECT(result3.get()[4] == 4);
     },
@@ -1629,6 +3115,8 @@ const Suite spec[] =
         for (; it != fs::DirectoryIterator::End; ++it)
         {
             //printf("%s\n", it->path().cString());
+            StringView name = it->fileName();
+            EXPECT(name == "Subfolder" || name == "Foo" || name == "Bar");
             numIterations++;
         }
         EXPECT(numIterations == 3);
@@ -1782,6 +3270,10 @@ const Suite spec[] =
         EXPECT(!a);
         auto b = parser.argument("test");
         EXPECT(b);
+        EXPECT(parser.argument("--test") == b);
+        EXPECT(parser.argument("t") == b);
+        EXPECT(parser.argument(String("test")) == b);
+        EXPECT(parser.argument(StringView("testing", 4)) == b);
         EXPECT(b->values.count() == 3);
         EXPECT(b->values[0] == "1");
         EXPECT(b->values[1] == "2");
@@ -2012,6 +3504,137 @@ const Suite spec[] =
         }
         //@TODO: More!
     },
+    SUITE("SegregatedFreeListAllocator Tests")
+    {
+        mem::SegregatedFreeListAllocator<mem::Mallocator, 1088> falloc;
+
+        auto a = falloc.allocate(2048, 4);
+        EXPECT(!a);
+
+        auto b = falloc.allocate(32, 4);
+        EXPECT(b);
+        EXPECT(b.size == 32);
+        EXPECT(falloc.owns(b));
+        EXPECT(falloc.chunkCount() == 1);
+        EXPECT(falloc.freeCount() == 1);
+        falloc.deallocate(b);
+        EXPECT(falloc.freeCount() == 1);
+
+        mem::Block blocks[4];
+        for (int i = 0; i < 4; ++i)
+        {
+            blocks[i] = falloc.allocate(200, 4);
+            EXPECT(blocks[i]);
+            EXPECT(falloc.owns(blocks[i]));
+            if (i > 0)
+                EXPECT(blocks[i].ptr > blocks[i - 1].ptr);
+        }
+        EXPECT(falloc.chunkCount() == 1);
+
+        //freeing the odd blocks leaves holes that can't be merged
+        falloc.deallocate(blocks[1]);
+        falloc.deallocate(blocks[3]);
+        EXPECT(falloc.freeCount() == 2);
+        //which get merged with their neighbours once those are freed
+        falloc.deallocate(blocks[0]);
+        EXPECT(falloc.freeCount() == 2);
+        falloc.deallocate(blocks[2]);
+        EXPECT(falloc.freeCount() == 1);
+
+        //a hole gets reused for an allocation that only fits into it
+        for (int i = 0; i < 4; ++i)
+            blocks[i] = falloc.allocate(200, 4);
+        void * hole = blocks[2].ptr;
+        falloc.deallocate(blocks[2]);
+        auto c = falloc.allocate(200, 4);
+        EXPECT(c.ptr == hole);
+        falloc.deallocate(c);
+
+        //alignment
+        auto d = falloc.allocate(64, 128);
+        EXPECT(d);
+        EXPECT(reinterpret_cast<UPtr>(d.ptr) % 128 == 0);
+        auto e = falloc.allocate(16, 64);
+        EXPECT(e);
+        EXPECT(reinterpret_cast<UPtr>(e.ptr) % 64 == 0);
+        falloc.deallocate(d);
+        falloc.deallocate(e);
+
+        //grows by adding chunks
+        auto f = falloc.allocate(900, 4);
+        EXPECT(f);
+        EXPECT(falloc.chunkCount() == 2);
+        EXPECT(falloc.owns(f));
+        falloc.deallocate(f);
+
+        falloc.deallocate(blocks[0]);
+        falloc.deallocate(blocks[1]);
+        falloc.deallocate(blocks[3]);
+        EXPECT(falloc.freeCount() == 2);
+
+        falloc.deallocateAll();
+        EXPECT(falloc.freeCount() == 2);
+        EXPECT(falloc.chunkCount() == 2);
+    },
+    SUITE("ChunkRegistry Tests")
+    {
+        {
+            mem::Mallocator alloc;
+            mem::ChunkRegistry registry;
+            mem::MemoryChunk chunks[64];
+            char memory[64 * 16];
+            //register in reverse order to make sure the index is kept sorted
+            for (int i = 63; i >= 0; --i)
+            {
+                chunks[i] = mem::MemoryChunk({ memory + i * 16, 8 });
+                registry.add(&chunks[i], alloc);
+            }
+            EXPECT(registry.count() == 64);
+
+            bool bAllFound = true;
+            for (int i = 0; i < 64; ++i)
+                bAllFound = bAllFound && registry.find({ memory + i * 16 + 4, 4 }) == &chunks[i];
+            EXPECT(bAllFound);
+
+            //gaps between the chunks and addresses outside of all chunks
+            EXPECT(!registry.owns({ memory + 16 * 5 + 12, 4 }));
+            EXPECT(!registry.owns({ memory + 64 * 16, 4 }));
+            EXPECT(!registry.owns({ memory - 1, 4 }));
+            registry.release(alloc);
+            EXPECT(registry.count() == 0);
+        }
+        {
+            //thousands of chunks
+            mem::PoolAllocator<mem::Mallocator, 0, 8, 2> palloc;
+            mem::FreeListAllocator<mem::Mallocator, 64> falloc;
+            mem::Block pblocks[4096];
+            mem::Block fblocks[4096];
+            for (int i = 0; i < 4096; ++i)
+            {
+                pblocks[i] = palloc.allocate(8, 4);
+                fblocks[i] = falloc.allocate(40, 4);
+            }
+            EXPECT(palloc.chunkCount() == 2048);
+            EXPECT(falloc.chunkCount() == 4096);
+
+            bool bAllOwned = true;
+            for (int i = 0; i < 4096; ++i)
+                bAllOwned = bAllOwned && palloc.owns(pblocks[i]) && falloc.owns(fblocks[i]) &&
+                    !palloc.owns(fblocks[i]) && !falloc.owns(pblocks[i]);
+            EXPECT(bAllOwned);
+
+            mem::FallbackAllocator<mem::PoolAllocator<mem::Mallocator, 0, 8, 2>, mem::FreeListAllocator<mem::Mallocator, 64>> fallback;
+            for (int i = 0; i < 4096; ++i)
+                fblocks[i] = fallback.allocate(i % 2 ? 8 : 32, 4);
+            for (int i = 0; i < 4096; ++i)
+                fallback.deallocate(fblocks[i]);
+
+            for (int i = 0; i < 4096; ++i)
+            {
+                palloc.deallocate(pblocks[i]);
+            }
+        }
+    },
     SUITE("Bucketizer Tests")
     {
 
@@ -2093,6 +3716,716 @@ const Suite spec[] =
 
         //@TODO: More!
     },
+    SUITE("ConcurrentPoolAllocator Tests")
+    {
+        {
+            mem::ConcurrentPoolAllocator<mem::Mallocator, 17, 32, 1024> palloc;
+
+            auto a = palloc.allocate(16, 4);
+            EXPECT(!a);
+
+            auto b = palloc.allocate(32, 4);
+            EXPECT(b);
+            EXPECT(b.size == 32);
+            EXPECT(palloc.owns(b));
+            EXPECT(palloc.chunkCount() == 1);
+            EXPECT(palloc.freeCount() == 1023);
+
+            palloc.deallocate(b);
+            EXPECT(palloc.freeCount() == 1024);
+
+            auto c = palloc.allocate(24, 4);
+            EXPECT(c.ptr == b.ptr);
+            palloc.deallocate(c);
+        }
+        {
+            mem::ConcurrentPoolAllocator<mem::Mallocator, 0, 8, 2> palloc;
+            auto a = palloc.allocate(4, 4);
+            auto b = palloc.allocate(4, 4);
+            EXPECT(palloc.chunkCount() == 1);
+            EXPECT(palloc.freeCount() == 0);
+            auto c = palloc.allocate(4, 4);
+            EXPECT(a && b && c);
+            EXPECT(palloc.chunkCount() == 2);
+            EXPECT(palloc.freeCount() == 1);
+            EXPECT(palloc.owns(a) && palloc.owns(b) && palloc.owns(c));
+            palloc.deallocateAll();
+            EXPECT(palloc.freeCount() == 4);
+        }
+        {
+            //one pool shared by multiple threads, both directly and through a Bucketizer
+            using PoolType = mem::ConcurrentPoolAllocator<mem::Mallocator, mem::DynamicSizeFlag, mem::DynamicSizeFlag, 64>;
+            mem::Bucketizer<PoolType, 1, 64, 16> bucketizer;
+            mem::ConcurrentPoolAllocator<mem::Mallocator, 0, 16, 64> nodePool;
+
+            std::atomic<int> failCount(0);
+            mem::Block produced[4][256];
+            Thread threads[4];
+            for (int t = 0; t < 4; ++t)
+            {
+                threads[t].run([&, t]()
+                {
+                    for (int j = 0; j < 200; ++j)
+                    {
+                        mem::Block tmp[32];
+                        for (int i = 0; i < 32; ++i)
+                        {
+                            tmp[i] = bucketizer.allocate(i * 2 + 1, 1);
+                            if (!tmp[i])
+                                failCount++;
+                            else
+                                memset(tmp[i].ptr, t, tmp[i].size);
+                        }
+                        for (int i = 0; i < 32; ++i)
+                        {
+                            for (Size k = 0; k < tmp[i].size; ++k)
+                            {
+                                if (reinterpret_cast<UInt8 *>(tmp[i].ptr)[k] != t)
+                                {
+                                    failCount++;
+                                    break;
+                                }
+                            }
+                            bucketizer.deallocate(tmp[i]);
+                        }
+                    }
+
+                    for (int i = 0; i < 256; ++i)
+                        produced[t][i] = nodePool.allocate(16, 4);
+                });
+            }
+            for (int t = 0; t < 4; ++t)
+                threads[t].join();
+            EXPECT(failCount == 0);
+
+            bool bAllOwned = true;
+            for (int t = 0; t < 4; ++t)
+                for (int i = 0; i < 256; ++i)
+                    bAllOwned = bAllOwned && nodePool.owns(produced[t][i]);
+            EXPECT(bAllOwned);
+
+            //consumers free the nodes that a different thread produced
+            for (int t = 0; t < 4; ++t)
+            {
+                threads[t].run([&, t]()
+                {
+                    for (int i = 0; i < 256; ++i)
+                        nodePool.deallocate(produced[(t + 1) % 4][i]);
+                });
+            }
+            for (int t = 0; t < 4; ++t)
+                threads[t].join();
+
+            EXPECT(nodePool.freeCount() == nodePool.chunkCount() * 64);
+        }
+        {
+            //the parent allocator failing to provide a chunk fails the allocation
+            mem::ConcurrentPoolAllocator<FailingAllocator, 0, 16, 64> palloc;
+            EXPECT(!palloc.allocate(16, 4));
+            EXPECT(palloc.chunkCount() == 0);
+        }
+        {
+            //threads that find the pool empty at the same time might each allocate a chunk
+            mem::ConcurrentPoolAllocator<mem::Mallocator, 0, 16, 64> palloc;
+            std::atomic<bool> bGo(false);
+            mem::Block blocks[8];
+            Thread threads[8];
+            for (int t = 0; t < 8; ++t)
+            {
+                threads[t].run([&, t]()
+                {
+                    while (!bGo)
+                    {
+                    }
+                    blocks[t] = palloc.allocate(16, 4);
+                });
+            }
+            bGo = true;
+            for (int t = 0; t < 8; ++t)
+                threads[t].join();
+
+            bool bAllAllocated = true;
+            for (int t = 0; t < 8; ++t)
+                bAllAllocated = bAllAllocated && blocks[t];
+            EXPECT(bAllAllocated);
+            EXPECT(palloc.chunkCount() >= 1 && palloc.chunkCount() <= 8);
+            EXPECT(palloc.freeCount() == palloc.chunkCount() * 64 - 8);
+        }
+    },
+    SUITE("ThreadCachingAllocator Tests")
+    {
+        using PoolType = mem::PoolAllocator<mem::Mallocator,  mem::DynamicSizeFlag,  mem::DynamicSizeFlag, 256>;
+        using CentralAllocator = mem::Bucketizer<PoolType, 1, 256, 16>;
+        using CachingAllocator = mem::ThreadCachingAllocator<CentralAllocator, 256, 16, 8>;
+
+        CachingAllocator alloc;
+        EXPECT(alloc.sizeClassCount == 16);
+
+        auto a = alloc.allocate(24, 4);
+        EXPECT(a);
+        EXPECT(a.size == 24);
+        EXPECT(alloc.owns(a));
+        //the first allocation refills the magazine with a batch of blocks
+        EXPECT(alloc.cachedCount(24) == 3);
+
+        auto b = alloc.allocate(20, 4);
+        EXPECT(b);
+        EXPECT(b.ptr != a.ptr);
+        EXPECT(alloc.cachedCount(24) == 2);
+
+        alloc.deallocate(a);
+        EXPECT(alloc.cachedCount(24) == 3);
+        auto c = alloc.allocate(32, 4);
+        EXPECT(c.ptr == a.ptr);
+
+        //larger than MaxSize goes straight to the central allocator
+        auto d = alloc.allocate(512, 4);
+        EXPECT(!d);
+
+        mem::Block blocks[32];
+        for (int i = 0; i < 32; ++i)
+        {
+            blocks[i] = alloc.allocate(100, 4);
+            EXPECT(blocks[i]);
+        }
+        for (int i = 0; i < 32; ++i)
+            alloc.deallocate(blocks[i]);
+        //a full magazine flushes half of its blocks back to the central allocator
+        EXPECT(alloc.cachedCount(100) <= 8);
+
+        alloc.deallocate(b);
+        alloc.deallocate(c);
+        alloc.flushThreadCache();
+        EXPECT(alloc.cachedCount(24) == 0);
+        EXPECT(alloc.cachedCount(100) == 0);
+
+        //allocate and deallocate from multiple threads, blocks are also freed on a different
+        //thread than the one that allocated them
+        std::atomic<int> failCount(0);
+        mem::Block shared[4][64];
+        Thread threads[4];
+        for (int t = 0; t < 4; ++t)
+        {
+            threads[t].run([&, t]()
+            {
+                CachingAllocator talloc;
+                for (int j = 0; j < 100; ++j)
+                {
+                    mem::Block tmp[64];
+                    for (int i = 0; i < 64; ++i)
+                    {
+                        tmp[i] = talloc.allocate(i * 3 + 1, 4);
+                        if (!tmp[i])
+                            failCount++;
+                        else
+                            memset(tmp[i].ptr, t, tmp[i].size);
+                    }
+                    for (int i = 0; i < 64; ++i)
+                    {
+                        if (reinterpret_cast<UInt8 *>(tmp[i].ptr)[tmp[i].size - 1] != t)
+                            failCount++;
+                        talloc.deallocate(tmp[i]);
+                    }
+                }
+                for (int i = 0; i < 64; ++i)
+                    shared[t][i] = talloc.allocate(i + 1, 4);
+            });
+        }
+        for (int t = 0; t < 4; ++t)
+            threads[t].join();
+        EXPECT(failCount == 0);
+
+        for (int t = 0; t < 4; ++t)
+        {
+            threads[t].run([&, t]()
+            {
+                CachingAllocator talloc;
+                for (int i = 0; i < 64; ++i)
+                    talloc.deallocate(shared[(t + 1) % 4][i]);
+            });
+        }
+        for (int t = 0; t < 4; ++t)
+            threads[t].join();
+
+        //and through the Allocator interface
+        std::atomic<int> failCount2(0);
+        for (int t = 0; t < 4; ++t)
+        {
+            threads[t].run([&]()
+            {
+                for (int j = 0; j < 100; ++j)
+                {
+                    DynamicArray<Int32> arr(concurrentAllocator());
+                    String str(concurrentAllocator());
+                    for (int i = 0; i < 50; ++i)
+                    {
+                        arr.append(i);
+                        str.append('a');
+                    }
+                    if (arr.count() != 50 || arr[49] != 49 || str.length() != 50)
+                        failCount2++;
+                }
+            });
+        }
+        for (int t = 0; t < 4; ++t)
+            threads[t].join();
+        EXPECT(failCount2 == 0);
+
+        //small blocks requested after the thread cache is destroyed are sized like cached ones
+        {
+            Thread lateThread;
+            lateThread.run([]()
+            {
+                thread_local LateAllocator late;
+                STICK_UNUSED(late);
+                mem::Block blk = concurrentAllocator().allocate(8, 8);
+                concurrentAllocator().deallocate(blk);
+            });
+            lateThread.join();
+            EXPECT(LateAllocator::bWorked);
+        }
+    },
+    SUITE("ArenaAllocator Tests")
+    {
+        mem::ArenaAllocator<mem::Mallocator, 256> aalloc;
+        EXPECT(aalloc.chunkCount() == 0);
+
+        auto a = aalloc.allocate(16, 4);
+        EXPECT(a);
+        EXPECT(a.size == 16);
+        EXPECT(aalloc.owns(a));
+        EXPECT(aalloc.chunkCount() == 1);
+
+        auto b = aalloc.allocate(64, 32);
+        EXPECT(reinterpret_cast<UPtr>(b.ptr) % 32 == 0);
+        EXPECT(b.ptr > a.ptr);
+
+        //rolling back the last allocation
+        aalloc.deallocate(b);
+        auto c = aalloc.allocate(64, 32);
+        EXPECT(c.ptr == b.ptr);
+
+        //grows by appending chunks, oversized allocations get their own chunk
+        auto m = aalloc.mark();
+        auto d = aalloc.allocate(200, 4);
+        EXPECT(aalloc.chunkCount() == 2);
+        auto e = aalloc.allocate(1000, 4);
+        EXPECT(e);
+        EXPECT(aalloc.owns(e));
+        EXPECT(aalloc.chunkCount() == 3);
+
+        //rewinding releases everything after the marker and reuses the chunks
+        aalloc.rewind(m);
+        auto f = aalloc.allocate(200, 4);
+        EXPECT(f.ptr == d.ptr);
+        auto g = aalloc.allocate(1000, 4);
+        EXPECT(g.ptr == e.ptr);
+        EXPECT(aalloc.chunkCount() == 3);
+
+        //a retained chunk that is too small gets skipped by inserting a new one
+        aalloc.rewind(m);
+        aalloc.allocate(200, 4);
+        auto h = aalloc.allocate(2000, 4);
+        EXPECT(h);
+        EXPECT(aalloc.chunkCount() == 4);
+
+        aalloc.deallocateAll();
+        auto i = aalloc.allocate(16, 4);
+        EXPECT(i.ptr == a.ptr);
+        EXPECT(aalloc.chunkCount() == 4);
+
+        {
+            Arena arena;
+            Arena::Marker m2 = arena.mark();
+            {
+                Arena::Scope scope(arena);
+                StringArray segs = path::segments("/foo/bar/baz", arena);
+                EXPECT(segs.count() == 3);
+                EXPECT(segs[2] == "baz");
+                EXPECT(arena.chunkCount() == 1);
+            }
+            //the scope rewound the arena
+            auto blk = arena.allocate(8, 8);
+            Arena::Marker m3 = arena.mark();
+            arena.rewind(m2);
+            EXPECT(arena.allocate(8, 8).ptr == blk.ptr);
+            EXPECT(m3.position > blk.ptr);
+
+            String * str = arena.create<String>("test", arena);
+            EXPECT(*str == "test");
+            arena.destroy(str);
+            arena.reset();
+        }
+    },
+    SUITE("StatsAllocator Tests")
+    {
+        mem::StatsAllocator<mem::Mallocator> salloc;
+        salloc.stats().setSampleInterval(2);
+        auto start = salloc.snapshot();
+
+        auto a = salloc.allocate(16, 8);
+        auto b = salloc.allocate(100, 8);
+        auto c = salloc.allocate(1000, 8);
+
+        auto snap = salloc.snapshot();
+        EXPECT(snap.allocationCount == 3);
+        EXPECT(snap.liveBytes == 1116);
+        EXPECT(snap.peakBytes == 1116);
+        EXPECT(snap.totalBytes == 1116);
+        EXPECT(snap.sizeClasses[4] == 1);
+        EXPECT(snap.sizeClasses[7] == 1);
+        EXPECT(snap.sizeClasses[10] == 1);
+        EXPECT(snap.allocationRate(start) > 0);
+        EXPECT(snap.byteRate(start) > 0);
+
+        //every second allocation got sampled
+        EXPECT(snap.sampledCount == 2);
+        EXPECT(snap.callSites[0].byteCount == 16);
+        EXPECT(snap.callSites[0].address != nullptr);
+        EXPECT(snap.callSites[1].byteCount == 1000);
+
+        salloc.deallocate(c);
+        salloc.deallocate(b);
+        snap = salloc.snapshot();
+        EXPECT(snap.deallocationCount == 2);
+        EXPECT(snap.liveBytes == 16);
+        EXPECT(snap.peakBytes == 1116);
+        salloc.deallocate(a);
+
+        EXPECT(mem::AllocationStats::sizeClass(1) == 0);
+        EXPECT(mem::AllocationStats::sizeClass(2) == 1);
+        EXPECT(mem::AllocationStats::sizeClass(17) == 5);
+        EXPECT(mem::AllocationStats::sizeClass(Size(1) << 40) == mem::AllocationStats::sizeClassCount - 1);
+
+        {
+            //live bytes that exceed a batch are moved out of the shard without losing the peak
+            mem::StatsAllocator<mem::Mallocator> balloc;
+            mem::Block blocks[100];
+            for (Size i = 0; i < 100; ++i)
+                blocks[i] = balloc.allocate(1000, 8);
+            auto bsnap = balloc.snapshot();
+            EXPECT(bsnap.liveBytes == 100000);
+            EXPECT(bsnap.peakBytes == 100000);
+            for (Size i = 0; i < 100; ++i)
+                balloc.deallocate(blocks[i]);
+            bsnap = balloc.snapshot();
+            EXPECT(bsnap.liveBytes == 0);
+            EXPECT(bsnap.peakBytes == 100000);
+        }
+        {
+            //the shards of all threads are summed up
+            mem::StatsAllocator<mem::Mallocator> shalloc;
+            Thread threads[4];
+            for (int t = 0; t < 4; ++t)
+            {
+                threads[t].run([&]()
+                {
+                    for (int i = 0; i < 1000; ++i)
+                        shalloc.deallocate(shalloc.allocate(64, 8));
+                });
+            }
+            for (int t = 0; t < 4; ++t)
+                threads[t].join();
+            auto csnap = shalloc.snapshot();
+            EXPECT(csnap.allocationCount == 4000);
+            EXPECT(csnap.deallocationCount == 4000);
+            EXPECT(csnap.totalBytes == 4000 * 64);
+            EXPECT(csnap.sizeClasses[6] == 4000);
+            EXPECT(csnap.liveBytes == 0);
+            EXPECT(csnap.peakBytes >= 64);
+        }
+
+        //tracking the stick::Allocator interface
+        TrackingAllocator talloc;
+        {
+            DynamicArray<Int32> arr(talloc);
+            for (Int32 i = 0; i < 100; ++i)
+                arr.append(i);
+            String str("some string that is long enough", talloc);
+            EXPECT(talloc.snapshot().liveBytes > 0);
+        }
+        auto tsnap = talloc.snapshot();
+        EXPECT(tsnap.allocationCount > 1);
+        EXPECT(tsnap.allocationCount == tsnap.deallocationCount);
+        EXPECT(tsnap.liveBytes == 0);
+        EXPECT(tsnap.peakBytes >= 400);
+        EXPECT(&talloc.parent() == &defaultAllocator());
+    },
+    SUITE("MmapAllocator Tests")
+    {
+        mem::MmapAllocator<Size(1) << 20> mmalloc;
+        Size ps = mmalloc.pageSize();
+        EXPECT(ps % mem::MmapAllocator<>::alignment == 0);
+        EXPECT(mmalloc.rangeCount() == 0);
+
+        auto a = mmalloc.allocate(100, 8);
+        EXPECT(a);
+        EXPECT(a.size == 100);
+        EXPECT(reinterpret_cast<UPtr>(a.ptr) % ps == 0);
+        EXPECT(mmalloc.owns(a));
+        EXPECT(mmalloc.rangeCount() == 1);
+        std::memset(a.ptr, 1, a.size);
+
+        auto b = mmalloc.allocate(ps * 2, 8);
+        EXPECT(b);
+        EXPECT(reinterpret_cast<UPtr>(b.ptr) >= reinterpret_cast<UPtr>(a.ptr) + ps);
+        std::memset(b.ptr, 1, b.size);
+
+        //freed spans are reused and come back zeroed (apart from the free list node)
+        mmalloc.deallocate(b);
+        EXPECT(mmalloc.freeSpanCount() == 1);
+        auto c = mmalloc.allocate(ps, 8);
+        EXPECT(c.ptr == b.ptr);
+        EXPECT(mmalloc.freeSpanCount() == 1);
+        EXPECT(reinterpret_cast<char *>(c.ptr)[ps - 1] == 0);
+        auto d = mmalloc.allocate(ps, 8);
+        EXPECT(reinterpret_cast<UPtr>(d.ptr) == reinterpret_cast<UPtr>(b.ptr) + ps);
+        EXPECT(mmalloc.freeSpanCount() == 0);
+
+        //allocations bigger than the reserve size get a range of their own
+        auto e = mmalloc.allocate(Size(1) << 21, ps * 4);
+        EXPECT(e);
+        EXPECT(reinterpret_cast<UPtr>(e.ptr) % (ps * 4) == 0);
+        EXPECT(mmalloc.owns(e));
+        EXPECT(mmalloc.rangeCount() == 2);
+        std::memset(e.ptr, 1, e.size);
+        EXPECT(!mmalloc.owns({ &ps, sizeof(ps) }));
+
+        mmalloc.deallocate(a);
+        mmalloc.deallocate(c);
+        mmalloc.deallocate(d);
+        mmalloc.deallocate(e);
+
+        {
+            //adjacent free spans are merged, so they can serve bigger allocations again
+            mem::MmapAllocator<Size(1) << 20> spanAlloc;
+            Size sps = spanAlloc.pageSize();
+            auto x = spanAlloc.allocate(sps, 8);
+            auto y = spanAlloc.allocate(sps, 8);
+            auto z = spanAlloc.allocate(sps, 8);
+            std::memset(x.ptr, 1, x.size);
+            std::memset(y.ptr, 1, y.size);
+            std::memset(z.ptr, 1, z.size);
+            spanAlloc.deallocate(x);
+            spanAlloc.deallocate(z);
+            EXPECT(spanAlloc.freeSpanCount() == 2);
+            spanAlloc.deallocate(y);
+            EXPECT(spanAlloc.freeSpanCount() == 1);
+
+            auto w = spanAlloc.allocateZeroed(sps * 3, 8);
+            EXPECT(w.ptr == x.ptr);
+            EXPECT(spanAlloc.freeSpanCount() == 0);
+            EXPECT(spanAlloc.rangeCount() == 1);
+            bool bAllZero = true;
+            for (Size i = 0; i < w.size; ++i)
+                bAllZero = bAllZero && reinterpret_cast<char *>(w.ptr)[i] == 0;
+            EXPECT(bAllZero);
+
+            //fresh pages are zero already and don't get touched
+            auto f = spanAlloc.allocateZeroed(sps, 8);
+            EXPECT(f);
+            unsigned char resident = 1;
+            EXPECT(mincore(f.ptr, sps, &resident) == 0);
+            EXPECT((resident & 1) == 0);
+            spanAlloc.deallocate(f);
+            spanAlloc.deallocate(w);
+        }
+
+        {
+            //as the root of a chunked allocator
+            mem::PoolAllocator<mem::MmapAllocator<Size(1) << 24, mem::MmapTransparentHugePages>, 0, 64, 1024> palloc;
+            mem::Block blocks[2048];
+            for (Size i = 0; i < 2048; ++i)
+            {
+                blocks[i] = palloc.allocate(64, 8);
+                EXPECT(blocks[i]);
+            }
+            EXPECT(palloc.chunkCount() == 2);
+            for (Size i = 0; i < 2048; ++i)
+                palloc.deallocate(blocks[i]);
+        }
+    },
+    SUITE("Allocator Expand Tests")
+    {
+        using LinearAlloc = mem::LinearAllocator<mem::Mallocator, 1024>;
+        EXPECT(mem::HasExpand<LinearAlloc>::value);
+        EXPECT(!mem::HasExpand<mem::Mallocator>::value);
+        EXPECT(mem::HasReallocate<mem::Mallocator>::value);
+        EXPECT(!mem::HasReallocate<LinearAlloc>::value);
+
+        {
+            LinearAlloc lalloc;
+            auto a = lalloc.allocate(16, 4);
+            auto b = lalloc.allocate(16, 4);
+            //only the last allocation can grow
+            EXPECT(!mem::expand(lalloc, a, 16));
+            EXPECT(mem::expand(lalloc, b, 16));
+            EXPECT(b.size == 32);
+            EXPECT(!mem::expand(lalloc, b, 2048));
+            auto c = lalloc.allocate(16, 1);
+            EXPECT(reinterpret_cast<UPtr>(c.ptr) == b.end());
+
+            //falls back to allocate, copy, deallocate
+            std::memset(a.ptr, 7, a.size);
+            void * old = a.ptr;
+            EXPECT(mem::reallocate(lalloc, a, 64, 4));
+            EXPECT(a.ptr != old);
+            EXPECT(a.size == 64);
+            EXPECT(reinterpret_cast<char *>(a.ptr)[15] == 7);
+        }
+
+        {
+            mem::FreeListAllocator<mem::Mallocator, 1024> falloc;
+            auto a = falloc.allocate(64, 8);
+            auto b = falloc.allocate(64, 8);
+            auto c = falloc.allocate(64, 8);
+            std::memset(a.ptr, 3, a.size);
+            Size freeCount = falloc.freeCount();
+
+            //c is followed by the rest of the chunk
+            EXPECT(mem::expand(falloc, c, 200));
+            EXPECT(c.size == 264);
+            EXPECT(falloc.freeCount() == freeCount);
+
+            //a is followed by b, which is not free
+            EXPECT(!mem::expand(falloc, a, 32));
+            falloc.deallocate(b);
+            EXPECT(mem::expand(falloc, a, 32));
+            EXPECT(a.size == 96);
+            //the rest of b is still free and can be absorbed, too
+            EXPECT(mem::expand(falloc, a, 48));
+            EXPECT(reinterpret_cast<char *>(a.ptr)[63] == 3);
+            EXPECT(!mem::expand(falloc, a, 1024));
+
+            falloc.deallocate(a);
+            falloc.deallocate(c);
+            EXPECT(falloc.freeCount() == 1);
+        }
+
+        {
+            mem::Mallocator mmalloc;
+            auto a = mmalloc.allocate(16, 8);
+            std::memset(a.ptr, 5, a.size);
+            EXPECT(mem::reallocate(mmalloc, a, 1 << 20, 8));
+            EXPECT(a.size == 1 << 20);
+            EXPECT(reinterpret_cast<char *>(a.ptr)[15] == 5);
+            EXPECT(mem::reallocate(mmalloc, a, 4096, 64));
+            EXPECT(reinterpret_cast<UPtr>(a.ptr) % 64 == 0);
+            EXPECT(reinterpret_cast<char *>(a.ptr)[15] == 5);
+            mmalloc.deallocate(a);
+        }
+
+        {
+            //containers grow in place if the allocator allows it
+            Arena arena;
+            DynamicArray<Int32> arr(arena);
+            arr.reserve(4);
+            const Int32 * ptr = arr.ptr();
+            for (Int32 i = 0; i < 100; ++i)
+                arr.append(i);
+            EXPECT(arr.ptr() == ptr);
+            EXPECT(arr[99] == 99);
+
+            DynamicArray<String> strs(arena);
+            strs.append("a");
+            strs.append("b");
+            strs.append("c");
+            EXPECT(strs[2] == "c");
+
+            String str("abcdefghijklmnopqrstuvwxyz", arena);
+            const char * cstr = str.cString();
+            str.reserve(1000);
+            EXPECT(str.cString() == cstr);
+            EXPECT(str == "abcdefghijklmnopqrstuvwxyz");
+            str.resize(100);
+            EXPECT(str.cString()[99] == 0);
+
+            String str2("abc");
+            str2.reserve(100000);
+            EXPECT(str2 == "abc");
+            str2.append("def");
+            EXPECT(str2 == "abcdef");
+            EXPECT(str2.cString()[99999] == 0);
+        }
+    },
+    SUITE("Allocate Zeroed Tests")
+    {
+        auto isZero = [](const mem::Block & _blk) {
+            for (Size i = 0; i < _blk.size; ++i)
+            {
+                if (reinterpret_cast<const char *>(_blk.ptr)[i] != 0)
+                    return false;
+            }
+            return true;
+        };
+
+        EXPECT(mem::HasAllocateZeroed<mem::Mallocator>::value);
+        using LinearAlloc = mem::LinearAllocator<mem::Mallocator, 64>;
+        EXPECT(!mem::HasAllocateZeroed<LinearAlloc>::value);
+
+        mem::Mallocator mmalloc;
+        auto a = mmalloc.allocateZeroed(1 << 16, 8);
+        EXPECT(a.size == 1 << 16);
+        EXPECT(isZero(a));
+        mmalloc.deallocate(a);
+        a = mmalloc.allocateZeroed(1000, 64);
+        EXPECT(reinterpret_cast<UPtr>(a.ptr) % 64 == 0);
+        EXPECT(isZero(a));
+        mmalloc.deallocate(a);
+
+        {
+            //reused pages of a free span are zero, too
+            mem::MmapAllocator<Size(1) << 20> pages;
+            auto b = pages.allocateZeroed(8192, 8);
+            EXPECT(isZero(b));
+            std::memset(b.ptr, 1, b.size);
+            pages.deallocate(b);
+            auto c = pages.allocateZeroed(8192, 8);
+            EXPECT(c.ptr == b.ptr);
+            EXPECT(isZero(c));
+            pages.deallocate(c);
+        }
+
+        {
+            //recycled memory gets cleared
+            mem::PoolAllocator<mem::Mallocator, 0, 64, 16> palloc;
+            auto d = palloc.allocate(64, 8);
+            std::memset(d.ptr, 1, d.size);
+            palloc.deallocate(d);
+            auto e = mem::allocateZeroed(palloc, 64, 8);
+            EXPECT(e.ptr == d.ptr);
+            EXPECT(isZero(e));
+            palloc.deallocate(e);
+        }
+
+        {
+            detail::ExperimentalSegregator seg;
+            auto f = seg.allocate(100, 8);
+            std::memset(f.ptr, 1, f.size);
+            seg.deallocate(f);
+            auto g = seg.allocateZeroed(100, 8);
+            EXPECT(isZero(g));
+            seg.deallocate(g);
+            auto h = seg.allocateZeroed(100000, 8);
+            EXPECT(isZero(h));
+            seg.deallocate(h);
+        }
+
+        auto i = defaultAllocator().allocateZeroed(4096, 8);
+        EXPECT(isZero(i));
+        defaultAllocator().deallocate(i);
+        auto j = experimentalAllocator().allocateZeroed(48, 8);
+        EXPECT(isZero(j));
+        experimentalAllocator().deallocate(j);
+
+        String str;
+        str.reserve(10000);
+        EXPECT(str.cString()[0] == 0);
+        EXPECT(str.cString()[10000] == 0);
+        str.resize(20);
+        EXPECT(str.length() == 20);
+        EXPECT(str.cString()[19] == 0);
+    },
     // SUITE("Allocator Performance")
     // {
     //     using MainAllocator = mem::GlobalAllocator <